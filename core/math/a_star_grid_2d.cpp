@@ -108,18 +108,25 @@ Size2 AStarGrid2D::get_cell_size() const {
 
 void AStarGrid2D::update() {
 	points.clear();
+	points.resize(region.size.x * region.size.y);
 
 	const int32_t end_x = region.get_end().x;
 	const int32_t end_y = region.get_end().y;
 
+	uint32_t index = 0;
 	for (int32_t y = region.position.y; y < end_y; y++) {
-		LocalVector<Point> line;
 		for (int32_t x = region.position.x; x < end_x; x++) {
-			line.push_back(Point(Vector2i(x, y), offset + Vector2(x, y) * cell_size));
+			points[index++] = Point(Vector2i(x, y));
 		}
-		points.push_back(line);
 	}
 
+	solid_mask.clear();
+	solid_mask.resize((points.size() + 63) / 64);
+	for (uint64_t &solid_bits : solid_mask) {
+		solid_bits = 0;
+	}
+
+	jump_distances_dirty = true;
 	dirty = false;
 }
 
@@ -137,6 +144,11 @@ bool AStarGrid2D::is_dirty() const {
 
 void AStarGrid2D::set_jumping_enabled(bool p_enabled) {
 	jumping_enabled = p_enabled;
+	if (!jumping_enabled) {
+		// The precomputed jumps take 4 distances per point, only keep them while jumping.
+		jump_distances.reset();
+		jump_distances_dirty = true;
+	}
 }
 
 bool AStarGrid2D::is_jumping_enabled() const {
@@ -145,7 +157,11 @@ bool AStarGrid2D::is_jumping_enabled() const {
 
 void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
 	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
-	diagonal_mode = p_diagonal_mode;
+	if (diagonal_mode != p_diagonal_mode) {
+		diagonal_mode = p_diagonal_mode;
+		// Which points are jump points depends on the diagonal mode.
+		jump_distances_dirty = true;
+	}
 }
 
 AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
@@ -173,13 +189,31 @@ AStarGrid2D::Heuristic AStarGrid2D::get_default_estimate_heuristic() const {
 void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is disabled. Point %s out of bounds %s.", p_id, region));
-	_get_point_unchecked(p_id)->solid = p_solid;
+	const uint32_t index = _get_point_index(p_id.x, p_id.y);
+	if (_is_solid_index(index) == p_solid) {
+		return;
+	}
+	_set_solid_index(index, p_solid);
+
+	// Only the jumps along the rows and columns next to the point can change, the next solve computes them again.
+	if (!jump_distances_dirty) {
+		const int32_t begin_y = MAX(p_id.y - 1, region.position.y);
+		const int32_t end_y = MIN(p_id.y + 2, region.get_end().y);
+		for (int32_t y = begin_y; y < end_y; y++) {
+			jump_dirty_rows.insert(y);
+		}
+		const int32_t begin_x = MAX(p_id.x - 1, region.position.x);
+		const int32_t end_x = MIN(p_id.x + 2, region.get_end().x);
+		for (int32_t x = begin_x; x < end_x; x++) {
+			jump_dirty_columns.insert(x);
+		}
+	}
 }
 
 bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, false, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), false, vformat("Can't get if point is disabled. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->solid;
+	return _is_solid_index(_get_point_index(p_id.x, p_id.y));
 }
 
 void AStarGrid2D::set_point_weight_scale(const Vector2i &p_id, real_t p_weight_scale) {
@@ -204,9 +238,10 @@ void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
 
 	for (int32_t y = safe_region.position.y; y < end_y; y++) {
 		for (int32_t x = safe_region.position.x; x < end_x; x++) {
-			_get_point_unchecked(x, y)->solid = p_solid;
+			_set_solid_index(_get_point_index(x, y), p_solid);
 		}
 	}
+	jump_distances_dirty = true;
 }
 
 void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weight_scale) {
@@ -224,92 +259,190 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 	}
 }
 
+bool AStarGrid2D::_is_straight_jump_point(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const {
+	// Whether a straight move in (p_dx, p_dy) has to stop at the point because of forced neighbors.
+	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
+		if (p_dx != 0) {
+			return (_is_walkable(p_x + p_dx, p_y + 1) && !_is_walkable(p_x, p_y + 1)) || (_is_walkable(p_x + p_dx, p_y - 1) && !_is_walkable(p_x, p_y - 1));
+		}
+		return (_is_walkable(p_x + 1, p_y + p_dy) && !_is_walkable(p_x + 1, p_y)) || (_is_walkable(p_x - 1, p_y + p_dy) && !_is_walkable(p_x - 1, p_y));
+	}
+	// DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES and DIAGONAL_MODE_NEVER
+	if (p_dx != 0) {
+		return (_is_walkable(p_x, p_y + 1) && !_is_walkable(p_x - p_dx, p_y + 1)) || (_is_walkable(p_x, p_y - 1) && !_is_walkable(p_x - p_dx, p_y - 1));
+	}
+	return (_is_walkable(p_x + 1, p_y) && !_is_walkable(p_x + 1, p_y - p_dy)) || (_is_walkable(p_x - 1, p_y) && !_is_walkable(p_x - 1, p_y - p_dy));
+}
+
+int16_t AStarGrid2D::_compute_jump_distance(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, const int16_t *p_distances) const {
+	const int32_t next_x = p_x + p_dx;
+	const int32_t next_y = p_y + p_dy;
+	if (!_is_walkable(next_x, next_y)) {
+		return 0;
+	}
+	if (_is_straight_jump_point(next_x, next_y, p_dx, p_dy)) {
+		return 1;
+	}
+	// Past the longest distance the jump continues from the point that far away, which is walkable and not a jump point.
+	const int32_t next_distance = p_distances[_get_point_index(next_x, next_y)];
+	if (next_distance > 0) {
+		return next_distance < JUMP_DISTANCE_MAX ? next_distance + 1 : -JUMP_DISTANCE_MAX;
+	}
+	return MAX(next_distance - 1, -JUMP_DISTANCE_MAX);
+}
+
+void AStarGrid2D::_update_jump_distances_row(int32_t p_y) {
+	int16_t *right = jump_distances.ptr() + JUMP_DIRECTION_RIGHT * points.size();
+	int16_t *left = jump_distances.ptr() + JUMP_DIRECTION_LEFT * points.size();
+	const int32_t begin_x = region.position.x;
+	const int32_t end_x = region.get_end().x;
+
+	// Scan against each direction so that every point extends the distance of the point after it.
+	for (int32_t x = end_x - 1; x >= begin_x; x--) {
+		right[_get_point_index(x, p_y)] = _compute_jump_distance(x, p_y, 1, 0, right);
+	}
+	for (int32_t x = begin_x; x < end_x; x++) {
+		left[_get_point_index(x, p_y)] = _compute_jump_distance(x, p_y, -1, 0, left);
+	}
+}
+
+void AStarGrid2D::_update_jump_distances_column(int32_t p_x) {
+	int16_t *down = jump_distances.ptr() + JUMP_DIRECTION_DOWN * points.size();
+	int16_t *up = jump_distances.ptr() + JUMP_DIRECTION_UP * points.size();
+	const int32_t begin_y = region.position.y;
+	const int32_t end_y = region.get_end().y;
+
+	for (int32_t y = end_y - 1; y >= begin_y; y--) {
+		down[_get_point_index(p_x, y)] = _compute_jump_distance(p_x, y, 0, 1, down);
+	}
+	for (int32_t y = begin_y; y < end_y; y++) {
+		up[_get_point_index(p_x, y)] = _compute_jump_distance(p_x, y, 0, -1, up);
+	}
+}
+
+void AStarGrid2D::_update_jump_distances() {
+	jump_distances.resize(JUMP_DIRECTION_MAX * points.size());
+
+	const int32_t end_x = region.get_end().x;
+	const int32_t end_y = region.get_end().y;
+	for (int32_t y = region.position.y; y < end_y; y++) {
+		_update_jump_distances_row(y);
+	}
+	for (int32_t x = region.position.x; x < end_x; x++) {
+		_update_jump_distances_column(x);
+	}
+
+	jump_distances_dirty = false;
+	jump_dirty_rows.clear();
+	jump_dirty_columns.clear();
+}
+
+void AStarGrid2D::_update_dirty_jump_distances() {
+	for (int32_t y : jump_dirty_rows) {
+		_update_jump_distances_row(y);
+	}
+	for (int32_t x : jump_dirty_columns) {
+		_update_jump_distances_column(x);
+	}
+
+	jump_dirty_rows.clear();
+	jump_dirty_columns.clear();
+}
+
+AStarGrid2D::Point *AStarGrid2D::_jump_straight(const Vector2i &p_from, int32_t p_dx, int32_t p_dy) {
+	JumpDirection direction;
+	if (p_dx != 0) {
+		direction = p_dx > 0 ? JUMP_DIRECTION_RIGHT : JUMP_DIRECTION_LEFT;
+	} else {
+		direction = p_dy > 0 ? JUMP_DIRECTION_DOWN : JUMP_DIRECTION_UP;
+	}
+	const int16_t *distances = jump_distances.ptr() + direction * points.size();
+
+	// The end point stops the jump wherever it lies on the way.
+	int32_t end_steps = 0;
+	if (p_dy == 0 && end->id.y == p_from.y) {
+		end_steps = (end->id.x - p_from.x) * p_dx;
+	} else if (p_dx == 0 && end->id.x == p_from.x) {
+		end_steps = (end->id.y - p_from.y) * p_dy;
+	}
+
+	int32_t steps = 0;
+	while (true) {
+		const int32_t distance = distances[_get_point_index(p_from.x + p_dx * steps, p_from.y + p_dy * steps)];
+		const int32_t walkable_count = steps + ABS(distance);
+		if (end_steps > steps && end_steps <= walkable_count) {
+			return end;
+		}
+
+		if (distance > 0) {
+			return _get_point_unchecked(p_from.x + p_dx * walkable_count, p_from.y + p_dy * walkable_count);
+		}
+		if (distance != -JUMP_DISTANCE_MAX) {
+			return nullptr;
+		}
+		steps = walkable_count;
+	}
+}
+
 AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
-	if (!p_to || p_to->solid) {
+	if (!p_to || _is_point_solid(p_to)) {
 		return nullptr;
 	}
-	if (p_to == end) {
-		return p_to;
-	}
 
-	int32_t from_x = p_from->id.x;
-	int32_t from_y = p_from->id.y;
+	const int32_t dx = p_to->id.x - p_from->id.x;
+	const int32_t dy = p_to->id.y - p_from->id.y;
+
+	// Straight moves only stop at precomputed jump points, except vertical moves when diagonals are
+	// disabled, which look for horizontal jumps at every point like diagonal moves do.
+	if (dy == 0 || (dx == 0 && diagonal_mode != DIAGONAL_MODE_NEVER)) {
+		return _jump_straight(p_from->id, dx, dy);
+	}
 
 	int32_t to_x = p_to->id.x;
 	int32_t to_y = p_to->id.y;
 
-	int32_t dx = to_x - from_x;
-	int32_t dy = to_y - from_y;
+	while (true) {
+		if (to_x == end->id.x && to_y == end->id.y) {
+			return end;
+		}
 
-	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
-		if (dx != 0 && dy != 0) {
+		if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
 			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
-				return p_to;
+				return _get_point_unchecked(to_x, to_y);
 			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
-				return p_to;
+			if (_jump_straight(Vector2i(to_x, to_y), dx, 0) != nullptr || _jump_straight(Vector2i(to_x, to_y), 0, dy) != nullptr) {
+				return _get_point_unchecked(to_x, to_y);
 			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
+			if (!_is_walkable(to_x + dx, to_y + dy) || (diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE && !_is_walkable(to_x + dx, to_y) && !_is_walkable(to_x, to_y + dy))) {
+				return nullptr;
 			}
-		} else {
-			if (dx != 0) {
-				if ((_is_walkable(to_x + dx, to_y + 1) && !_is_walkable(to_x, to_y + 1)) || (_is_walkable(to_x + dx, to_y - 1) && !_is_walkable(to_x, to_y - 1))) {
-					return p_to;
-				}
-			} else {
-				if ((_is_walkable(to_x + 1, to_y + dy) && !_is_walkable(to_x + 1, to_y)) || (_is_walkable(to_x - 1, to_y + dy) && !_is_walkable(to_x - 1, to_y))) {
-					return p_to;
-				}
-			}
-		}
-		if (_is_walkable(to_x + dx, to_y + dy) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || (_is_walkable(to_x + dx, to_y) || _is_walkable(to_x, to_y + dy)))) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
-		}
-	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
-		if (dx != 0 && dy != 0) {
+			to_x += dx;
+			to_y += dy;
+		} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
 			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
-				return p_to;
+				return _get_point_unchecked(to_x, to_y);
 			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
-				return p_to;
+			if (_jump_straight(Vector2i(to_x, to_y), dx, 0) != nullptr || _jump_straight(Vector2i(to_x, to_y), 0, dy) != nullptr) {
+				return _get_point_unchecked(to_x, to_y);
 			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
+			if (!_is_walkable(to_x + dx, to_y + dy) || !_is_walkable(to_x + dx, to_y) || !_is_walkable(to_x, to_y + dy)) {
+				return nullptr;
 			}
-		} else {
-			if (dx != 0) {
-				if ((_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1)) || (_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1))) {
-					return p_to;
-				}
-			} else {
-				if ((_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy)) || (_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy))) {
-					return p_to;
-				}
-			}
-		}
-		if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
-		}
-	} else { // DIAGONAL_MODE_NEVER
-		if (dx != 0) {
-			if ((_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1)) || (_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1))) {
-				return p_to;
-			}
-		} else if (dy != 0) {
+			to_x += dx;
+			to_y += dy;
+		} else { // DIAGONAL_MODE_NEVER, moving vertically.
 			if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
-				return p_to;
+				return _get_point_unchecked(to_x, to_y);
 			}
-			if (_jump(p_to, _get_point(to_x + 1, to_y)) != nullptr) {
-				return p_to;
+			if (_jump_straight(Vector2i(to_x, to_y), 1, 0) != nullptr || _jump_straight(Vector2i(to_x, to_y), -1, 0) != nullptr) {
+				return _get_point_unchecked(to_x, to_y);
 			}
-			if (_jump(p_to, _get_point(to_x - 1, to_y)) != nullptr) {
-				return p_to;
+			if (!_is_walkable(to_x, to_y + dy)) {
+				return nullptr;
 			}
+			to_y += dy;
 		}
-		return _jump(p_to, _get_point(to_x + dx, to_y + dy));
 	}
-	return nullptr;
 }
 
 void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
@@ -360,19 +493,19 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 		}
 	}
 
-	if (top && !top->solid) {
+	if (top && !_is_point_solid(top)) {
 		r_nbors.push_back(top);
 		ts0 = true;
 	}
-	if (right && !right->solid) {
+	if (right && !_is_point_solid(right)) {
 		r_nbors.push_back(right);
 		ts1 = true;
 	}
-	if (bottom && !bottom->solid) {
+	if (bottom && !_is_point_solid(bottom)) {
 		r_nbors.push_back(bottom);
 		ts2 = true;
 	}
-	if (left && !left->solid) {
+	if (left && !_is_point_solid(left)) {
 		r_nbors.push_back(left);
 		ts3 = true;
 	}
@@ -402,35 +535,99 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 			break;
 	}
 
-	if (td0 && (top_left && !top_left->solid)) {
+	if (td0 && (top_left && !_is_point_solid(top_left))) {
 		r_nbors.push_back(top_left);
 	}
-	if (td1 && (top_right && !top_right->solid)) {
+	if (td1 && (top_right && !_is_point_solid(top_right))) {
 		r_nbors.push_back(top_right);
 	}
-	if (td2 && (bottom_right && !bottom_right->solid)) {
+	if (td2 && (bottom_right && !_is_point_solid(bottom_right))) {
 		r_nbors.push_back(bottom_right);
 	}
-	if (td3 && (bottom_left && !bottom_left->solid)) {
+	if (td3 && (bottom_left && !_is_point_solid(bottom_left))) {
 		r_nbors.push_back(bottom_left);
 	}
 }
 
+void AStarGrid2D::_open_list_sift_up(uint32_t p_index) {
+	SortPoints is_worse;
+	Point *point = open_list[p_index];
+	while (p_index > 0) {
+		const uint32_t parent = (p_index - 1) / 2;
+		if (!is_worse(open_list[parent], point)) {
+			break;
+		}
+		open_list[p_index] = open_list[parent];
+		open_list[p_index]->open_index = p_index;
+		p_index = parent;
+	}
+	open_list[p_index] = point;
+	point->open_index = p_index;
+}
+
+AStarGrid2D::Point *AStarGrid2D::_open_list_pop() {
+	SortPoints is_worse;
+	Point *top = open_list[0];
+	Point *last = open_list[open_list.size() - 1];
+	open_list.resize(open_list.size() - 1);
+
+	const uint32_t size = open_list.size();
+	if (size > 0) {
+		uint32_t index = 0;
+		while (true) {
+			uint32_t child = index * 2 + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && is_worse(open_list[child], open_list[child + 1])) {
+				child++;
+			}
+			if (!is_worse(last, open_list[child])) {
+				break;
+			}
+			open_list[index] = open_list[child];
+			open_list[index]->open_index = index;
+			index = child;
+		}
+		open_list[index] = last;
+		last->open_index = index;
+	}
+	return top;
+}
+
 bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
-	pass++;
+	// Every search uses two passes, one for open and one for closed points.
+	if (pass >= UINT32_MAX - 2) {
+		for (Point &point : points) {
+			point.search_pass = 0;
+		}
+		pass = 0;
+	}
+	pass += 2;
+	const uint32_t closed_pass = pass + 1;
 
-	if (p_end_point->solid) {
+	if (_is_point_solid(p_end_point)) {
 		return false;
 	}
 
+	if (jumping_enabled) {
+		if (jump_distances_dirty) {
+			_update_jump_distances();
+		} else if (!jump_dirty_rows.is_empty() || !jump_dirty_columns.is_empty()) {
+			_update_dirty_jump_distances();
+		}
+	}
+
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	// The open list is a binary heap whose points know their position in it, so improving a point does not need a search.
+	open_list.clear();
 
 	p_begin_point->g_score = 0;
 	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	p_begin_point->search_pass = pass;
 	open_list.push_back(p_begin_point);
+	_open_list_sift_up(0);
 	end = p_end_point;
 
 	while (!open_list.is_empty()) {
@@ -441,11 +638,10 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		_open_list_pop(); // Remove the current point from the open list.
+		p->search_pass = closed_pass; // Mark the point as closed.
 
-		LocalVector<Point *> nbors;
+		nbors.clear();
 		_get_nbors(p, nbors);
 
 		for (Point *e : nbors) {
@@ -454,11 +650,11 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 			if (jumping_enabled) {
 				// TODO: Make it works with weight_scale.
 				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+				if (!e || e->search_pass == closed_pass) {
 					continue;
 				}
 			} else {
-				if (e->solid || e->closed_pass == pass) {
+				if (_is_point_solid(e) || e->search_pass == closed_pass) {
 					continue;
 				}
 				weight_scale = e->weight_scale;
@@ -467,22 +663,22 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
+			if (e->search_pass != pass) { // The point wasn't inside the open list.
+				e->search_pass = pass;
 				new_point = true;
 			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
+			e->prev_index = p - points.ptr();
 			e->g_score = tentative_g_score;
 			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
 
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+			if (new_point) {
+				open_list.push_back(e);
+				_open_list_sift_up(open_list.size() - 1);
+			} else { // The point only got better, it can only move up.
+				_open_list_sift_up(e->open_index);
 			}
 		}
 	}
@@ -508,13 +704,18 @@ real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_t
 
 void AStarGrid2D::clear() {
 	points.clear();
+	solid_mask.clear();
+	jump_distances.clear();
+	jump_distances_dirty = true;
+	jump_dirty_rows.clear();
+	jump_dirty_columns.clear();
 	region = Rect2i();
 }
 
 Vector2 AStarGrid2D::get_point_position(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, Vector2(), "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), Vector2(), vformat("Can't get point's position. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->pos;
+	return _get_point_position(p_id);
 }
 
 Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
@@ -527,7 +728,7 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 
 	if (a == b) {
 		Vector<Vector2> ret;
-		ret.push_back(a->pos);
+		ret.push_back(_get_point_position(a->id));
 		return ret;
 	}
 
@@ -543,7 +744,7 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	int32_t pc = 1;
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = &points[p->prev_index];
 	}
 
 	Vector<Vector2> path;
@@ -555,11 +756,11 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 		p = end_point;
 		int32_t idx = pc - 1;
 		while (p != begin_point) {
-			w[idx--] = p->pos;
-			p = p->prev_point;
+			w[idx--] = _get_point_position(p->id);
+			p = &points[p->prev_index];
 		}
 
-		w[0] = p->pos;
+		w[0] = _get_point_position(p->id);
 	}
 
 	return path;
@@ -591,7 +792,7 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 	int32_t pc = 1;
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = &points[p->prev_index];
 	}
 
 	TypedArray<Vector2i> path;
@@ -602,7 +803,7 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 		int32_t idx = pc - 1;
 		while (p != begin_point) {
 			path[idx--] = p->id;
-			p = p->prev_point;
+			p = &points[p->prev_index];
 		}
 
 		path[0] = p->id;
@@ -33,6 +33,7 @@
 
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_set.h"
 #include "core/templates/list.h"
 #include "core/templates/local_vector.h"
 
@@ -70,21 +71,27 @@ private:
 	struct Point {
 		Vector2i id;
 
-		bool solid = false;
-		Vector2 pos;
 		real_t weight_scale = 1.0;
 
 		// Used for pathfinding.
-		Point *prev_point = nullptr;
 		real_t g_score = 0;
 		real_t f_score = 0;
-		uint64_t open_pass = 0;
-		uint64_t closed_pass = 0;
+		uint32_t prev_index = 0; // Index of the previous point on the path.
+		uint32_t open_index = 0; // Position in the open list, valid while the point is open.
+		uint32_t search_pass = 0; // `pass` while the point is open, `pass + 1` once it is closed, older when not reached by the current search.
 
 		Point() {}
 
-		Point(const Vector2i &p_id, const Vector2 &p_pos) :
-				id(p_id), pos(p_pos) {}
+		Point(const Vector2i &p_id) :
+				id(p_id) {}
+	};
+
+	enum JumpDirection {
+		JUMP_DIRECTION_RIGHT,
+		JUMP_DIRECTION_LEFT,
+		JUMP_DIRECTION_DOWN,
+		JUMP_DIRECTION_UP,
+		JUMP_DIRECTION_MAX,
 	};
 
 	struct SortPoints {
@@ -99,38 +106,94 @@ private:
 		}
 	};
 
-	LocalVector<LocalVector<Point>> points;
+	// All points of the region, row by row.
+	LocalVector<Point> points;
+	// One bit per point, set when the point is solid. Kept apart from the points so that jumping touches little memory.
+	LocalVector<uint64_t> solid_mask;
+
+	enum {
+		JUMP_DISTANCE_MAX = INT16_MAX,
+	};
+
+	// Straight jumps precomputed for jumping (JPS+), for each `JumpDirection` and point: `n > 0` when the
+	// next jump point is `n` points away, `-n` when `n` walkable points follow before a solid one or the region end.
+	// Longer runs are split, `-JUMP_DISTANCE_MAX` continues with the distance of the point that far away.
+	LocalVector<int16_t> jump_distances;
+	bool jump_distances_dirty = true;
+	// Rows and columns whose jumps changed since they were computed, they are computed again by the next solve.
+	HashSet<int32_t> jump_dirty_rows;
+	HashSet<int32_t> jump_dirty_columns;
+
 	Point *end = nullptr;
 
-	uint64_t pass = 1;
+	uint32_t pass = 0;
+
+	// Search scratch, kept between solves to not allocate for every path.
+	LocalVector<Point *> open_list;
+	LocalVector<Point *> nbors;
 
 private: // Internal routines.
+	_FORCE_INLINE_ uint32_t _get_point_index(int32_t p_x, int32_t p_y) const {
+		return uint32_t(p_y - region.position.y) * uint32_t(region.size.x) + uint32_t(p_x - region.position.x);
+	}
+
+	_FORCE_INLINE_ bool _is_solid_index(uint32_t p_index) const {
+		return (solid_mask[p_index >> 6] >> (p_index & 63)) & 1;
+	}
+
+	_FORCE_INLINE_ void _set_solid_index(uint32_t p_index, bool p_solid) {
+		if (p_solid) {
+			solid_mask[p_index >> 6] |= uint64_t(1) << (p_index & 63);
+		} else {
+			solid_mask[p_index >> 6] &= ~(uint64_t(1) << (p_index & 63));
+		}
+	}
+
+	_FORCE_INLINE_ bool _is_point_solid(const Point *p_point) const {
+		return _is_solid_index(p_point - points.ptr());
+	}
+
 	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
 		if (region.has_point(Vector2i(p_x, p_y))) {
-			return !points[p_y - region.position.y][p_x - region.position.x].solid;
+			return !_is_solid_index(_get_point_index(p_x, p_y));
 		}
 		return false;
 	}
 
 	_FORCE_INLINE_ Point *_get_point(int32_t p_x, int32_t p_y) {
 		if (region.has_point(Vector2i(p_x, p_y))) {
-			return &points[p_y - region.position.y][p_x - region.position.x];
+			return &points[_get_point_index(p_x, p_y)];
 		}
 		return nullptr;
 	}
 
 	_FORCE_INLINE_ Point *_get_point_unchecked(int32_t p_x, int32_t p_y) {
-		return &points[p_y - region.position.y][p_x - region.position.x];
+		return &points[_get_point_index(p_x, p_y)];
 	}
 
 	_FORCE_INLINE_ Point *_get_point_unchecked(const Vector2i &p_id) {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
+		return &points[_get_point_index(p_id.x, p_id.y)];
 	}
 
 	_FORCE_INLINE_ const Point *_get_point_unchecked(const Vector2i &p_id) const {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
+		return &points[_get_point_index(p_id.x, p_id.y)];
+	}
+
+	_FORCE_INLINE_ Vector2 _get_point_position(const Vector2i &p_id) const {
+		return offset + Vector2(p_id.x, p_id.y) * cell_size;
 	}
 
+	bool _is_straight_jump_point(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const;
+	int16_t _compute_jump_distance(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, const int16_t *p_distances) const;
+	void _update_jump_distances_row(int32_t p_y);
+	void _update_jump_distances_column(int32_t p_x);
+	void _update_jump_distances();
+	void _update_dirty_jump_distances();
+	Point *_jump_straight(const Vector2i &p_from, int32_t p_dx, int32_t p_dy);
+
+	void _open_list_sift_up(uint32_t p_index);
+	Point *_open_list_pop();
+
 	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
 	Point *_jump(Point *p_from, Point *p_to);
 	bool _solve(Point *p_begin_point, Point *p_end_point);
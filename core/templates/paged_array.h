@@ -347,6 +347,11 @@ public:
 		}
 	}
 
+	// Elements are only contiguous in memory within the same page.
+	_FORCE_INLINE_ uint32_t get_page_size() const {
+		return page_size_mask + 1;
+	}
+
 	_FORCE_INLINE_ uint64_t size() const {
 		return count;
 	}
@@ -100,6 +100,8 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		NAVIGATION_PATH_QUERY_QUEUE_COUNT,
+		NAVIGATION_PATH_QUERY_LATENCY,
 		MONITOR_MAX
 	};
 
@@ -34,6 +34,7 @@
 #include "nav_mesh_generator_3d.h"
 #endif // _3D_DISABLED
 
+#include "core/config/project_settings.h"
 #include "core/os/mutex.h"
 
 using namespace NavigationUtilities;
@@ -81,7 +82,9 @@ using namespace NavigationUtilities;
 	}                                                               \
 	void GodotNavigationServer::MERGE(_cmd_, F_NAME)(T_0 D_0, T_1 D_1)
 
-GodotNavigationServer::GodotNavigationServer() {}
+GodotNavigationServer::GodotNavigationServer() {
+	async_path_queries_per_frame = GLOBAL_GET("navigation/pathfinding/max_async_path_queries_per_frame");
+}
 
 GodotNavigationServer::~GodotNavigationServer() {
 	flush_queries();
@@ -299,6 +302,21 @@ TypedArray<RID> GodotNavigationServer::map_get_agents(RID p_map) const {
 	return agents_rids;
 }
 
+PackedVector3Array GodotNavigationServer::map_get_agents_safe_velocities(RID p_map) const {
+	PackedVector3Array safe_velocities;
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, safe_velocities);
+
+	const LocalVector<NavAgent *> &agents = map->get_agents();
+	safe_velocities.resize(agents.size());
+
+	Vector3 *safe_velocities_ptrw = safe_velocities.ptrw();
+	for (uint32_t i = 0; i < agents.size(); i++) {
+		safe_velocities_ptrw[i] = agents[i]->get_safe_velocity();
+	}
+	return safe_velocities;
+}
+
 TypedArray<RID> GodotNavigationServer::map_get_obstacles(RID p_map) const {
 	TypedArray<RID> obstacles_rids;
 	const NavMap *map = map_owner.get_or_null(p_map);
@@ -1084,6 +1102,75 @@ uint32_t GodotNavigationServer::obstacle_get_avoidance_layers(RID p_obstacle) co
 	return obstacle->get_avoidance_layers();
 }
 
+RID GodotNavigationServer::flow_field_create() {
+	MutexLock lock(operations_mutex);
+
+	RID rid = flow_field_owner.make_rid();
+	NavFlowField *flow_field = flow_field_owner.get_or_null(rid);
+	flow_field->set_self(rid);
+	return rid;
+}
+
+COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	NavMap *map = map_owner.get_or_null(p_map);
+
+	flow_field->set_map(map);
+}
+
+RID GodotNavigationServer::flow_field_get_map(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, RID());
+	if (flow_field->get_map()) {
+		return flow_field->get_map()->get_self();
+	}
+	return RID();
+}
+
+COMMAND_2(flow_field_set_targets, RID, p_flow_field, Vector<Vector3>, p_targets) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	flow_field->set_targets(p_targets);
+}
+
+Vector<Vector3> GodotNavigationServer::flow_field_get_targets(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, Vector<Vector3>());
+
+	return flow_field->get_targets();
+}
+
+COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	flow_field->set_navigation_layers(p_navigation_layers);
+}
+
+uint32_t GodotNavigationServer::flow_field_get_navigation_layers(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, 0);
+
+	return flow_field->get_navigation_layers();
+}
+
+Vector3 GodotNavigationServer::flow_field_get_next_position(RID p_flow_field, const Vector3 &p_position) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, p_position);
+
+	return flow_field->get_next_position(p_position);
+}
+
+real_t GodotNavigationServer::flow_field_get_distance(RID p_flow_field, const Vector3 &p_position) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, INFINITY);
+
+	return flow_field->get_distance(p_position);
+}
+
 void GodotNavigationServer::parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback) {
 #ifndef _3D_DISABLED
 	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "The SceneTree can only be parsed on the main thread. Call this function from the main thread or use call_deferred().");
@@ -1116,6 +1203,26 @@ void GodotNavigationServer::bake_from_source_geometry_data_async(const Ref<Navig
 #endif // _3D_DISABLED
 }
 
+void GodotNavigationServer::bake_tile_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Vector2i &p_tile, const Callable &p_callback) {
+#ifndef _3D_DISABLED
+	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation mesh.");
+	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
+
+	ERR_FAIL_NULL(NavMeshGenerator3D::get_singleton());
+	NavMeshGenerator3D::get_singleton()->bake_tile_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_tile, p_callback);
+#endif // _3D_DISABLED
+}
+
+void GodotNavigationServer::bake_tile_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Vector2i &p_tile, const Callable &p_callback) {
+#ifndef _3D_DISABLED
+	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation mesh.");
+	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
+
+	ERR_FAIL_NULL(NavMeshGenerator3D::get_singleton());
+	NavMeshGenerator3D::get_singleton()->bake_tile_from_source_geometry_data_async(p_navigation_mesh, p_source_geometry_data, p_tile, p_callback);
+#endif // _3D_DISABLED
+}
+
 COMMAND_1(free, RID, p_object) {
 	if (map_owner.owns(p_object)) {
 		NavMap *map = map_owner.get_or_null(p_object);
@@ -1144,6 +1251,11 @@ COMMAND_1(free, RID, p_object) {
 			obstacle->set_map(nullptr);
 		}
 
+		// Remove any assigned flow fields, unassigning them removes them from the map
+		while (!map->get_flow_fields().is_empty()) {
+			map->get_flow_fields()[0]->set_map(nullptr);
+		}
+
 		int map_index = active_maps.find(map);
 		if (map_index >= 0) {
 			active_maps.remove_at(map_index);
@@ -1179,6 +1291,17 @@ COMMAND_1(free, RID, p_object) {
 	} else if (obstacle_owner.owns(p_object)) {
 		internal_free_obstacle(p_object);
 
+	} else if (flow_field_owner.owns(p_object)) {
+		NavFlowField *flow_field = flow_field_owner.get_or_null(p_object);
+
+		// Removes this flow field from the map if assigned
+		if (flow_field->get_map() != nullptr) {
+			flow_field->get_map()->remove_flow_field(flow_field);
+			flow_field->set_map(nullptr);
+		}
+
+		flow_field_owner.free(p_object);
+
 	} else {
 		ERR_PRINT("Attempted to free a NavigationServer RID that did not exist (or was already freed).");
 	}
@@ -1219,6 +1342,9 @@ void GodotNavigationServer::set_active(bool p_active) {
 }
 
 void GodotNavigationServer::flush_queries() {
+	// Commands modify the maps, which running async path queries read.
+	_wait_for_async_path_queries();
+
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
 	MutexLock lock(commands_mutex);
@@ -1250,6 +1376,7 @@ void GodotNavigationServer::sync() {
 
 void GodotNavigationServer::process(real_t p_delta_time) {
 	flush_queries();
+	_finish_async_path_queries();
 
 	if (!active) {
 		return;
@@ -1297,6 +1424,9 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 	pm_edge_merge_count = _new_pm_edge_merge_count;
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
+
+	// The maps are synced and stay unchanged until the next flush, run the queued path queries against them meanwhile.
+	_dispatch_async_path_queries();
 }
 
 void GodotNavigationServer::init() {
@@ -1317,10 +1447,15 @@ void GodotNavigationServer::finish() {
 }
 
 PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_path_on_map(map, p_parameters);
+}
+
+PathQueryResult GodotNavigationServer::_query_path_on_map(const NavMap *p_map, const PathQueryParameters &p_parameters) const {
+	PathQueryResult r_query_result;
+	const NavMap *map = p_map;
 
 	// run the pathfinding
 
@@ -1356,6 +1491,117 @@ PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_
 	return r_query_result;
 }
 
+int64_t GodotNavigationServer::query_path_async(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, const Ref<NavigationPathQueryResult3D> &p_query_result, const Callable &p_callback, int p_priority) {
+	ERR_FAIL_COND_V(!p_query_parameters.is_valid(), 0);
+	ERR_FAIL_COND_V(!p_query_result.is_valid(), 0);
+
+	AsyncPathQuery query;
+	query.priority = p_priority;
+	query.submit_usec = OS::get_singleton()->get_ticks_usec();
+	query.parameters = p_query_parameters->get_parameters();
+	query.query_result = p_query_result;
+	query.callback = p_callback;
+
+	MutexLock lock(async_path_queries_mutex);
+	query.ticket = ++async_path_queries_last_ticket;
+	async_path_queries_pending.push_back(query);
+	async_path_queries_in_flight.insert(query.ticket);
+	return query.ticket;
+}
+
+bool GodotNavigationServer::query_path_async_is_completed(int64_t p_ticket) const {
+	MutexLock lock(async_path_queries_mutex);
+	ERR_FAIL_COND_V_MSG(p_ticket <= 0 || p_ticket > async_path_queries_last_ticket, false, "Invalid path query ticket.");
+	return !async_path_queries_in_flight.has(p_ticket);
+}
+
+void GodotNavigationServer::_async_path_query_task(uint32_t p_index, AsyncPathQuery *p_queries) {
+	AsyncPathQuery &query = p_queries[p_index];
+	if (query.map) {
+		query.result = _query_path_on_map(query.map, query.parameters);
+	}
+}
+
+void GodotNavigationServer::_dispatch_async_path_queries() {
+	MutexLock lock(async_path_queries_mutex);
+	ERR_FAIL_COND(async_path_queries_group_task != -1);
+
+	if (async_path_queries_pending.is_empty()) {
+		pm_path_query_queue_count = 0;
+		return;
+	}
+
+	async_path_queries_pending.sort_custom<AsyncPathQueryPriorityComparator>();
+
+	uint32_t count = async_path_queries_pending.size();
+	if (async_path_queries_per_frame > 0) {
+		count = MIN(count, (uint32_t)async_path_queries_per_frame);
+	}
+
+	async_path_queries_running.clear();
+	for (uint32_t i = 0; i < count; i++) {
+		AsyncPathQuery &query = async_path_queries_pending[i];
+		// Resolve the map here, RID owners can't be used from the worker threads.
+		query.map = map_owner.get_or_null(query.parameters.map);
+		async_path_queries_running.push_back(query);
+	}
+	// Keep the remaining queries in order for the next frames.
+	for (uint32_t i = count; i < async_path_queries_pending.size(); i++) {
+		async_path_queries_pending[i - count] = async_path_queries_pending[i];
+	}
+	async_path_queries_pending.resize(async_path_queries_pending.size() - count);
+	pm_path_query_queue_count = async_path_queries_pending.size();
+
+	async_path_queries_group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer::_async_path_query_task, async_path_queries_running.ptr(), async_path_queries_running.size(), -1, true, SNAME("NavigationServerPathQueries"));
+}
+
+void GodotNavigationServer::_wait_for_async_path_queries() {
+	MutexLock lock(async_path_queries_mutex);
+	if (async_path_queries_group_task == -1) {
+		return;
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(async_path_queries_group_task);
+	async_path_queries_group_task = -1;
+}
+
+void GodotNavigationServer::_finish_async_path_queries() {
+	LocalVector<AsyncPathQuery> finished;
+	{
+		MutexLock lock(async_path_queries_mutex);
+		ERR_FAIL_COND(async_path_queries_group_task != -1);
+		if (async_path_queries_running.is_empty()) {
+			return;
+		}
+		finished = async_path_queries_running;
+		async_path_queries_running.clear();
+		for (const AsyncPathQuery &query : finished) {
+			async_path_queries_in_flight.erase(query.ticket);
+		}
+	}
+
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	uint64_t total_latency = 0;
+
+	// Results and callbacks are delivered from here, on the thread running the server process.
+	for (const AsyncPathQuery &query : finished) {
+		if (query.map == nullptr) {
+			ERR_PRINT("Async path query " + itos(query.ticket) + " failed because its map does not exist.");
+		}
+		query.query_result->set_path(query.result.path);
+		query.query_result->set_path_types(query.result.path_types);
+		query.query_result->set_path_rids(query.result.path_rids);
+		query.query_result->set_path_owner_ids(query.result.path_owner_ids);
+
+		total_latency += now - query.submit_usec;
+
+		if (query.callback.is_valid()) {
+			query.callback.call(query.query_result);
+		}
+	}
+
+	pm_path_query_latency_usec = total_latency / finished.size();
+}
+
 int GodotNavigationServer::get_process_info(ProcessInfo p_info) const {
 	switch (p_info) {
 		case INFO_ACTIVE_MAPS: {
@@ -1385,6 +1631,12 @@ int GodotNavigationServer::get_process_info(ProcessInfo p_info) const {
 		case INFO_EDGE_FREE_COUNT: {
 			return pm_edge_free_count;
 		} break;
+		case INFO_PATH_QUERY_QUEUE_COUNT: {
+			return pm_path_query_queue_count;
+		} break;
+		case INFO_PATH_QUERY_LATENCY: {
+			return pm_path_query_latency_usec;
+		} break;
 	}
 
 	return 0;
@@ -34,9 +34,12 @@
 #include "nav_agent.h"
 #include "nav_link.h"
 #include "nav_map.h"
+#include "nav_flow_field.h"
 #include "nav_obstacle.h"
 #include "nav_region.h"
 
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_set.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -77,6 +80,7 @@ class GodotNavigationServer : public NavigationServer3D {
 	mutable RID_Owner<NavRegion> region_owner;
 	mutable RID_Owner<NavAgent> agent_owner;
 	mutable RID_Owner<NavObstacle> obstacle_owner;
+	mutable RID_Owner<NavFlowField> flow_field_owner;
 
 	bool active = true;
 	LocalVector<NavMap *> active_maps;
@@ -95,6 +99,47 @@ class GodotNavigationServer : public NavigationServer3D {
 	int pm_edge_merge_count = 0;
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
+	int pm_path_query_queue_count = 0;
+	int pm_path_query_latency_usec = 0;
+
+	/// Path queries requested with `query_path_async()`. They are dispatched to the
+	/// WorkerThreadPool at the end of `process()`, after the maps were synced, and
+	/// waited for before the next commands or map sync modify the maps.
+	struct AsyncPathQuery {
+		int64_t ticket = 0;
+		int priority = 0;
+		uint64_t submit_usec = 0;
+		const NavMap *map = nullptr;
+		NavigationUtilities::PathQueryParameters parameters;
+		NavigationUtilities::PathQueryResult result;
+		Ref<NavigationPathQueryResult3D> query_result;
+		Callable callback;
+	};
+
+	struct AsyncPathQueryPriorityComparator {
+		_FORCE_INLINE_ bool operator()(const AsyncPathQuery &p_a, const AsyncPathQuery &p_b) const {
+			// Higher priority first, then in the order they were requested.
+			if (p_a.priority != p_b.priority) {
+				return p_a.priority > p_b.priority;
+			}
+			return p_a.ticket < p_b.ticket;
+		}
+	};
+
+	mutable Mutex async_path_queries_mutex;
+	LocalVector<AsyncPathQuery> async_path_queries_pending;
+	LocalVector<AsyncPathQuery> async_path_queries_running;
+	HashSet<int64_t> async_path_queries_in_flight;
+	int64_t async_path_queries_last_ticket = 0;
+	WorkerThreadPool::GroupID async_path_queries_group_task = -1;
+	int async_path_queries_per_frame = 0;
+
+	void _async_path_query_task(uint32_t p_index, AsyncPathQuery *p_queries);
+	void _dispatch_async_path_queries();
+	void _wait_for_async_path_queries();
+	void _finish_async_path_queries();
+
+	NavigationUtilities::PathQueryResult _query_path_on_map(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters) const;
 
 public:
 	GodotNavigationServer();
@@ -136,6 +181,7 @@ public:
 	virtual TypedArray<RID> map_get_links(RID p_map) const override;
 	virtual TypedArray<RID> map_get_regions(RID p_map) const override;
 	virtual TypedArray<RID> map_get_agents(RID p_map) const override;
+	virtual PackedVector3Array map_get_agents_safe_velocities(RID p_map) const override;
 	virtual TypedArray<RID> map_get_obstacles(RID p_map) const override;
 
 	virtual void map_force_update(RID p_map) override;
@@ -255,9 +301,21 @@ public:
 	COMMAND_2(obstacle_set_avoidance_layers, RID, p_obstacle, uint32_t, p_layers);
 	virtual uint32_t obstacle_get_avoidance_layers(RID p_obstacle) const override;
 
+	virtual RID flow_field_create() override;
+	COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map);
+	virtual RID flow_field_get_map(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_targets, RID, p_flow_field, Vector<Vector3>, p_targets);
+	virtual Vector<Vector3> flow_field_get_targets(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers);
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const override;
+	virtual Vector3 flow_field_get_next_position(RID p_flow_field, const Vector3 &p_position) const override;
+	virtual real_t flow_field_get_distance(RID p_flow_field, const Vector3 &p_position) const override;
+
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
+	virtual void bake_tile_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Vector2i &p_tile, const Callable &p_callback = Callable()) override;
+	virtual void bake_tile_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Vector2i &p_tile, const Callable &p_callback = Callable()) override;
 
 	COMMAND_1(free, RID, p_object);
 
@@ -270,6 +328,8 @@ public:
 	virtual void finish() override;
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
+	virtual int64_t query_path_async(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, const Ref<NavigationPathQueryResult3D> &p_query_result, const Callable &p_callback = Callable(), int p_priority = 0) override;
+	virtual bool query_path_async_is_completed(int64_t p_ticket) const override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
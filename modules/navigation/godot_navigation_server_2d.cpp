@@ -233,6 +233,10 @@ TypedArray<RID> FORWARD_1_C(map_get_regions, RID, p_map, rid_to_rid);
 
 TypedArray<RID> FORWARD_1_C(map_get_agents, RID, p_map, rid_to_rid);
 
+PackedVector2Array GodotNavigationServer2D::map_get_agents_safe_velocities(RID p_map) const {
+	return vector_v3_to_v2(NavigationServer3D::get_singleton()->map_get_agents_safe_velocities(p_map));
+}
+
 TypedArray<RID> FORWARD_1_C(map_get_obstacles, RID, p_map, rid_to_rid);
 
 RID FORWARD_1_C(region_get_map, RID, p_region, rid_to_rid);
@@ -127,9 +127,9 @@ bool NavAgent::has_avoidance_callback() const {
 	return avoidance_callback.is_valid();
 }
 
-void NavAgent::dispatch_avoidance_callback() {
-	if (!avoidance_callback.is_valid()) {
-		return;
+Vector3 NavAgent::get_safe_velocity() const {
+	if (!avoidance_enabled) {
+		return velocity;
 	}
 
 	Vector3 new_velocity;
@@ -144,8 +144,16 @@ void NavAgent::dispatch_avoidance_callback() {
 		new_velocity = new_velocity.limit_length(max_speed);
 	}
 
+	return new_velocity;
+}
+
+void NavAgent::dispatch_avoidance_callback() {
+	if (!avoidance_callback.is_valid()) {
+		return;
+	}
+
 	// Invoke the callback with the new velocity.
-	avoidance_callback.call(new_velocity);
+	avoidance_callback.call(get_safe_velocity());
 }
 
 void NavAgent::set_neighbor_distance(real_t p_neighbor_distance) {
@@ -95,6 +95,7 @@ public:
 	void set_avoidance_callback(Callable p_callback);
 	bool has_avoidance_callback() const;
 
+	Vector3 get_safe_velocity() const;
 	void dispatch_avoidance_callback();
 
 	void set_neighbor_distance(real_t p_neighbor_distance);
@@ -0,0 +1,229 @@
+/**************************************************************************/
+/*  nav_flow_field.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_flow_field.h"
+
+#include "nav_base.h"
+#include "nav_map.h"
+
+#include "core/math/geometry_3d.h"
+
+void NavFlowFieldGraph::build(const LocalVector<gd::Polygon> &p_polygons, const LocalVector<gd::Polygon> &p_link_polygons, uint32_t p_link_polygon_count) {
+	// Gather all polygons by id, the link polygons follow the region ones.
+	const uint32_t polygon_count = p_polygons.size() + p_link_polygon_count;
+	polygons.resize(polygon_count);
+	first_incoming.resize(polygon_count + 1);
+	for (uint32_t &first : first_incoming) {
+		first = 0;
+	}
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const gd::Polygon *polygon = polygon_id < p_polygons.size() ? &p_polygons[polygon_id] : &p_link_polygons[polygon_id - p_polygons.size()];
+		ERR_FAIL_COND_MSG(polygon->id != polygon_id, "Navigation map polygons are not indexed by their id.");
+		polygons[polygon_id] = polygon;
+
+		for (const gd::Edge &edge : polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				first_incoming[connection.polygon->id + 1]++;
+			}
+		}
+	}
+
+	// Turn the counts into offsets, then place every connection at the polygon it leads to.
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		first_incoming[polygon_id + 1] += first_incoming[polygon_id];
+	}
+	incoming.resize(first_incoming[polygon_count]);
+
+	LocalVector<uint32_t> incoming_counts;
+	incoming_counts.resize(polygon_count);
+	for (uint32_t &count : incoming_counts) {
+		count = 0;
+	}
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		for (const gd::Edge &edge : polygons[polygon_id]->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t to_polygon = connection.polygon->id;
+				IncomingConnection &incoming_connection = incoming[first_incoming[to_polygon] + incoming_counts[to_polygon]++];
+				incoming_connection.from_polygon = polygon_id;
+				incoming_connection.pathway_start = connection.pathway_start;
+				incoming_connection.pathway_end = connection.pathway_end;
+			}
+		}
+	}
+}
+
+void NavFlowFieldGraph::clear() {
+	polygons.clear();
+	first_incoming.clear();
+	incoming.clear();
+}
+
+void NavFlowField::set_map(NavMap *p_map) {
+	if (map == p_map) {
+		return;
+	}
+
+	if (map) {
+		map->remove_flow_field(this);
+	}
+
+	map = p_map;
+	field_dirty = true;
+	polygon_flows.clear();
+
+	if (map) {
+		map->add_flow_field(this);
+	}
+}
+
+void NavFlowField::set_targets(const Vector<Vector3> &p_targets) {
+	targets = p_targets;
+	field_dirty = true;
+}
+
+void NavFlowField::set_navigation_layers(uint32_t p_navigation_layers) {
+	if (navigation_layers == p_navigation_layers) {
+		return;
+	}
+
+	navigation_layers = p_navigation_layers;
+	field_dirty = true;
+}
+
+bool NavFlowField::is_dirty() const {
+	return field_dirty || (map && map->get_map_update_id() != map_update_id);
+}
+
+void NavFlowField::update(const NavFlowFieldGraph &p_graph) {
+	ERR_FAIL_NULL(map);
+
+	field_dirty = false;
+	map_update_id = map->get_map_update_id();
+
+	const uint32_t polygon_count = p_graph.get_polygon_count();
+	polygon_flows.resize(polygon_count);
+	for (PolygonFlow &flow : polygon_flows) {
+		flow = PolygonFlow();
+	}
+
+	FlowHeap open_flows;
+
+	// Every target starts the search from the polygon it is in.
+	for (const Vector3 &target : targets) {
+		Vector3 target_point;
+		const gd::Polygon *target_polygon = map->get_closest_polygon(target, navigation_layers, target_point);
+		if (!target_polygon) {
+			continue;
+		}
+
+		PolygonFlow &flow = polygon_flows[target_polygon->id];
+		if (flow.cost == 0.0) {
+			// An earlier target already lies in this polygon.
+			continue;
+		}
+		flow.cost = 0.0;
+		flow.next_position = target_point;
+		open_flows.push(&flow);
+	}
+
+	// This is an implementation of the Dijkstra algorithm going backwards along the polygon connections.
+	while (!open_flows.is_empty()) {
+		const PolygonFlow *flow = open_flows.pop();
+		const uint32_t polygon_id = flow - polygon_flows.ptr();
+		const gd::Polygon *polygon = p_graph.get_polygon(polygon_id);
+		const real_t travel_cost = polygon->owner->get_travel_cost();
+		const real_t enter_cost = polygon->owner->get_enter_cost();
+
+		for (const NavFlowFieldGraph::IncomingConnection *connection = p_graph.get_incoming_begin(polygon_id); connection != p_graph.get_incoming_end(polygon_id); connection++) {
+			const gd::Polygon *from_polygon = p_graph.get_polygon(connection->from_polygon);
+			if ((navigation_layers & from_polygon->owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			PolygonFlow &from_flow = polygon_flows[connection->from_polygon];
+			if (from_flow.cost != FLT_MAX && from_flow.heap_index == FlowHeap::INVALID_INDEX) {
+				// Already settled.
+				continue;
+			}
+
+			const Vector3 pathway[2] = { connection->pathway_start, connection->pathway_end };
+			const Vector3 exit_position = Geometry3D::get_closest_point_to_segment(flow->next_position, pathway);
+			real_t cost = flow->cost + exit_position.distance_to(flow->next_position) * travel_cost;
+			if (from_polygon->owner != polygon->owner) {
+				cost += enter_cost;
+			}
+
+			if (cost < from_flow.cost) {
+				const bool in_open_set = from_flow.cost != FLT_MAX;
+				from_flow.cost = cost;
+				from_flow.next_position = exit_position;
+				if (in_open_set) {
+					open_flows.shift(from_flow.heap_index);
+				} else {
+					open_flows.push(&from_flow);
+				}
+			}
+		}
+	}
+}
+
+const gd::Polygon *NavFlowField::_get_flow_polygon(const Vector3 &p_position, Vector3 &r_closest_point) const {
+	if (!map || map->get_map_update_id() != map_update_id) {
+		return nullptr;
+	}
+
+	const gd::Polygon *polygon = map->get_closest_polygon(p_position, navigation_layers, r_closest_point);
+	if (!polygon || polygon->id >= polygon_flows.size() || polygon_flows[polygon->id].cost == FLT_MAX) {
+		return nullptr;
+	}
+	return polygon;
+}
+
+Vector3 NavFlowField::get_next_position(const Vector3 &p_position) const {
+	Vector3 closest_point;
+	const gd::Polygon *polygon = _get_flow_polygon(p_position, closest_point);
+	if (!polygon) {
+		return p_position;
+	}
+	return polygon_flows[polygon->id].next_position;
+}
+
+real_t NavFlowField::get_distance(const Vector3 &p_position) const {
+	Vector3 closest_point;
+	const gd::Polygon *polygon = _get_flow_polygon(p_position, closest_point);
+	if (!polygon) {
+		return INFINITY;
+	}
+
+	const PolygonFlow &flow = polygon_flows[polygon->id];
+	return flow.cost + closest_point.distance_to(flow.next_position) * polygon->owner->get_travel_cost();
+}
@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*  nav_flow_field.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_FLOW_FIELD_H
+#define NAV_FLOW_FIELD_H
+
+#include "nav_rid.h"
+#include "nav_utils.h"
+
+#include "core/templates/local_vector.h"
+
+class NavMap;
+
+/// Connections of the map polygons, reversed so that a search can go from
+/// the targets back to the polygons leading to them.
+class NavFlowFieldGraph {
+public:
+	struct IncomingConnection {
+		/// Polygon the connection comes from.
+		uint32_t from_polygon = 0;
+		/// Gateway on the edge of `from_polygon`.
+		Vector3 pathway_start;
+		Vector3 pathway_end;
+	};
+
+private:
+	/// All polygons of the map, indexed by their id.
+	LocalVector<const gd::Polygon *> polygons;
+	/// Incoming connections of polygon `i` are `incoming[first_incoming[i]]` to `incoming[first_incoming[i + 1]]`.
+	LocalVector<uint32_t> first_incoming;
+	LocalVector<IncomingConnection> incoming;
+
+public:
+	void build(const LocalVector<gd::Polygon> &p_polygons, const LocalVector<gd::Polygon> &p_link_polygons, uint32_t p_link_polygon_count);
+	void clear();
+
+	uint32_t get_polygon_count() const { return polygons.size(); }
+	const gd::Polygon *get_polygon(uint32_t p_polygon_id) const { return polygons[p_polygon_id]; }
+	const IncomingConnection *get_incoming_begin(uint32_t p_polygon_id) const { return incoming.ptr() + first_incoming[p_polygon_id]; }
+	const IncomingConnection *get_incoming_end(uint32_t p_polygon_id) const { return incoming.ptr() + first_incoming[p_polygon_id + 1]; }
+};
+
+/// Travel costs from every polygon of a map to the closest of a set of targets.
+///
+/// The field is computed once per change of the map or the targets with a
+/// Dijkstra search going backwards from the targets. Any number of agents
+/// heading to the same targets then only need to look up the polygon they
+/// are in to know where to go next, instead of each querying a path.
+class NavFlowField : public NavRid {
+	struct PolygonFlow {
+		/// Travel cost from `next_position` to the closest target, `FLT_MAX` when no target can be reached.
+		real_t cost = FLT_MAX;
+		/// Where to head to from anywhere in the polygon, on the edge leading to the next polygon or the target itself.
+		Vector3 next_position;
+		/// Position in the open set heap, or `UINT32_MAX` when not in it.
+		uint32_t heap_index = UINT32_MAX;
+	};
+
+	struct PolygonFlowCostLessThan {
+		_FORCE_INLINE_ bool operator()(const PolygonFlow *p_flow_a, const PolygonFlow *p_flow_b) const {
+			return p_flow_a->cost < p_flow_b->cost;
+		}
+	};
+
+	struct PolygonFlowHeapIndexer {
+		_FORCE_INLINE_ void operator()(PolygonFlow *p_flow, uint32_t p_heap_index) const {
+			p_flow->heap_index = p_heap_index;
+		}
+	};
+
+	typedef gd::Heap<PolygonFlow *, PolygonFlowCostLessThan, PolygonFlowHeapIndexer> FlowHeap;
+
+	NavMap *map = nullptr;
+	Vector<Vector3> targets;
+	uint32_t navigation_layers = 1;
+
+	/// Set when the map, targets or layers changed since the field was last computed.
+	bool field_dirty = true;
+	/// Map update id the field was last computed for.
+	uint32_t map_update_id = 0;
+
+	/// Flow of every polygon of the map, indexed by polygon id.
+	LocalVector<PolygonFlow> polygon_flows;
+
+	/// Returns the polygon closest to `p_position` when a target can be reached from it.
+	const gd::Polygon *_get_flow_polygon(const Vector3 &p_position, Vector3 &r_closest_point) const;
+
+public:
+	void set_map(NavMap *p_map);
+	NavMap *get_map() const { return map; }
+
+	void set_targets(const Vector<Vector3> &p_targets);
+	const Vector<Vector3> &get_targets() const { return targets; }
+
+	void set_navigation_layers(uint32_t p_navigation_layers);
+	uint32_t get_navigation_layers() const { return navigation_layers; }
+
+	/// Returns true when the field has to be computed again for the current state of its map.
+	bool is_dirty() const;
+	/// Computes the field over the map polygons, `p_graph` has to be built for the current state of the map.
+	void update(const NavFlowFieldGraph &p_graph);
+
+	/// Returns where an agent at `p_position` should move to next, or `p_position` when no target can be reached.
+	Vector3 get_next_position(const Vector3 &p_position) const;
+	/// Returns the travel cost from `p_position` to the closest target, or `INFINITY` when no target can be reached.
+	real_t get_distance(const Vector3 &p_position) const;
+};
+
+#endif // NAV_FLOW_FIELD_H
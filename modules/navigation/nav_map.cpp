@@ -37,6 +37,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 
 #include <Obstacle2d.h>
 
@@ -84,6 +85,7 @@ void NavMap::set_use_edge_connections(bool p_enabled) {
 	}
 	use_edge_connections = p_enabled;
 	regenerate_links = true;
+	region_pair_connections.clear();
 }
 
 void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
@@ -92,6 +94,7 @@ void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
 	}
 	edge_connection_margin = p_edge_connection_margin;
 	regenerate_links = true;
+	region_pair_connections.clear();
 }
 
 void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
@@ -129,40 +132,14 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	}
 
 	// Find the start poly and the end poly on this map.
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
+	// Only consider the polygons in regions with compatible layers.
+	const auto has_compatible_layers = [p_navigation_layers](const gd::Polygon &p_polygon) {
+		return (p_navigation_layers & p_polygon.owner->get_navigation_layers()) != 0;
+	};
 	Vector3 begin_point;
 	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
-	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
+	const gd::Polygon *begin_poly = polygon_bvh.get_closest_polygon(polygons, p_origin, has_compatible_layers, begin_point);
+	const gd::Polygon *end_poly = polygon_bvh.get_closest_polygon(polygons, p_destination, has_compatible_layers, end_point);
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -194,24 +171,42 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
-	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	// Search state of all polygons, indexed by polygon id and reused between queries of this thread.
+	// Polygons that were not reached by the current search have an older generation.
+	PathQueryScratch &scratch = path_query_scratch;
+	LocalVector<gd::NavigationPoly> &navigation_polys = scratch.navigation_polys;
+	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostLessThan, gd::NavPolyHeapIndexer> &traversable_polys = scratch.traversable_polys;
+
+	// The heap of the previous query still points into the polygon buffer and clearing it writes
+	// through those pointers, so it has to be cleared before the buffer can be reallocated.
+	traversable_polys.clear();
+	const uint32_t navigation_poly_count = polygons.size() + link_polygons.size();
+	if (navigation_polys.size() < navigation_poly_count) {
+		navigation_polys.resize(navigation_poly_count);
+	}
+	traversable_polys.reserve(polygons.size() * 0.25);
 
-	// Add the start polygon to the reachable navigation polygons.
-	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
-	begin_navigation_poly.self_id = 0;
-	begin_navigation_poly.entry = begin_point;
-	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
-	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
-	navigation_polys.push_back(begin_navigation_poly);
+	uint32_t generation = scratch.next_generation();
 
-	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
-	to_visit.push_back(0);
+	// When the query crosses regions, first find the regions to cross on the map hierarchy
+	// and only search the polygons of those. The whole map is searched if that fails.
+	LocalVector<uint8_t> &corridor = scratch.corridor;
+	bool use_corridor = false;
+	if (!hierarchy.is_empty() && hierarchy.get_polygon_cluster(begin_poly->id) != hierarchy.get_polygon_cluster(end_poly->id)) {
+		use_corridor = hierarchy.find_corridor(begin_poly, begin_point, end_poly, end_point, p_navigation_layers, corridor);
+	}
+
+	// Add the start polygon to the reachable navigation polygons.
+	gd::NavigationPoly *begin_navigation_poly = &navigation_polys[begin_poly->id];
+	*begin_navigation_poly = gd::NavigationPoly(begin_poly);
+	begin_navigation_poly->self_id = begin_poly->id;
+	begin_navigation_poly->search_generation = generation;
+	begin_navigation_poly->entry = begin_point;
+	begin_navigation_poly->back_navigation_edge_pathway_start = begin_point;
+	begin_navigation_poly->back_navigation_edge_pathway_end = begin_point;
 
 	// This is an implementation of the A* algorithm.
-	int least_cost_id = 0;
+	int least_cost_id = begin_poly->id;
 	int prev_least_cost_id = -1;
 	bool found_route = false;
 
@@ -231,6 +226,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				// Only consider the polygons of the regions picked by the hierarchical search.
+				if (use_corridor && !corridor[hierarchy.get_polygon_cluster(connection.polygon->id)]) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -244,42 +244,58 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, pathway);
 				const real_t new_distance = (least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost) + poly_enter_cost + least_cost_poly.traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
+				gd::NavigationPoly &neighbor_poly = navigation_polys[connection.polygon->id];
 
-				if (already_visited_polygon_index != -1) {
+				if (neighbor_poly.search_generation == generation) {
 					// Polygon already visited, check if we can reduce the travel cost.
-					gd::NavigationPoly &avp = navigation_polys[already_visited_polygon_index];
-					if (new_distance < avp.traveled_distance) {
-						avp.back_navigation_poly_id = least_cost_id;
-						avp.back_navigation_edge = connection.edge;
-						avp.back_navigation_edge_pathway_start = connection.pathway_start;
-						avp.back_navigation_edge_pathway_end = connection.pathway_end;
-						avp.traveled_distance = new_distance;
-						avp.entry = new_entry;
+					if (new_distance < neighbor_poly.traveled_distance) {
+						neighbor_poly.back_navigation_poly_id = least_cost_id;
+						neighbor_poly.back_navigation_edge = connection.edge;
+						neighbor_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+						neighbor_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+						neighbor_poly.traveled_distance = new_distance;
+						neighbor_poly.entry = new_entry;
+						neighbor_poly.total_cost = new_distance + new_entry.distance_to(end_point) * neighbor_poly.poly->owner->get_travel_cost();
+
+						if (neighbor_poly.heap_index != traversable_polys.INVALID_INDEX) {
+							traversable_polys.shift(neighbor_poly.heap_index);
+						}
 					}
 				} else {
 					// Add the neighbor polygon to the reachable ones.
-					gd::NavigationPoly new_navigation_poly = gd::NavigationPoly(connection.polygon);
-					new_navigation_poly.self_id = navigation_polys.size();
-					new_navigation_poly.back_navigation_poly_id = least_cost_id;
-					new_navigation_poly.back_navigation_edge = connection.edge;
-					new_navigation_poly.back_navigation_edge_pathway_start = connection.pathway_start;
-					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
-					new_navigation_poly.traveled_distance = new_distance;
-					new_navigation_poly.entry = new_entry;
-					navigation_polys.push_back(new_navigation_poly);
+					neighbor_poly = gd::NavigationPoly(connection.polygon);
+					neighbor_poly.self_id = connection.polygon->id;
+					neighbor_poly.search_generation = generation;
+					neighbor_poly.back_navigation_poly_id = least_cost_id;
+					neighbor_poly.back_navigation_edge = connection.edge;
+					neighbor_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+					neighbor_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+					neighbor_poly.traveled_distance = new_distance;
+					neighbor_poly.entry = new_entry;
+					neighbor_poly.total_cost = new_distance + new_entry.distance_to(end_point) * neighbor_poly.poly->owner->get_travel_cost();
 
 					// Add the neighbor polygon to the polygons to visit.
-					to_visit.push_back(navigation_polys.size() - 1);
+					traversable_polys.push(&neighbor_poly);
 				}
 			}
 		}
 
-		// Removes the least cost polygon from the list of polygons to visit so we can advance.
-		to_visit.erase(least_cost_id);
-
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
-		if (to_visit.size() == 0) {
+		if (traversable_polys.is_empty()) {
+			if (use_corridor) {
+				// The regions picked by the hierarchical search do not lead to the end, search the whole map instead.
+				use_corridor = false;
+				generation = scratch.next_generation();
+				begin_navigation_poly->search_generation = generation;
+				least_cost_id = begin_poly->id;
+				prev_least_cost_id = -1;
+
+				reachable_end = nullptr;
+				reachable_d = FLT_MAX;
+
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -290,7 +306,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 			// Set as end point the furthest reachable point.
 			end_poly = reachable_end;
-			end_d = FLT_MAX;
+			real_t end_d = FLT_MAX;
 			for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
 				Face3 f(end_poly->points[0].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
 				Vector3 spoint = f.get_closest_point_to(p_destination);
@@ -341,13 +357,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				return path;
 			}
 
-			// Reset open and navigation_polys
-			gd::NavigationPoly np = navigation_polys[0];
-			navigation_polys.clear();
-			navigation_polys.push_back(np);
-			to_visit.clear();
-			to_visit.push_back(0);
-			least_cost_id = 0;
+			// Reset open and navigation_polys, a new generation forgets every polygon but the start one.
+			generation = scratch.next_generation();
+			begin_navigation_poly->search_generation = generation;
+			traversable_polys.clear();
+			least_cost_id = begin_poly->id;
 			prev_least_cost_id = -1;
 
 			reachable_end = nullptr;
@@ -355,20 +369,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			continue;
 		}
 
-		// Find the polygon with the minimum cost from the list of polygons to visit.
-		least_cost_id = -1;
-		real_t least_cost = FLT_MAX;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			real_t cost = np->traveled_distance;
-			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
-			}
-		}
-
-		ERR_BREAK(least_cost_id == -1);
+		// Pop the polygon with the minimum cost from the list of polygons to visit.
+		least_cost_id = traversable_polys.pop()->self_id;
 
 		// Stores the further reachable end polygon, in case our goal is not reachable.
 		if (is_reachable) {
@@ -389,7 +391,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	// We did not find a route but we have both a start polygon and an end polygon at this point.
 	// Usually this happens because there was not a single external or internal connected edge, e.g. our start polygon is an isolated, single convex polygon.
 	if (!found_route) {
-		end_d = FLT_MAX;
+		real_t end_d = FLT_MAX;
 		// Search all faces of the start polygon for the closest point to our target position.
 		for (size_t point_id = 2; point_id < begin_poly->points.size(); point_id++) {
 			Face3 f(begin_poly->points[0].pos, begin_poly->points[point_id - 1].pos, begin_poly->points[point_id].pos);
@@ -577,47 +579,15 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
 	ERR_FAIL_COND_V_MSG(map_update_id == 0, Vector3(), "NavigationServer map query failed because it was made before first map synchronization.");
-	bool use_collision = p_use_collision;
 	Vector3 closest_point;
-	real_t closest_point_d = FLT_MAX;
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
-				}
-			}
-		}
+	// Prefer the intersection with the navigation mesh surface that is closest to the segment start.
+	if (polygon_bvh.intersect_segment(polygons, p_from, p_to, closest_point)) {
+		return closest_point;
+	}
 
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
-
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
-
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
-				}
-			}
-		}
+	if (!p_use_collision) {
+		polygon_bvh.get_closest_outline_point_to_segment(polygons, p_from, p_to, closest_point);
 	}
 
 	return closest_point;
@@ -641,23 +611,20 @@ RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
 	return cp.owner;
 }
 
+const gd::Polygon *NavMap::get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, Vector3 &r_closest_point) const {
+	const auto has_compatible_layers = [p_navigation_layers](const gd::Polygon &p_polygon) {
+		return (p_navigation_layers & p_polygon.owner->get_navigation_layers()) != 0;
+	};
+	return polygon_bvh.get_closest_polygon(polygons, p_point, has_compatible_layers, r_closest_point);
+}
+
 gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = FLT_MAX;
-
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
-			}
-		}
+
+	const gd::Polygon *closest_polygon = polygon_bvh.get_closest_polygon(
+			polygons, p_point, [](const gd::Polygon &) { return true; }, result.point, &result.normal);
+	if (closest_polygon) {
+		result.owner = closest_polygon->owner->get_self();
 	}
 
 	return result;
@@ -733,6 +700,27 @@ void NavMap::remove_obstacle(NavObstacle *obstacle) {
 	}
 }
 
+bool NavMap::has_flow_field(NavFlowField *p_flow_field) const {
+	return flow_fields.find(p_flow_field) >= 0;
+}
+
+void NavMap::add_flow_field(NavFlowField *p_flow_field) {
+	if (!has_flow_field(p_flow_field)) {
+		flow_fields.push_back(p_flow_field);
+	}
+}
+
+void NavMap::remove_flow_field(NavFlowField *p_flow_field) {
+	int64_t flow_field_index = flow_fields.find(p_flow_field);
+	if (flow_field_index >= 0) {
+		flow_fields.remove_at_unordered(flow_field_index);
+	}
+	if (flow_fields.is_empty()) {
+		flow_field_graph.clear();
+		flow_field_graph_map_update_id = 0;
+	}
+}
+
 void NavMap::set_agent_as_controlled(NavAgent *agent) {
 	remove_agent_as_controlled(agent);
 
@@ -833,6 +821,69 @@ Vector3 NavMap::get_random_point(uint32_t p_navigation_layers, bool p_uniformly)
 	}
 }
 
+bool NavMap::_get_edge_connection_pathway(const gd::Edge::Connection &p_edge, const gd::Edge::Connection &p_other_edge, Vector3 &r_pathway_start, Vector3 &r_pathway_end) const {
+	Vector3 edge_p1 = p_edge.polygon->points[p_edge.edge].pos;
+	Vector3 edge_p2 = p_edge.polygon->points[(p_edge.edge + 1) % p_edge.polygon->points.size()].pos;
+
+	Vector3 other_edge_p1 = p_other_edge.polygon->points[p_other_edge.edge].pos;
+	Vector3 other_edge_p2 = p_other_edge.polygon->points[(p_other_edge.edge + 1) % p_other_edge.polygon->points.size()].pos;
+
+	// Compute the projection of the opposite edge on the current one
+	Vector3 edge_vector = edge_p2 - edge_p1;
+	real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+	real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+	if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+		return false;
+	}
+
+	// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+	Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other1;
+	if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+		other1 = other_edge_p1;
+	} else {
+		other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other1.distance_to(self1) > edge_connection_margin) {
+		return false;
+	}
+
+	Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other2;
+	if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+		other2 = other_edge_p2;
+	} else {
+		other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other2.distance_to(self2) > edge_connection_margin) {
+		return false;
+	}
+
+	r_pathway_start = (self1 + other1) / 2.0;
+	r_pathway_end = (self2 + other2) / 2.0;
+	return true;
+}
+
+void NavMap::_find_region_pair_connections(const gd::Edge::Connection *p_free_edges_a, uint32_t p_free_edge_count_a, const gd::Edge::Connection *p_free_edges_b, uint32_t p_free_edge_count_b, bool p_from_a, uint32_t p_first_polygon_a, uint32_t p_first_polygon_b, LocalVector<RegionPairConnection> &r_connections) const {
+	for (uint32_t i = 0; i < p_free_edge_count_a; i++) {
+		const gd::Edge::Connection &free_edge = p_free_edges_a[i];
+		for (uint32_t j = 0; j < p_free_edge_count_b; j++) {
+			const gd::Edge::Connection &other_edge = p_free_edges_b[j];
+
+			RegionPairConnection connection;
+			if (!_get_edge_connection_pathway(free_edge, other_edge, connection.pathway_start, connection.pathway_end)) {
+				continue;
+			}
+			connection.from_a = p_from_a;
+			connection.from_polygon = free_edge.polygon->id - p_first_polygon_a;
+			connection.from_edge = free_edge.edge;
+			connection.to_polygon = other_edge.polygon->id - p_first_polygon_b;
+			connection.to_edge = other_edge.edge;
+			r_connections.push_back(connection);
+		}
+	}
+}
+
 void NavMap::sync() {
 	// Performance Monitor
 	int _new_pm_region_count = regions.size();
@@ -871,56 +922,108 @@ void NavMap::sync() {
 		_new_pm_edge_connection_count = 0;
 		_new_pm_edge_free_count = 0;
 
+		const uint64_t sync_begin_usec = OS::get_singleton()->get_ticks_usec();
+
 		// Remove regions connections.
 		for (NavRegion *region : regions) {
 			region->get_connections().clear();
 		}
 
-		// Resize the polygon count.
-		int count = 0;
+		// Place the polygons of the enabled regions one after another.
+		HashMap<const NavRegion *, RegionSyncState> new_region_sync_states;
+		LocalVector<const NavRegion *> enabled_regions;
+		uint32_t count = 0;
 		for (const NavRegion *region : regions) {
 			if (!region->get_enabled()) {
 				continue;
 			}
-			count += region->get_polygons().size();
+			RegionSyncState state;
+			state.first_polygon = count;
+			state.polygon_count = region->get_polygons().size();
+			state.polygons_revision = region->get_polygons_revision();
+			new_region_sync_states.insert(region, state);
+			enabled_regions.push_back(region);
+			count += state.polygon_count;
 		}
 		polygons.resize(count);
 
-		// Copy all region polygons in the map.
-		count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
+		// Copy the region polygons in the map, unless the same polygons are still in place from the last synchronization.
+		uint32_t copied_region_count = 0;
+		for (const NavRegion *region : enabled_regions) {
+			const RegionSyncState &state = new_region_sync_states[region];
+			const RegionSyncState *previous_state = region_sync_states.getptr(region);
+			if (previous_state && previous_state->first_polygon == state.first_polygon && previous_state->polygon_count == state.polygon_count && previous_state->polygons_revision == state.polygons_revision) {
+				for (uint32_t n = 0; n < state.polygon_count; n++) {
+					for (gd::Edge &edge : polygons[state.first_polygon + n].edges) {
+						edge.connections.clear();
+					}
+				}
 				continue;
 			}
+
 			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
 			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
+				polygons[state.first_polygon + n] = polygons_source[n];
+				polygons[state.first_polygon + n].id = state.first_polygon + n;
 			}
-			count += region->get_polygons().size();
+			copied_region_count++;
 		}
 
 		_new_pm_polygon_count = polygons.size();
 
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+		const uint64_t sync_polygons_usec = OS::get_singleton()->get_ticks_usec();
+
+		// Connect the edges already merged within each region.
+		for (const NavRegion *region : enabled_regions) {
+			const uint32_t first_polygon = new_region_sync_states[region].first_polygon;
+			const LocalVector<gd::RegionEdge> &merged_edges = region->get_merged_edges();
+			for (uint32_t i = 0; i + 1 < merged_edges.size(); i += 2) {
+				gd::Polygon &poly_a = polygons[first_polygon + merged_edges[i].polygon];
+				gd::Polygon &poly_b = polygons[first_polygon + merged_edges[i + 1].polygon];
+				const int edge_a = merged_edges[i].edge;
+				const int edge_b = merged_edges[i + 1].edge;
+
+				gd::Edge::Connection c1;
+				c1.polygon = &poly_a;
+				c1.edge = edge_a;
+				c1.pathway_start = poly_a.points[edge_a].pos;
+				c1.pathway_end = poly_a.points[(edge_a + 1) % poly_a.points.size()].pos;
+
+				gd::Edge::Connection c2;
+				c2.polygon = &poly_b;
+				c2.edge = edge_b;
+				c2.pathway_start = poly_b.points[edge_b].pos;
+				c2.pathway_end = poly_b.points[(edge_b + 1) % poly_b.points.size()].pos;
+
+				poly_a.edges[edge_a].connections.push_back(c2);
+				poly_b.edges[edge_b].connections.push_back(c1);
+				_new_pm_edge_count += 1;
+				_new_pm_edge_merge_count += 1;
+			}
+		}
 
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
+		// Group the remaining border edges of all regions per key.
+		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
+		for (const NavRegion *region : enabled_regions) {
+			const uint32_t first_polygon = new_region_sync_states[region].first_polygon;
+			for (const gd::RegionEdge &border_edge : region->get_border_edges()) {
+				gd::Polygon &poly = polygons[first_polygon + border_edge.polygon];
+				const int p = border_edge.edge;
+				const int next_point = (p + 1) % poly.points.size();
+
+				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(border_edge.key);
 				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
+					connection = connections.insert(border_edge.key, Vector<gd::Edge::Connection>());
 					_new_pm_edge_count += 1;
 				}
-				if (connections[ek].size() <= 1) {
+				if (connection->value.size() <= 1) {
 					// Add the polygon/edge tuple to this key.
 					gd::Edge::Connection new_connection;
 					new_connection.polygon = &poly;
 					new_connection.edge = p;
 					new_connection.pathway_start = poly.points[p].pos;
 					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
+					connection->value.push_back(new_connection);
 				} else {
 					// The edge is already connected with another edge, skip.
 					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'.");
@@ -928,7 +1031,6 @@ void NavMap::sync() {
 			}
 		}
 
-		Vector<gd::Edge::Connection> free_edges;
 		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
 			if (E.value.size() == 2) {
 				// Connect edge that are shared in different polygons.
@@ -938,14 +1040,30 @@ void NavMap::sync() {
 				c2.polygon->edges[c2.edge].connections.push_back(c1);
 				// Note: The pathway_start/end are full for those connection and do not need to be modified.
 				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
+			}
+		}
+
+		// Gather the free edges of each region.
+		LocalVector<gd::Edge::Connection> free_edges;
+		for (const NavRegion *region : enabled_regions) {
+			RegionSyncState &state = new_region_sync_states[region];
+			state.first_free_edge = free_edges.size();
+			if (use_edge_connections && region->get_use_edge_connections()) {
+				for (const gd::RegionEdge &border_edge : region->get_border_edges()) {
+					const Vector<gd::Edge::Connection> &edge_connections = connections[border_edge.key];
+					CRASH_COND_MSG(edge_connections.size() != 1 && edge_connections.size() != 2, vformat("Number of connection != 1. Found: %d", edge_connections.size()));
+					if (edge_connections.size() == 1) {
+						free_edges.push_back(edge_connections[0]);
+						state.free_edges_hash = hash_murmur3_one_32(border_edge.polygon, state.free_edges_hash);
+						state.free_edges_hash = hash_murmur3_one_32(border_edge.edge, state.free_edges_hash);
+					}
 				}
 			}
+			state.free_edge_count = free_edges.size() - state.first_free_edge;
 		}
 
+		const uint64_t sync_edges_usec = OS::get_singleton()->get_ticks_usec();
+
 		// Find the compatible near edges.
 		//
 		// Note:
@@ -955,62 +1073,79 @@ void NavMap::sync() {
 		// connection, integration and path finding.
 		_new_pm_edge_free_count = free_edges.size();
 
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+		// Only regions whose bounds are within the connection margin of each other can be connected.
+		// The connections of a pair of regions are reused as long as neither of them changed.
+		uint32_t reused_region_pair_count = 0;
+		for (uint32_t i = 0; i < enabled_regions.size(); i++) {
+			const RegionSyncState &state_i = new_region_sync_states[enabled_regions[i]];
+			if (state_i.free_edge_count == 0) {
+				continue;
+			}
+			const AABB bounds_i = enabled_regions[i]->get_bounds().grow(edge_connection_margin);
 
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
+			for (uint32_t j = i + 1; j < enabled_regions.size(); j++) {
+				const RegionSyncState &state_j = new_region_sync_states[enabled_regions[j]];
+				if (state_j.free_edge_count == 0 || !bounds_i.intersects_inclusive(enabled_regions[j]->get_bounds())) {
 					continue;
 				}
 
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+				const bool i_is_a = enabled_regions[i] < enabled_regions[j];
+				RegionPairKey key;
+				key.a = i_is_a ? enabled_regions[i] : enabled_regions[j];
+				key.b = i_is_a ? enabled_regions[j] : enabled_regions[i];
+				const RegionSyncState &state_a = i_is_a ? state_i : state_j;
+				const RegionSyncState &state_b = i_is_a ? state_j : state_i;
 
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
-				}
-
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
+				RegionPairConnections *pair = region_pair_connections.getptr(key);
+				if (pair && pair->polygons_revision_a == state_a.polygons_revision && pair->polygons_revision_b == state_b.polygons_revision && pair->free_edges_hash_a == state_a.free_edges_hash && pair->free_edges_hash_b == state_b.free_edges_hash) {
+					reused_region_pair_count++;
 				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
+					if (!pair) {
+						pair = &region_pair_connections.insert(key, RegionPairConnections())->value;
+					}
+					pair->polygons_revision_a = state_a.polygons_revision;
+					pair->polygons_revision_b = state_b.polygons_revision;
+					pair->free_edges_hash_a = state_a.free_edges_hash;
+					pair->free_edges_hash_b = state_b.free_edges_hash;
+					pair->connections.clear();
+					_find_region_pair_connections(&free_edges[state_a.first_free_edge], state_a.free_edge_count, &free_edges[state_b.first_free_edge], state_b.free_edge_count, true, state_a.first_polygon, state_b.first_polygon, pair->connections);
+					_find_region_pair_connections(&free_edges[state_b.first_free_edge], state_b.free_edge_count, &free_edges[state_a.first_free_edge], state_a.free_edge_count, false, state_b.first_polygon, state_a.first_polygon, pair->connections);
 				}
+				pair->sync_id = map_update_id;
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
-					continue;
+				// The edges can now be connected.
+				for (const RegionPairConnection &pair_connection : pair->connections) {
+					const RegionSyncState &from_state = pair_connection.from_a ? state_a : state_b;
+					const RegionSyncState &to_state = pair_connection.from_a ? state_b : state_a;
+					gd::Polygon &from_polygon = polygons[from_state.first_polygon + pair_connection.from_polygon];
+
+					gd::Edge::Connection new_connection;
+					new_connection.polygon = &polygons[to_state.first_polygon + pair_connection.to_polygon];
+					new_connection.edge = pair_connection.to_edge;
+					new_connection.pathway_start = pair_connection.pathway_start;
+					new_connection.pathway_end = pair_connection.pathway_end;
+					from_polygon.edges[pair_connection.from_edge].connections.push_back(new_connection);
+
+					// Add the connection to the region_connection map.
+					((NavRegion *)from_polygon.owner)->get_connections().push_back(new_connection);
+					_new_pm_edge_connection_count += 1;
 				}
+			}
+		}
 
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
-
-				// Add the connection to the region_connection map.
-				((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+		// Forget the regions and region pairs that are gone.
+		region_sync_states = new_region_sync_states;
+		LocalVector<RegionPairKey> unused_region_pairs;
+		for (const KeyValue<RegionPairKey, RegionPairConnections> &E : region_pair_connections) {
+			if (E.value.sync_id != map_update_id) {
+				unused_region_pairs.push_back(E.key);
 			}
 		}
+		for (const RegionPairKey &key : unused_region_pairs) {
+			region_pair_connections.erase(key);
+		}
+
+		const uint64_t sync_edge_connections_usec = OS::get_singleton()->get_ticks_usec();
 
 		uint32_t link_poly_idx = 0;
 		link_polygons.resize(links.size());
@@ -1031,46 +1166,53 @@ void NavMap::sync() {
 			real_t closest_end_distance = link_connection_radius;
 			Vector3 closest_end_point;
 
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
+			for (const NavRegion *region : enabled_regions) {
+				// Only the regions within the search radius can hold polygons to link to.
+				const AABB region_bounds = region->get_bounds().grow(link_connection_radius);
+				const bool region_has_start = region_bounds.has_point(start);
+				const bool region_has_end = region_bounds.has_point(end);
+				if (!region_has_start && !region_has_end) {
+					continue;
 				}
-			}
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
+				const RegionSyncState &state = region_sync_states[region];
+				for (uint32_t polygon_index = state.first_polygon; polygon_index < state.first_polygon + state.polygon_count; polygon_index++) {
+					gd::Polygon &poly = polygons[polygon_index];
+
+					// For each face check the distance to the start and to the end.
+					for (uint32_t point_id = 2; point_id < poly.points.size(); point_id += 1) {
+						const Face3 face(poly.points[0].pos, poly.points[point_id - 1].pos, poly.points[point_id].pos);
+
+						// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+						if (region_has_start) {
+							const Vector3 start_point = face.get_closest_point_to(start);
+							const real_t start_distance = start_point.distance_to(start);
+							if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
+								closest_start_distance = start_distance;
+								closest_start_point = start_point;
+								closest_start_polygon = &poly;
+							}
+						}
+
+						if (region_has_end) {
+							const Vector3 end_point = face.get_closest_point_to(end);
+							const real_t end_distance = end_point.distance_to(end);
+							if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
+								closest_end_distance = end_distance;
+								closest_end_point = end_point;
+								closest_end_polygon = &poly;
+							}
+						}
 					}
 				}
 			}
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
 			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
+				gd::Polygon &new_polygon = link_polygons[link_poly_idx];
+				new_polygon.id = polygons.size() + link_poly_idx;
 				new_polygon.owner = link;
+				link_poly_idx++;
 
 				new_polygon.edges.clear();
 				new_polygon.edges.resize(4);
@@ -1126,6 +1268,29 @@ void NavMap::sync() {
 			}
 		}
 
+		link_polygon_count = link_poly_idx;
+
+		const uint64_t sync_links_usec = OS::get_singleton()->get_ticks_usec();
+
+		polygon_bvh.build(polygons);
+
+		const uint64_t sync_bvh_usec = OS::get_singleton()->get_ticks_usec();
+
+		// Update the hierarchy, only the regions that changed get their portal costs recomputed.
+		if (use_hierarchical_pathfinding) {
+			hierarchy.build(polygons, link_polygons, link_poly_idx);
+		}
+
+		const uint64_t sync_end_usec = OS::get_singleton()->get_ticks_usec();
+		print_verbose(vformat("NavigationServer: Map synchronized in %d usec (polygons: %d usec, %d of %d regions copied; edges: %d usec; edge connections: %d usec, %d region pairs reused; links: %d usec; polygon BVH: %d usec; hierarchy: %d usec).",
+				sync_end_usec - sync_begin_usec,
+				sync_polygons_usec - sync_begin_usec, copied_region_count, enabled_regions.size(),
+				sync_edges_usec - sync_polygons_usec,
+				sync_edge_connections_usec - sync_edges_usec, reused_region_pair_count,
+				sync_links_usec - sync_edge_connections_usec,
+				sync_bvh_usec - sync_links_usec,
+				sync_end_usec - sync_bvh_usec));
+
 		// Update the update ID.
 		// Some code treats 0 as a failure case, so we avoid returning 0.
 		map_update_id = map_update_id % 9999999 + 1;
@@ -1149,6 +1314,9 @@ void NavMap::sync() {
 		_update_rvo_simulation();
 	}
 
+	// Recompute the flow fields whose map or targets changed.
+	_update_flow_fields();
+
 	regenerate_polygons = false;
 	regenerate_links = false;
 	obstacles_dirty = false;
@@ -1165,6 +1333,36 @@ void NavMap::sync() {
 	pm_edge_free_count = _new_pm_edge_free_count;
 }
 
+void NavMap::compute_single_flow_field(uint32_t index, NavFlowField **flow_field) {
+	(*(flow_field + index))->update(flow_field_graph);
+}
+
+void NavMap::_update_flow_fields() {
+	LocalVector<NavFlowField *> dirty_flow_fields;
+	for (NavFlowField *flow_field : flow_fields) {
+		if (flow_field->is_dirty()) {
+			dirty_flow_fields.push_back(flow_field);
+		}
+	}
+	if (dirty_flow_fields.is_empty()) {
+		return;
+	}
+
+	if (flow_field_graph_map_update_id != map_update_id) {
+		flow_field_graph.build(polygons, link_polygons, link_polygon_count);
+		flow_field_graph_map_update_id = map_update_id;
+	}
+
+	if (use_threads && dirty_flow_fields.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_flow_field, dirty_flow_fields.ptr(), dirty_flow_fields.size(), -1, true, SNAME("NavFlowFields"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (NavFlowField *flow_field : dirty_flow_fields) {
+			flow_field->update(flow_field_graph);
+		}
+	}
+}
+
 void NavMap::_update_rvo_obstacles_tree_2d() {
 	int obstacle_vertex_count = 0;
 	for (NavObstacle *obstacle : obstacles) {
@@ -1250,7 +1448,18 @@ void NavMap::_update_rvo_agents_tree_2d() {
 	for (NavAgent *agent : active_2d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_2d());
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+
+	if (use_threads && avoidance_use_multiple_threads && raw_agents.size() > RVO_AGENT_SUBTREE_MIN_SIZE * 2) {
+		// Only split the top of the tree here and let the pool build the disjoint subtrees below it.
+		const size_t max_subtree_size = MAX(RVO_AGENT_SUBTREE_MIN_SIZE, raw_agents.size() / (MAX(WorkerThreadPool::get_singleton()->get_thread_count(), 1) * 4));
+		std::vector<RVO2D::KdTree2D::AgentSubtree2D> subtrees;
+		rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents, &subtrees, max_subtree_size);
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::build_rvo_agent_subtree_2d, subtrees.data(), subtrees.size(), -1, true, SNAME("RVOAgentTree2D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+	}
 }
 
 void NavMap::_update_rvo_agents_tree_3d() {
@@ -1260,7 +1469,18 @@ void NavMap::_update_rvo_agents_tree_3d() {
 	for (NavAgent *agent : active_3d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_3d());
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+
+	if (use_threads && avoidance_use_multiple_threads && raw_agents.size() > RVO_AGENT_SUBTREE_MIN_SIZE * 2) {
+		// Only split the top of the tree here and let the pool build the disjoint subtrees below it.
+		const size_t max_subtree_size = MAX(RVO_AGENT_SUBTREE_MIN_SIZE, raw_agents.size() / (MAX(WorkerThreadPool::get_singleton()->get_thread_count(), 1) * 4));
+		std::vector<RVO3D::KdTree3D::AgentSubtree3D> subtrees;
+		rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents, &subtrees, max_subtree_size);
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::build_rvo_agent_subtree_3d, subtrees.data(), subtrees.size(), -1, true, SNAME("RVOAgentTree3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+	}
 }
 
 void NavMap::_update_rvo_simulation() {
@@ -1273,6 +1493,16 @@ void NavMap::_update_rvo_simulation() {
 	}
 }
 
+void NavMap::build_rvo_agent_subtree_2d(uint32_t index, RVO2D::KdTree2D::AgentSubtree2D *subtrees) {
+	const RVO2D::KdTree2D::AgentSubtree2D &subtree = subtrees[index];
+	rvo_simulation_2d.kdTree_->buildAgentTreeRecursive(subtree.begin, subtree.end, subtree.node);
+}
+
+void NavMap::build_rvo_agent_subtree_3d(uint32_t index, RVO3D::KdTree3D::AgentSubtree3D *subtrees) {
+	const RVO3D::KdTree3D::AgentSubtree3D &subtree = subtrees[index];
+	rvo_simulation_3d.kdTree_->buildAgentTreeRecursive(subtree.begin, subtree.end, subtree.node);
+}
+
 void NavMap::compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent) {
 	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
 	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
@@ -1365,9 +1595,23 @@ void NavMap::clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys
 	}
 }
 
+thread_local NavMap::PathQueryScratch NavMap::path_query_scratch;
+
+uint32_t NavMap::PathQueryScratch::next_generation() {
+	if (++generation == 0) {
+		// The generation wrapped around, old states could be taken for current ones.
+		for (gd::NavigationPoly &np : navigation_polys) {
+			np.search_generation = 0;
+		}
+		generation = 1;
+	}
+	return generation;
+}
+
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+	use_hierarchical_pathfinding = GLOBAL_GET("navigation/pathfinding/use_hierarchical_pathfinding");
 }
 
 NavMap::~NavMap() {
@@ -31,6 +31,9 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_flow_field.h"
+#include "nav_map_hierarchy.h"
+#include "nav_polygon_bvh.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
@@ -72,14 +75,92 @@ class NavMap : public NavRid {
 	/// Map links
 	LocalVector<NavLink *> links;
 	LocalVector<gd::Polygon> link_polygons;
+	/// Number of `link_polygons` connected by the last synchronization.
+	uint32_t link_polygon_count = 0;
 
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
+	/// Where the polygons and free edges of each region were placed by the last synchronization.
+	struct RegionSyncState {
+		uint32_t first_polygon = 0;
+		uint32_t polygon_count = 0;
+		uint64_t polygons_revision = 0;
+		uint32_t first_free_edge = 0;
+		uint32_t free_edge_count = 0;
+		uint32_t free_edges_hash = 0;
+	};
+	HashMap<const NavRegion *, RegionSyncState> region_sync_states;
+
+	/// Key of two regions, `a` being the one with the lowest address.
+	struct RegionPairKey {
+		const NavRegion *a = nullptr;
+		const NavRegion *b = nullptr;
+
+		static uint32_t hash(const RegionPairKey &p_key) {
+			return hash_murmur3_one_64(uint64_t(p_key.b), hash_murmur3_one_64(uint64_t(p_key.a)));
+		}
+
+		bool operator==(const RegionPairKey &p_key) const {
+			return a == p_key.a && b == p_key.b;
+		}
+	};
+
+	/// Edge connection between the free edges of two regions, polygons being referenced by their index in their region.
+	struct RegionPairConnection {
+		bool from_a = true;
+		uint32_t from_polygon = 0;
+		uint32_t from_edge = 0;
+		uint32_t to_polygon = 0;
+		uint32_t to_edge = 0;
+		Vector3 pathway_start;
+		Vector3 pathway_end;
+	};
+
+	/// Edge connections of two neighbor regions, reused as long as neither region nor their free edges changed.
+	struct RegionPairConnections {
+		uint64_t polygons_revision_a = 0;
+		uint64_t polygons_revision_b = 0;
+		uint32_t free_edges_hash_a = 0;
+		uint32_t free_edges_hash_b = 0;
+		/// Map update id of the last synchronization that used these connections.
+		uint32_t sync_id = 0;
+		LocalVector<RegionPairConnection> connections;
+	};
+	HashMap<RegionPairKey, RegionPairConnections, RegionPairKey> region_pair_connections;
+
+	/// Path search state, kept per thread so queries neither allocate nor clear it.
+	struct PathQueryScratch {
+		LocalVector<gd::NavigationPoly> navigation_polys;
+		gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostLessThan, gd::NavPolyHeapIndexer> traversable_polys;
+		/// Clusters of the map hierarchy the search is restricted to.
+		LocalVector<uint8_t> corridor;
+		uint32_t generation = 0;
+
+		uint32_t next_generation();
+	};
+	static thread_local PathQueryScratch path_query_scratch;
+
+	/// Spatial index over `polygons` for the closest point queries.
+	NavPolygonBVH polygon_bvh;
+
+	/// Coarse region level graph used to narrow down long path searches.
+	bool use_hierarchical_pathfinding = false;
+	NavMapHierarchy hierarchy;
+
+	/// Flow fields computed over this map.
+	LocalVector<NavFlowField *> flow_fields;
+	/// Reversed polygon connections shared by the flow fields, valid for `flow_field_graph_map_update_id`.
+	NavFlowFieldGraph flow_field_graph;
+	uint32_t flow_field_graph_map_update_id = 0;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
 
+	/// Agent kd-tree subtrees smaller than this are not worth a separate build task.
+	static constexpr size_t RVO_AGENT_SUBTREE_MIN_SIZE = 256;
+
 	/// avoidance controlled agents
 	LocalVector<NavAgent *> active_2d_avoidance_agents;
 	LocalVector<NavAgent *> active_3d_avoidance_agents;
@@ -156,6 +237,7 @@ public:
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
 	gd::ClosestPointQueryResult get_closest_point_info(const Vector3 &p_point) const;
 	RID get_closest_point_owner(const Vector3 &p_point) const;
+	const gd::Polygon *get_closest_polygon(const Vector3 &p_point, uint32_t p_navigation_layers, Vector3 &r_closest_point) const;
 
 	void add_region(NavRegion *p_region);
 	void remove_region(NavRegion *p_region);
@@ -186,6 +268,13 @@ public:
 		return obstacles;
 	}
 
+	bool has_flow_field(NavFlowField *p_flow_field) const;
+	void add_flow_field(NavFlowField *p_flow_field);
+	void remove_flow_field(NavFlowField *p_flow_field);
+	const LocalVector<NavFlowField *> &get_flow_fields() const {
+		return flow_fields;
+	}
+
 	uint32_t get_map_update_id() const {
 		return map_update_id;
 	}
@@ -209,10 +298,19 @@ public:
 private:
 	void compute_single_step(uint32_t index, NavAgent **agent);
 
+	void build_rvo_agent_subtree_2d(uint32_t index, RVO2D::KdTree2D::AgentSubtree2D *subtrees);
+	void build_rvo_agent_subtree_3d(uint32_t index, RVO3D::KdTree3D::AgentSubtree3D *subtrees);
+
+	void compute_single_flow_field(uint32_t index, NavFlowField **flow_field);
+
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
 
+	bool _get_edge_connection_pathway(const gd::Edge::Connection &p_edge, const gd::Edge::Connection &p_other_edge, Vector3 &r_pathway_start, Vector3 &r_pathway_end) const;
+	void _find_region_pair_connections(const gd::Edge::Connection *p_free_edges_a, uint32_t p_free_edge_count_a, const gd::Edge::Connection *p_free_edges_b, uint32_t p_free_edge_count_b, bool p_from_a, uint32_t p_first_polygon_a, uint32_t p_first_polygon_b, LocalVector<RegionPairConnection> &r_connections) const;
+
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
+	void _update_flow_fields();
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
 	void _update_rvo_agents_tree_2d();
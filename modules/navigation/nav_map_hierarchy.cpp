@@ -0,0 +1,373 @@
+/**************************************************************************/
+/*  nav_map_hierarchy.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_map_hierarchy.h"
+
+#include "nav_base.h"
+#include "nav_region.h"
+
+uint32_t NavMapHierarchy::_hash_cluster_portals(const Cluster &p_cluster) const {
+	uint32_t hash = hash_murmur3_one_32(p_cluster.entry_portals.size());
+	for (uint32_t portal_id : p_cluster.entry_portals) {
+		const Portal &portal = portals[portal_id];
+		hash = hash_murmur3_one_real(portal.position.x, hash);
+		hash = hash_murmur3_one_real(portal.position.y, hash);
+		hash = hash_murmur3_one_real(portal.position.z, hash);
+		for (uint32_t polygon_id : portal.to_polygons) {
+			hash = hash_murmur3_one_32(polygon_id - p_cluster.first_polygon, hash);
+		}
+	}
+	hash = hash_murmur3_one_32(p_cluster.exit_portals.size(), hash);
+	for (uint32_t portal_id : p_cluster.exit_portals) {
+		const Portal &portal = portals[portal_id];
+		hash = hash_murmur3_one_real(portal.position.x, hash);
+		hash = hash_murmur3_one_real(portal.position.y, hash);
+		hash = hash_murmur3_one_real(portal.position.z, hash);
+		for (uint32_t polygon_id : portal.from_polygons) {
+			hash = hash_murmur3_one_32(polygon_id - p_cluster.first_polygon, hash);
+		}
+	}
+	return hash_fmix32(hash);
+}
+
+void NavMapHierarchy::_compute_cluster_costs(uint32_t p_cluster_id, const LocalVector<const gd::Polygon *> &p_polygons, LocalVector<SearchNode> &r_nodes, uint32_t &r_generation) {
+	Cluster &cluster = clusters[p_cluster_id];
+	const uint32_t exit_count = cluster.exit_portals.size();
+	cluster.costs.resize(cluster.entry_portals.size() * exit_count);
+
+	SearchHeap open_nodes;
+
+	// One Dijkstra search over the polygons of the cluster for each entry portal.
+	for (uint32_t entry_index = 0; entry_index < cluster.entry_portals.size(); entry_index++) {
+		const Portal &entry = portals[cluster.entry_portals[entry_index]];
+		const uint32_t generation = ++r_generation;
+
+		for (uint32_t polygon_id : entry.to_polygons) {
+			SearchNode &node = r_nodes[polygon_id];
+			const real_t cost = entry.position.distance_to(p_polygons[polygon_id]->center);
+			if (node.search_generation != generation) {
+				node = SearchNode();
+				node.id = polygon_id;
+				node.search_generation = generation;
+				node.cost = cost;
+				node.total_cost = cost;
+				open_nodes.push(&node);
+			} else if (cost < node.cost) {
+				node.cost = cost;
+				node.total_cost = cost;
+				open_nodes.shift(node.heap_index);
+			}
+		}
+
+		while (!open_nodes.is_empty()) {
+			const SearchNode *node = open_nodes.pop();
+			const gd::Polygon *polygon = p_polygons[node->id];
+
+			for (const gd::Edge &edge : polygon->edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					const uint32_t neighbor_id = connection.polygon->id;
+					if (polygon_clusters[neighbor_id] != p_cluster_id) {
+						continue;
+					}
+
+					SearchNode &neighbor = r_nodes[neighbor_id];
+					const real_t cost = node->cost + polygon->center.distance_to(connection.polygon->center);
+					if (neighbor.search_generation != generation) {
+						neighbor = SearchNode();
+						neighbor.id = neighbor_id;
+						neighbor.search_generation = generation;
+						neighbor.cost = cost;
+						neighbor.total_cost = cost;
+						open_nodes.push(&neighbor);
+					} else if (cost < neighbor.cost && neighbor.heap_index != SearchHeap::INVALID_INDEX) {
+						neighbor.cost = cost;
+						neighbor.total_cost = cost;
+						open_nodes.shift(neighbor.heap_index);
+					}
+				}
+			}
+		}
+
+		for (uint32_t exit_index = 0; exit_index < exit_count; exit_index++) {
+			const Portal &exit = portals[cluster.exit_portals[exit_index]];
+			real_t cost = FLT_MAX;
+			for (uint32_t polygon_id : exit.from_polygons) {
+				const SearchNode &node = r_nodes[polygon_id];
+				if (node.search_generation == generation) {
+					cost = MIN(cost, node.cost + p_polygons[polygon_id]->center.distance_to(exit.position));
+				}
+			}
+			cluster.costs[entry_index * exit_count + exit_index] = cost;
+		}
+	}
+}
+
+void NavMapHierarchy::build(const LocalVector<gd::Polygon> &p_polygons, const LocalVector<gd::Polygon> &p_link_polygons, uint32_t p_link_polygon_count) {
+	clusters.clear();
+	portals.clear();
+	pm_rebuilt_cluster_count = 0;
+
+	// Gather all polygons by id, the link polygons follow the region ones.
+	const uint32_t polygon_count = p_polygons.size() + p_link_polygon_count;
+	LocalVector<const gd::Polygon *> polygons;
+	polygons.resize(polygon_count);
+	polygon_clusters.resize(polygon_count);
+
+	// Every region and every link is a cluster.
+	HashMap<const NavBase *, uint32_t> owner_clusters;
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const gd::Polygon *polygon = polygon_id < p_polygons.size() ? &p_polygons[polygon_id] : &p_link_polygons[polygon_id - p_polygons.size()];
+		ERR_FAIL_COND_MSG(polygon->id != polygon_id, "Navigation map polygons are not indexed by their id.");
+		polygons[polygon_id] = polygon;
+
+		uint32_t cluster_id;
+		HashMap<const NavBase *, uint32_t>::Iterator E = owner_clusters.find(polygon->owner);
+		if (E) {
+			cluster_id = E->value;
+		} else {
+			cluster_id = clusters.size();
+			owner_clusters.insert(polygon->owner, cluster_id);
+			clusters.push_back(Cluster());
+			clusters[cluster_id].owner = polygon->owner;
+			clusters[cluster_id].first_polygon = polygon_id;
+		}
+		polygon_clusters[polygon_id] = cluster_id;
+	}
+
+	// Merge all connections between two clusters into a single portal.
+	HashMap<uint64_t, uint32_t> cluster_pair_portals;
+	LocalVector<uint32_t> portal_connection_counts;
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const uint32_t from_cluster = polygon_clusters[polygon_id];
+
+		for (const gd::Edge &edge : polygons[polygon_id]->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t to_cluster = polygon_clusters[connection.polygon->id];
+				if (to_cluster == from_cluster) {
+					continue;
+				}
+
+				const uint64_t pair = (uint64_t(from_cluster) << 32) | to_cluster;
+				uint32_t portal_id;
+				HashMap<uint64_t, uint32_t>::Iterator E = cluster_pair_portals.find(pair);
+				if (E) {
+					portal_id = E->value;
+				} else {
+					portal_id = portals.size();
+					cluster_pair_portals.insert(pair, portal_id);
+					portals.push_back(Portal());
+					portal_connection_counts.push_back(0);
+
+					Portal &portal = portals[portal_id];
+					portal.from_cluster = from_cluster;
+					portal.to_cluster = to_cluster;
+					portal.exit_index = clusters[from_cluster].exit_portals.size();
+					portal.entry_index = clusters[to_cluster].entry_portals.size();
+					clusters[from_cluster].exit_portals.push_back(portal_id);
+					clusters[to_cluster].entry_portals.push_back(portal_id);
+				}
+
+				Portal &portal = portals[portal_id];
+				portal.position += (connection.pathway_start + connection.pathway_end) * 0.5;
+				portal.from_polygons.push_back(polygon_id);
+				portal.to_polygons.push_back(connection.polygon->id);
+				portal_connection_counts[portal_id]++;
+			}
+		}
+	}
+	for (uint32_t portal_id = 0; portal_id < portals.size(); portal_id++) {
+		portals[portal_id].position /= real_t(portal_connection_counts[portal_id]);
+	}
+
+	// Compute the costs between the portals of each cluster, unless the region and its portals did not change.
+	LocalVector<SearchNode> nodes;
+	nodes.resize(polygon_count);
+	uint32_t generation = 0;
+	for (uint32_t cluster_id = 0; cluster_id < clusters.size(); cluster_id++) {
+		Cluster &cluster = clusters[cluster_id];
+		if (cluster.owner->get_type() != NavigationUtilities::PathSegmentType::PATH_SEGMENT_TYPE_REGION) {
+			// Links are a single polygon, there is nothing worth caching.
+			_compute_cluster_costs(cluster_id, polygons, nodes, generation);
+			continue;
+		}
+
+		const uint64_t polygons_revision = static_cast<const NavRegion *>(cluster.owner)->get_polygons_revision();
+		const uint32_t portals_hash = _hash_cluster_portals(cluster);
+
+		ClusterCostCache *cache = cost_cache.getptr(cluster.owner);
+		if (cache && cache->polygons_revision == polygons_revision && cache->portals_hash == portals_hash) {
+			cluster.costs = cache->costs;
+			continue;
+		}
+
+		_compute_cluster_costs(cluster_id, polygons, nodes, generation);
+		pm_rebuilt_cluster_count++;
+
+		if (!cache) {
+			cache = &cost_cache.insert(cluster.owner, ClusterCostCache())->value;
+		}
+		cache->polygons_revision = polygons_revision;
+		cache->portals_hash = portals_hash;
+		cache->costs = cluster.costs;
+	}
+
+	// Forget the regions that are no longer part of the map.
+	LocalVector<const NavBase *> removed_owners;
+	for (const KeyValue<const NavBase *, ClusterCostCache> &E : cost_cache) {
+		if (!owner_clusters.has(E.key)) {
+			removed_owners.push_back(E.key);
+		}
+	}
+	for (const NavBase *owner : removed_owners) {
+		cost_cache.erase(owner);
+	}
+
+	// The polygons are only needed to compute the costs.
+	for (Portal &portal : portals) {
+		portal.from_polygons.clear();
+		portal.to_polygons.clear();
+	}
+}
+
+void NavMapHierarchy::clear() {
+	clusters.clear();
+	portals.clear();
+	polygon_clusters.clear();
+	cost_cache.clear();
+	pm_rebuilt_cluster_count = 0;
+}
+
+bool NavMapHierarchy::find_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const {
+	const uint32_t begin_cluster = polygon_clusters[p_begin_poly->id];
+	const uint32_t end_cluster = polygon_clusters[p_end_poly->id];
+
+	r_corridor.resize(clusters.size());
+	for (uint8_t &in_corridor : r_corridor) {
+		in_corridor = 0;
+	}
+	r_corridor[begin_cluster] = 1;
+	r_corridor[end_cluster] = 1;
+
+	if (begin_cluster == end_cluster) {
+		return true;
+	}
+
+	// This is an implementation of the A* algorithm over the portals,
+	// the begin point reaches the exits of its cluster in a straight line.
+	const uint32_t generation = 1;
+	LocalVector<SearchNode> nodes;
+	nodes.resize(portals.size());
+	SearchHeap open_nodes;
+
+	const Cluster &begin = clusters[begin_cluster];
+	for (uint32_t portal_id : begin.exit_portals) {
+		const Portal &portal = portals[portal_id];
+		if ((p_navigation_layers & clusters[portal.to_cluster].owner->get_navigation_layers()) == 0) {
+			continue;
+		}
+
+		SearchNode &node = nodes[portal_id];
+		node.id = portal_id;
+		node.search_generation = generation;
+		node.cost = p_begin_point.distance_to(portal.position) * begin.owner->get_travel_cost();
+		node.total_cost = node.cost + portal.position.distance_to(p_end_point);
+		open_nodes.push(&node);
+	}
+
+	uint32_t best_portal = UINT32_MAX;
+	real_t best_cost = FLT_MAX;
+	while (!open_nodes.is_empty()) {
+		const SearchNode *node = open_nodes.pop();
+		if (node->total_cost >= best_cost) {
+			break;
+		}
+
+		const Portal &portal = portals[node->id];
+		const Cluster &cluster = clusters[portal.to_cluster];
+		const real_t travel_cost = cluster.owner->get_travel_cost();
+
+		// The end point is reached in a straight line from the entries of its cluster.
+		if (portal.to_cluster == end_cluster) {
+			const real_t cost = node->cost + portal.position.distance_to(p_end_point) * travel_cost;
+			if (cost < best_cost) {
+				best_cost = cost;
+				best_portal = node->id;
+			}
+			continue;
+		}
+
+		const uint32_t exit_count = cluster.exit_portals.size();
+		for (uint32_t exit_index = 0; exit_index < exit_count; exit_index++) {
+			const real_t intra_cost = cluster.costs[portal.entry_index * exit_count + exit_index];
+			if (intra_cost == FLT_MAX) {
+				continue;
+			}
+
+			const uint32_t next_id = cluster.exit_portals[exit_index];
+			const Portal &next = portals[next_id];
+			if ((p_navigation_layers & clusters[next.to_cluster].owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			const real_t cost = node->cost + intra_cost * travel_cost + cluster.owner->get_enter_cost();
+			SearchNode &next_node = nodes[next_id];
+			if (next_node.search_generation == generation) {
+				if (cost < next_node.cost) {
+					next_node.back_id = node->id;
+					next_node.total_cost += cost - next_node.cost;
+					next_node.cost = cost;
+					if (next_node.heap_index != SearchHeap::INVALID_INDEX) {
+						open_nodes.shift(next_node.heap_index);
+					} else {
+						open_nodes.push(&next_node);
+					}
+				}
+			} else {
+				next_node.id = next_id;
+				next_node.back_id = node->id;
+				next_node.search_generation = generation;
+				next_node.cost = cost;
+				next_node.total_cost = cost + next.position.distance_to(p_end_point);
+				open_nodes.push(&next_node);
+			}
+		}
+	}
+
+	if (best_portal == UINT32_MAX) {
+		return false;
+	}
+
+	// Travel the path backwards and flag the clusters it crosses.
+	for (uint32_t portal_id = best_portal; portal_id != UINT32_MAX; portal_id = nodes[portal_id].back_id) {
+		r_corridor[portals[portal_id].from_cluster] = 1;
+		r_corridor[portals[portal_id].to_cluster] = 1;
+	}
+	return true;
+}
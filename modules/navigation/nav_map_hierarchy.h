@@ -0,0 +1,134 @@
+/**************************************************************************/
+/*  nav_map_hierarchy.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_MAP_HIERARCHY_H
+#define NAV_MAP_HIERARCHY_H
+
+#include "nav_utils.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+/// Coarse abstraction of a map used to speed up long path queries.
+///
+/// Every region and link is a cluster. Two clusters with connected polygons
+/// share a portal, and the travel distances between the portals of a cluster
+/// are cached so that a query can first find the clusters to cross on this
+/// small graph and then only search the polygons of those clusters.
+class NavMapHierarchy {
+	struct Portal {
+		/// Cluster the portal leaves from.
+		uint32_t from_cluster = 0;
+		/// Cluster the portal leads into.
+		uint32_t to_cluster = 0;
+		/// Average of the pathway midpoints of all the connections making up the portal.
+		Vector3 position;
+
+		/// Index of this portal in the exits of `from_cluster` and the entries of `to_cluster`.
+		uint32_t exit_index = 0;
+		uint32_t entry_index = 0;
+
+		/// Polygons on both sides of the portal, only used while building.
+		LocalVector<uint32_t> from_polygons;
+		LocalVector<uint32_t> to_polygons;
+	};
+
+	struct Cluster {
+		const NavBase *owner = nullptr;
+		uint32_t first_polygon = 0;
+
+		LocalVector<uint32_t> entry_portals;
+		LocalVector<uint32_t> exit_portals;
+
+		/// Travel distances from every entry to every exit portal, `FLT_MAX` when there is no way through.
+		LocalVector<real_t> costs;
+	};
+
+	/// Portal costs of a region, kept as long as neither the region nor its portals change.
+	struct ClusterCostCache {
+		uint64_t polygons_revision = 0;
+		uint32_t portals_hash = 0;
+		LocalVector<real_t> costs;
+	};
+
+	struct SearchNode {
+		uint32_t id = 0;
+		uint32_t back_id = UINT32_MAX;
+		real_t cost = 0.0;
+		real_t total_cost = 0.0;
+		uint32_t search_generation = 0;
+		uint32_t heap_index = UINT32_MAX;
+	};
+
+	struct SearchNodeLessThan {
+		_FORCE_INLINE_ bool operator()(const SearchNode *p_node_a, const SearchNode *p_node_b) const {
+			return p_node_a->total_cost < p_node_b->total_cost;
+		}
+	};
+
+	struct SearchNodeHeapIndexer {
+		_FORCE_INLINE_ void operator()(SearchNode *p_node, uint32_t p_heap_index) const {
+			p_node->heap_index = p_heap_index;
+		}
+	};
+
+	typedef gd::Heap<SearchNode *, SearchNodeLessThan, SearchNodeHeapIndexer> SearchHeap;
+
+	LocalVector<Cluster> clusters;
+	LocalVector<Portal> portals;
+	/// Cluster of every polygon of the map, indexed by polygon id.
+	LocalVector<uint32_t> polygon_clusters;
+
+	HashMap<const NavBase *, ClusterCostCache> cost_cache;
+
+	uint32_t pm_rebuilt_cluster_count = 0;
+
+	uint32_t _hash_cluster_portals(const Cluster &p_cluster) const;
+	void _compute_cluster_costs(uint32_t p_cluster_id, const LocalVector<const gd::Polygon *> &p_polygons, LocalVector<SearchNode> &r_nodes, uint32_t &r_generation);
+
+public:
+	/// Rebuilds the abstraction after the map polygons and their connections changed.
+	/// Portal costs of regions that did not change are taken over from the previous build.
+	void build(const LocalVector<gd::Polygon> &p_polygons, const LocalVector<gd::Polygon> &p_link_polygons, uint32_t p_link_polygon_count);
+	void clear();
+
+	bool is_empty() const { return clusters.is_empty(); }
+	uint32_t get_cluster_count() const { return clusters.size(); }
+	uint32_t get_polygon_cluster(uint32_t p_polygon_id) const { return polygon_clusters[p_polygon_id]; }
+
+	/// Number of clusters whose portal costs had to be computed by the last build.
+	uint32_t get_rebuilt_cluster_count() const { return pm_rebuilt_cluster_count; }
+
+	/// Solves the query on the portal graph and flags, in `r_corridor`, the clusters the path crosses.
+	/// Returns false when the clusters of the begin and end points are not connected.
+	bool find_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const;
+};
+
+#endif // NAV_MAP_HIERARCHY_H
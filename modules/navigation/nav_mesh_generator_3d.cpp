@@ -33,6 +33,7 @@
 #include "nav_mesh_generator_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/core_string_names.h"
 #include "core/math/convex_hull.h"
 #include "core/os/thread.h"
 #include "scene/3d/mesh_instance_3d.h"
@@ -70,6 +71,8 @@ bool NavMeshGenerator3D::baking_use_multiple_threads = true;
 bool NavMeshGenerator3D::baking_use_high_priority_threads = true;
 HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
+Mutex NavMeshGenerator3D::mesh_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::NavMeshGeneratorMeshCache3D> NavMeshGenerator3D::mesh_cache;
 
 NavMeshGenerator3D *NavMeshGenerator3D::get_singleton() {
 	return singleton;
@@ -131,6 +134,10 @@ void NavMeshGenerator3D::cleanup() {
 
 	baking_navmeshes.clear();
 
+	mesh_cache_mutex.lock();
+	mesh_cache.clear();
+	mesh_cache_mutex.unlock();
+
 	for (KeyValue<WorkerThreadPool::TaskID, NavMeshGeneratorTask3D *> &E : generator_tasks) {
 		WorkerThreadPool::get_singleton()->wait_for_task_completion(E.key);
 		NavMeshGeneratorTask3D *generator_task = E.value;
@@ -228,33 +235,92 @@ void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh
 	generator_task_mutex.unlock();
 }
 
+void NavMeshGenerator3D::bake_tile_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Vector2i &p_tile, const Callable &p_callback) {
+	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
+	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
+	ERR_FAIL_COND_MSG(p_navigation_mesh->get_tile_size() <= 0.0f, "Baking a single tile requires a NavigationMesh with a tile_size greater than 0.");
+
+	baking_navmesh_mutex.lock();
+	if (baking_navmeshes.has(p_navigation_mesh)) {
+		baking_navmesh_mutex.unlock();
+		ERR_FAIL_MSG("NavigationMesh is already baking. Wait for current bake to finish.");
+	}
+	baking_navmeshes.insert(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	generator_bake_tile_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_tile);
+
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.erase(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	if (p_callback.is_valid()) {
+		generator_emit_callback(p_callback);
+	}
+}
+
+void NavMeshGenerator3D::bake_tile_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Vector2i &p_tile, const Callable &p_callback) {
+	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
+	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
+	ERR_FAIL_COND_MSG(p_navigation_mesh->get_tile_size() <= 0.0f, "Baking a single tile requires a NavigationMesh with a tile_size greater than 0.");
+
+	if (!use_threads) {
+		bake_tile_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_tile, p_callback);
+		return;
+	}
+
+	baking_navmesh_mutex.lock();
+	if (baking_navmeshes.has(p_navigation_mesh)) {
+		baking_navmesh_mutex.unlock();
+		ERR_FAIL_MSG("NavigationMesh is already baking. Wait for current bake to finish.");
+	}
+	baking_navmeshes.insert(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	generator_task_mutex.lock();
+	NavMeshGeneratorTask3D *generator_task = memnew(NavMeshGeneratorTask3D);
+	generator_task->navigation_mesh = p_navigation_mesh;
+	generator_task->source_geometry_data = p_source_geometry_data;
+	generator_task->callback = p_callback;
+	generator_task->bake_tile = true;
+	generator_task->tile = p_tile;
+	generator_task->status = NavMeshGeneratorTask3D::TaskStatus::BAKING_STARTED;
+	generator_task->thread_task_id = WorkerThreadPool::get_singleton()->add_native_task(&NavMeshGenerator3D::generator_thread_bake, generator_task, NavMeshGenerator3D::baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTile3D"));
+	generator_tasks.insert(generator_task->thread_task_id, generator_task);
+	generator_task_mutex.unlock();
+}
+
 void NavMeshGenerator3D::generator_thread_bake(void *p_arg) {
 	NavMeshGeneratorTask3D *generator_task = static_cast<NavMeshGeneratorTask3D *>(p_arg);
 
-	generator_bake_from_source_geometry_data(generator_task->navigation_mesh, generator_task->source_geometry_data);
+	if (generator_task->bake_tile) {
+		generator_bake_tile_from_source_geometry_data(generator_task->navigation_mesh, generator_task->source_geometry_data, generator_task->tile);
+	} else {
+		generator_bake_from_source_geometry_data(generator_task->navigation_mesh, generator_task->source_geometry_data);
+	}
 
 	generator_task->status = NavMeshGeneratorTask3D::TaskStatus::BAKING_FINISHED;
 }
 
-void NavMeshGenerator3D::generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children) {
-	generator_parse_meshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_multimeshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_staticbody3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
+void NavMeshGenerator3D::generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node, bool p_recurse_children) {
+	generator_parse_meshinstance3d_node(p_navigation_mesh, r_parse_state, p_node);
+	generator_parse_multimeshinstance3d_node(p_navigation_mesh, r_parse_state, p_node);
+	generator_parse_staticbody3d_node(p_navigation_mesh, r_parse_state, p_node);
 #ifdef MODULE_CSG_ENABLED
-	generator_parse_csgshape3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
+	generator_parse_csgshape3d_node(p_navigation_mesh, r_parse_state, p_node);
 #endif
 #ifdef MODULE_GRIDMAP_ENABLED
-	generator_parse_gridmap_node(p_navigation_mesh, p_source_geometry_data, p_node);
+	generator_parse_gridmap_node(p_navigation_mesh, r_parse_state, p_node);
 #endif
 
 	if (p_recurse_children) {
 		for (int i = 0; i < p_node->get_child_count(); i++) {
-			generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, p_node->get_child(i), p_recurse_children);
+			generator_parse_geometry_node(p_navigation_mesh, r_parse_state, p_node->get_child(i), p_recurse_children);
 		}
 	}
 }
 
-void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node) {
 	MeshInstance3D *mesh_instance = Object::cast_to<MeshInstance3D>(p_node);
 
 	if (mesh_instance) {
@@ -263,13 +329,13 @@ void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<Navigatio
 		if (parsed_geometry_type == NavigationMesh::PARSED_GEOMETRY_MESH_INSTANCES || parsed_geometry_type == NavigationMesh::PARSED_GEOMETRY_BOTH) {
 			Ref<Mesh> mesh = mesh_instance->get_mesh();
 			if (mesh.is_valid()) {
-				p_source_geometry_data->add_mesh(mesh, mesh_instance->get_global_transform());
+				generator_add_mesh(r_parse_state, mesh, mesh_instance->get_global_transform());
 			}
 		}
 	}
 }
 
-void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node) {
 	MultiMeshInstance3D *multimesh_instance = Object::cast_to<MultiMeshInstance3D>(p_node);
 
 	if (multimesh_instance) {
@@ -285,7 +351,7 @@ void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<Navi
 						n = multimesh->get_instance_count();
 					}
 					for (int i = 0; i < n; i++) {
-						p_source_geometry_data->add_mesh(mesh, multimesh_instance->get_global_transform() * multimesh->get_instance_transform(i));
+						generator_add_mesh(r_parse_state, mesh, multimesh_instance->get_global_transform() * multimesh->get_instance_transform(i));
 					}
 				}
 			}
@@ -293,7 +359,7 @@ void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<Navi
 	}
 }
 
-void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node) {
 	StaticBody3D *static_body = Object::cast_to<StaticBody3D>(p_node);
 
 	if (static_body) {
@@ -321,7 +387,7 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 						Array arr;
 						arr.resize(RS::ARRAY_MAX);
 						BoxMesh::create_mesh_array(arr, box->get_size());
-						p_source_geometry_data->add_mesh_array(arr, transform);
+						generator_add_mesh_array(r_parse_state, arr, transform);
 					}
 
 					CapsuleShape3D *capsule = Object::cast_to<CapsuleShape3D>(*s);
@@ -329,7 +395,7 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 						Array arr;
 						arr.resize(RS::ARRAY_MAX);
 						CapsuleMesh::create_mesh_array(arr, capsule->get_radius(), capsule->get_height());
-						p_source_geometry_data->add_mesh_array(arr, transform);
+						generator_add_mesh_array(r_parse_state, arr, transform);
 					}
 
 					CylinderShape3D *cylinder = Object::cast_to<CylinderShape3D>(*s);
@@ -337,7 +403,7 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 						Array arr;
 						arr.resize(RS::ARRAY_MAX);
 						CylinderMesh::create_mesh_array(arr, cylinder->get_radius(), cylinder->get_radius(), cylinder->get_height());
-						p_source_geometry_data->add_mesh_array(arr, transform);
+						generator_add_mesh_array(r_parse_state, arr, transform);
 					}
 
 					SphereShape3D *sphere = Object::cast_to<SphereShape3D>(*s);
@@ -345,12 +411,12 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 						Array arr;
 						arr.resize(RS::ARRAY_MAX);
 						SphereMesh::create_mesh_array(arr, sphere->get_radius(), sphere->get_radius() * 2.0);
-						p_source_geometry_data->add_mesh_array(arr, transform);
+						generator_add_mesh_array(r_parse_state, arr, transform);
 					}
 
 					ConcavePolygonShape3D *concave_polygon = Object::cast_to<ConcavePolygonShape3D>(*s);
 					if (concave_polygon) {
-						p_source_geometry_data->add_faces(concave_polygon->get_faces(), transform);
+						generator_add_faces(r_parse_state, concave_polygon->get_faces(), transform);
 					}
 
 					ConvexPolygonShape3D *convex_polygon = Object::cast_to<ConvexPolygonShape3D>(*s);
@@ -371,7 +437,7 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 								}
 							}
 
-							p_source_geometry_data->add_faces(faces, transform);
+							generator_add_faces(r_parse_state, faces, transform);
 						}
 					}
 
@@ -404,7 +470,7 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 								}
 							}
 							if (vertex_array.size() > 0) {
-								p_source_geometry_data->add_faces(vertex_array, transform);
+								generator_add_faces(r_parse_state, vertex_array, transform);
 							}
 						}
 					}
@@ -415,7 +481,7 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 }
 
 #ifdef MODULE_CSG_ENABLED
-void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node) {
 	CSGShape3D *csgshape3d = Object::cast_to<CSGShape3D>(p_node);
 
 	if (csgshape3d) {
@@ -428,7 +494,7 @@ void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMes
 			if (!meshes.is_empty()) {
 				Ref<Mesh> mesh = meshes[1];
 				if (mesh.is_valid()) {
-					p_source_geometry_data->add_mesh(mesh, csg_shape->get_global_transform());
+					generator_add_mesh(r_parse_state, mesh, csg_shape->get_global_transform());
 				}
 			}
 		}
@@ -437,7 +503,7 @@ void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMes
 #endif // MODULE_CSG_ENABLED
 
 #ifdef MODULE_GRIDMAP_ENABLED
-void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node) {
 	GridMap *gridmap = Object::cast_to<GridMap>(p_node);
 
 	if (gridmap) {
@@ -450,7 +516,7 @@ void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh>
 			for (int i = 0; i < meshes.size(); i += 2) {
 				Ref<Mesh> mesh = meshes[i + 1];
 				if (mesh.is_valid()) {
-					p_source_geometry_data->add_mesh(mesh, xform * (Transform3D)meshes[i]);
+					generator_add_mesh(r_parse_state, mesh, xform * (Transform3D)meshes[i]);
 				}
 			}
 		}
@@ -468,14 +534,14 @@ void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh>
 						Array arr;
 						arr.resize(RS::ARRAY_MAX);
 						SphereMesh::create_mesh_array(arr, radius, radius * 2.0);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
+						generator_add_mesh_array(r_parse_state, arr, shapes[i]);
 					} break;
 					case PhysicsServer3D::SHAPE_BOX: {
 						Vector3 extents = data;
 						Array arr;
 						arr.resize(RS::ARRAY_MAX);
 						BoxMesh::create_mesh_array(arr, extents * 2.0);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
+						generator_add_mesh_array(r_parse_state, arr, shapes[i]);
 					} break;
 					case PhysicsServer3D::SHAPE_CAPSULE: {
 						Dictionary dict = data;
@@ -484,7 +550,7 @@ void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh>
 						Array arr;
 						arr.resize(RS::ARRAY_MAX);
 						CapsuleMesh::create_mesh_array(arr, radius, height);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
+						generator_add_mesh_array(r_parse_state, arr, shapes[i]);
 					} break;
 					case PhysicsServer3D::SHAPE_CYLINDER: {
 						Dictionary dict = data;
@@ -493,7 +559,7 @@ void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh>
 						Array arr;
 						arr.resize(RS::ARRAY_MAX);
 						CylinderMesh::create_mesh_array(arr, radius, radius, height);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
+						generator_add_mesh_array(r_parse_state, arr, shapes[i]);
 					} break;
 					case PhysicsServer3D::SHAPE_CONVEX_POLYGON: {
 						PackedVector3Array vertices = data;
@@ -512,13 +578,13 @@ void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh>
 								}
 							}
 
-							p_source_geometry_data->add_faces(faces, shapes[i]);
+							generator_add_faces(r_parse_state, faces, shapes[i]);
 						}
 					} break;
 					case PhysicsServer3D::SHAPE_CONCAVE_POLYGON: {
 						Dictionary dict = data;
 						PackedVector3Array faces = Variant(dict["faces"]);
-						p_source_geometry_data->add_faces(faces, shapes[i]);
+						generator_add_faces(r_parse_state, faces, shapes[i]);
 					} break;
 					case PhysicsServer3D::SHAPE_HEIGHTMAP: {
 						Dictionary dict = data;
@@ -550,7 +616,7 @@ void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh>
 								}
 							}
 							if (vertex_array.size() > 0) {
-								p_source_geometry_data->add_faces(vertex_array, shapes[i]);
+								generator_add_faces(r_parse_state, vertex_array, shapes[i]);
 							}
 						}
 					} break;
@@ -583,44 +649,216 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 
 	bool recurse_children = p_navigation_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
 
+	// Gather the local geometry of all nodes on the main thread, the transforms are applied afterwards.
+	NavMeshGeneratorParseState3D parse_state;
+	parse_state.root_node_transform = root_node_transform;
+
 	for (Node *parse_node : parse_nodes) {
-		generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, parse_node, recurse_children);
+		generator_parse_geometry_node(p_navigation_mesh, parse_state, parse_node, recurse_children);
+	}
+
+	int vertex_count = 0;
+	int index_count = 0;
+	for (NavMeshGeneratorParsedGeometry3D &geometry : parse_state.geometries) {
+		geometry.vertex_offset = vertex_count;
+		geometry.index_offset = index_count;
+		vertex_count += geometry.vertices.size();
+		index_count += geometry.indices.size();
 	}
+
+	Vector<float> vertices;
+	vertices.resize(vertex_count * 3);
+	Vector<int> indices;
+	indices.resize(index_count);
+	parse_state.vertices_ptrw = vertices.ptrw();
+	parse_state.indices_ptrw = indices.ptrw();
+
+	if (baking_use_multiple_threads && parse_state.geometries.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_thread_transform_geometry, &parse_state, parse_state.geometries.size(), -1, true, SNAME("NavMeshGeneratorParse3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < parse_state.geometries.size(); i++) {
+			generator_thread_transform_geometry(&parse_state, i);
+		}
+	}
+
+	p_source_geometry_data->set_vertices(vertices);
+	p_source_geometry_data->set_indices(indices);
+
+	// Drop the cached geometry of meshes that no longer exist.
+	mesh_cache_mutex.lock();
+	LocalVector<ObjectID> freed_mesh_ids;
+	for (const KeyValue<ObjectID, NavMeshGeneratorMeshCache3D> &E : mesh_cache) {
+		if (!ObjectDB::get_instance(E.key)) {
+			freed_mesh_ids.push_back(E.key);
+		}
+	}
+	for (const ObjectID &mesh_id : freed_mesh_ids) {
+		mesh_cache.erase(mesh_id);
+	}
+	mesh_cache_mutex.unlock();
 };
 
-void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) {
-	if (p_navigation_mesh.is_null() || p_source_geometry_data.is_null()) {
+void NavMeshGenerator3D::generator_thread_transform_geometry(void *p_arg, uint32_t p_index) {
+	NavMeshGeneratorParseState3D *parse_state = static_cast<NavMeshGeneratorParseState3D *>(p_arg);
+	const NavMeshGeneratorParsedGeometry3D &geometry = parse_state->geometries[p_index];
+	const Transform3D xform = parse_state->root_node_transform * geometry.xform;
+
+	const Vector3 *vertices_ptr = geometry.vertices.ptr();
+	float *vertices_ptrw = parse_state->vertices_ptrw + geometry.vertex_offset * 3;
+	const int vertex_count = geometry.vertices.size();
+	for (int i = 0; i < vertex_count; i++) {
+		const Vector3 vertex = xform.xform(vertices_ptr[i]);
+		vertices_ptrw[i * 3 + 0] = vertex.x;
+		vertices_ptrw[i * 3 + 1] = vertex.y;
+		vertices_ptrw[i * 3 + 2] = vertex.z;
+	}
+
+	const int *indices_ptr = geometry.indices.ptr();
+	int *indices_ptrw = parse_state->indices_ptrw + geometry.index_offset;
+	const int index_count = geometry.indices.size();
+	for (int i = 0; i < index_count; i++) {
+		indices_ptrw[i] = indices_ptr[i] + geometry.vertex_offset;
+	}
+}
+
+void NavMeshGenerator3D::generator_on_mesh_changed(ObjectID p_mesh_id) {
+	mesh_cache_mutex.lock();
+	mesh_cache.erase(p_mesh_id);
+	mesh_cache_mutex.unlock();
+}
+
+void NavMeshGenerator3D::generator_get_mesh_geometry(const Ref<Mesh> &p_mesh, Vector<Vector3> &r_vertices, Vector<int> &r_indices) {
+	// Also flushes pending updates of procedural meshes, which invalidate the cache through the changed signal.
+	const int surface_count = p_mesh->get_surface_count();
+	const ObjectID mesh_id = p_mesh->get_instance_id();
+
+	mesh_cache_mutex.lock();
+	const NavMeshGeneratorMeshCache3D *mesh_cache_entry = mesh_cache.getptr(mesh_id);
+	if (mesh_cache_entry) {
+		r_vertices = mesh_cache_entry->vertices;
+		r_indices = mesh_cache_entry->indices;
+		mesh_cache_mutex.unlock();
 		return;
 	}
+	mesh_cache_mutex.unlock();
 
-	const Vector<float> &vertices = p_source_geometry_data->get_vertices();
-	const Vector<int> &indices = p_source_geometry_data->get_indices();
+	r_vertices.clear();
+	r_indices.clear();
 
-	if (vertices.size() < 3 || indices.size() < 3) {
+	for (int i = 0; i < surface_count; i++) {
+		const int current_vertex_count = r_vertices.size();
+
+		if (p_mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+			continue;
+		}
+
+		int index_count = 0;
+		if (p_mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
+			index_count = p_mesh->surface_get_array_index_len(i);
+		} else {
+			index_count = p_mesh->surface_get_array_len(i);
+		}
+
+		ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
+
+		Array a = p_mesh->surface_get_arrays(i);
+		ERR_CONTINUE(a.is_empty() || (a.size() != Mesh::ARRAY_MAX));
+
+		Vector<Vector3> mesh_vertices = a[Mesh::ARRAY_VERTEX];
+		ERR_CONTINUE(mesh_vertices.is_empty());
+
+		if (p_mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
+			Vector<int> mesh_indices = a[Mesh::ARRAY_INDEX];
+			ERR_CONTINUE(mesh_indices.is_empty() || (mesh_indices.size() != index_count));
+			generator_append_triangles(mesh_indices.ptr(), index_count, current_vertex_count, r_indices);
+		} else {
+			ERR_CONTINUE(mesh_vertices.size() != index_count);
+			generator_append_triangles(nullptr, index_count, current_vertex_count, r_indices);
+		}
+		r_vertices.append_array(mesh_vertices);
+	}
+
+	mesh_cache_mutex.lock();
+	NavMeshGeneratorMeshCache3D &new_mesh_cache_entry = mesh_cache[mesh_id];
+	new_mesh_cache_entry.vertices = r_vertices;
+	new_mesh_cache_entry.indices = r_indices;
+	mesh_cache_mutex.unlock();
+
+	Callable mesh_changed = callable_mp_static(&NavMeshGenerator3D::generator_on_mesh_changed).bind(mesh_id);
+	if (!p_mesh->is_connected(CoreStringNames::get_singleton()->changed, mesh_changed)) {
+		p_mesh->connect(CoreStringNames::get_singleton()->changed, mesh_changed, CONNECT_ONE_SHOT);
+	}
+}
+
+void NavMeshGenerator3D::generator_append_triangles(const int *p_indices, int p_index_count, int p_vertex_offset, Vector<int> &r_indices) {
+	const int face_count = p_index_count / 3;
+	const int index_offset = r_indices.size();
+	r_indices.resize(index_offset + face_count * 3);
+	int *indices_ptrw = r_indices.ptrw() + index_offset;
+
+	for (int j = 0; j < face_count; j++) {
+		// CCW
+		indices_ptrw[j * 3 + 0] = p_vertex_offset + (p_indices ? p_indices[j * 3 + 0] : j * 3 + 0);
+		indices_ptrw[j * 3 + 1] = p_vertex_offset + (p_indices ? p_indices[j * 3 + 2] : j * 3 + 2);
+		indices_ptrw[j * 3 + 2] = p_vertex_offset + (p_indices ? p_indices[j * 3 + 1] : j * 3 + 1);
+	}
+}
+
+void NavMeshGenerator3D::generator_add_mesh(NavMeshGeneratorParseState3D &r_parse_state, const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
+	ERR_FAIL_COND(!p_mesh.is_valid());
+
+	NavMeshGeneratorParsedGeometry3D geometry;
+	generator_get_mesh_geometry(p_mesh, geometry.vertices, geometry.indices);
+	if (geometry.indices.is_empty()) {
 		return;
 	}
+	geometry.xform = p_xform;
+	r_parse_state.geometries.push_back(geometry);
+}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
+void NavMeshGenerator3D::generator_add_mesh_array(NavMeshGeneratorParseState3D &r_parse_state, const Array &p_mesh_array, const Transform3D &p_xform) {
+	ERR_FAIL_COND(p_mesh_array.size() != Mesh::ARRAY_MAX);
 
-	// added to keep track of steps, no functionality right now
-	String bake_state = "";
+	Vector<Vector3> mesh_vertices = p_mesh_array[Mesh::ARRAY_VERTEX];
+	ERR_FAIL_COND(mesh_vertices.is_empty());
 
-	bake_state = "Setting up Configuration..."; // step #1
+	Vector<int> mesh_indices = p_mesh_array[Mesh::ARRAY_INDEX];
+	ERR_FAIL_COND(mesh_indices.is_empty());
+
+	NavMeshGeneratorParsedGeometry3D geometry;
+	geometry.vertices = mesh_vertices;
+	generator_append_triangles(mesh_indices.ptr(), mesh_indices.size(), 0, geometry.indices);
+	geometry.xform = p_xform;
+	r_parse_state.geometries.push_back(geometry);
+}
+
+void NavMeshGenerator3D::generator_add_faces(NavMeshGeneratorParseState3D &r_parse_state, const PackedVector3Array &p_faces, const Transform3D &p_xform) {
+	ERR_FAIL_COND(p_faces.is_empty());
+	ERR_FAIL_COND(p_faces.size() % 3 != 0);
+
+	NavMeshGeneratorParsedGeometry3D geometry;
+	geometry.vertices = p_faces;
+	generator_append_triangles(nullptr, p_faces.size(), 0, geometry.indices);
+	geometry.xform = p_xform;
+	r_parse_state.geometries.push_back(geometry);
+}
+
+bool NavMeshGenerator3D::generator_setup_bake(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, rcConfig &r_config) {
+	const Vector<float> &vertices = p_source_geometry_data->get_vertices();
+	const Vector<int> &indices = p_source_geometry_data->get_indices();
+
+	if (vertices.size() < 3 || indices.size() < 3) {
+		return false;
+	}
 
 	const float *verts = vertices.ptr();
 	const int nverts = vertices.size() / 3;
-	const int *tris = indices.ptr();
-	const int ntris = indices.size() / 3;
 
 	float bmin[3], bmax[3];
 	rcCalcBounds(verts, nverts, bmin, bmax);
 
-	rcConfig cfg;
+	rcConfig &cfg = r_config;
 	memset(&cfg, 0, sizeof(cfg));
 
 	cfg.cs = p_navigation_mesh->get_cell_size();
@@ -636,6 +874,13 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	cfg.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
 	cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
 	cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
+	cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs);
+
+	if (p_navigation_mesh->get_tile_size() > 0.0f) {
+		cfg.tileSize = MAX(1, (int)Math::round(p_navigation_mesh->get_tile_size() / cfg.cs));
+		// Tiles need a border wide enough for the agent radius erosion to not shrink the walkable area along the tile edges.
+		cfg.borderSize = MAX(cfg.borderSize, cfg.walkableRadius + 3);
+	}
 
 	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
 		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
@@ -661,6 +906,9 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
 		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
 	}
+	if (cfg.tileSize > 0 && !Math::is_equal_approx((float)cfg.tileSize * cfg.cs, p_navigation_mesh->get_tile_size())) {
+		WARN_PRINT("Property tile_size is rounded to cell_size voxel units and loses precision.");
+	}
 
 	cfg.bmin[0] = bmin[0];
 	cfg.bmin[1] = bmin[1];
@@ -680,9 +928,72 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
 	}
 
+	return true;
+}
+
+void NavMeshGenerator3D::generator_get_tile_bounds(const rcConfig &p_config, const Vector2i &p_tile, float *r_bmin, float *r_bmax) {
+	const float tile_world_size = p_config.tileSize * p_config.cs;
+
+	r_bmin[0] = p_tile.x * tile_world_size;
+	r_bmin[1] = p_config.bmin[1];
+	r_bmin[2] = p_tile.y * tile_world_size;
+	r_bmax[0] = r_bmin[0] + tile_world_size;
+	r_bmax[1] = p_config.bmax[1];
+	r_bmax[2] = r_bmin[2] + tile_world_size;
+
+	// Clip the tiles on the edges of the baked area while staying aligned with the cells of the neighbor tiles.
+	for (int axis : { 0, 2 }) {
+		if (p_config.bmin[axis] > r_bmin[axis]) {
+			r_bmin[axis] += Math::floor((p_config.bmin[axis] - r_bmin[axis]) / p_config.cs) * p_config.cs;
+		}
+		if (p_config.bmax[axis] < r_bmax[axis]) {
+			r_bmax[axis] -= Math::floor((r_bmax[axis] - p_config.bmax[axis]) / p_config.cs) * p_config.cs;
+		}
+	}
+}
+
+bool NavMeshGenerator3D::generator_bake_tile(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_config, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, NavMeshGeneratorTile3D &r_tile) {
+	const Vector<float> &vertices = p_source_geometry_data->get_vertices();
+	const Vector<int> &indices = p_source_geometry_data->get_indices();
+
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+	rcContext ctx;
+
+	// added to keep track of steps, no functionality right now
+	String bake_state = "";
+
+	bake_state = "Setting up Configuration..."; // step #1
+
+	const float *verts = vertices.ptr();
+	const int nverts = vertices.size() / 3;
+	const int *tris = indices.ptr();
+	const int ntris = indices.size() / 3;
+
+	rcConfig cfg = p_config;
+	cfg.bmin[0] = r_tile.bmin[0];
+	cfg.bmin[1] = r_tile.bmin[1];
+	cfg.bmin[2] = r_tile.bmin[2];
+	cfg.bmax[0] = r_tile.bmax[0];
+	cfg.bmax[1] = r_tile.bmax[1];
+	cfg.bmax[2] = r_tile.bmax[2];
+
 	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
+	// Grow the heightfield by the border, which the region partitioning cuts away again.
+	if (cfg.borderSize > 0) {
+		cfg.width += cfg.borderSize * 2;
+		cfg.height += cfg.borderSize * 2;
+		cfg.bmin[0] -= cfg.borderSize * cfg.cs;
+		cfg.bmin[2] -= cfg.borderSize * cfg.cs;
+		cfg.bmax[0] += cfg.borderSize * cfg.cs;
+		cfg.bmax[2] += cfg.borderSize * cfg.cs;
+	}
+
 	// ~30000000 seems to be around sweetspot where Editor baking breaks
 	if ((cfg.width * cfg.height) > 30000000) {
 		WARN_PRINT("NavigationMesh baking process will likely fail."
@@ -691,23 +1002,47 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 				   "\nIt is advised to increase Cell Size and/or Cell Height in the NavMesh Resource bake settings or reduce the size / scale of the source geometry.");
 	}
 
+	ERR_FAIL_COND_V(ntris == 0, false);
+
+	// Only rasterize the triangles that overlap the tile and its border. Recast would reject the others
+	// one by one, which costs as much as the whole source geometry for every tile.
+	LocalVector<int> tile_tris;
+	for (int i = 0; i < ntris; i++) {
+		const float *v0 = &verts[tris[i * 3 + 0] * 3];
+		const float *v1 = &verts[tris[i * 3 + 1] * 3];
+		const float *v2 = &verts[tris[i * 3 + 2] * 3];
+		if (MIN(MIN(v0[0], v1[0]), v2[0]) > cfg.bmax[0] || MAX(MAX(v0[0], v1[0]), v2[0]) < cfg.bmin[0] ||
+				MIN(MIN(v0[2], v1[2]), v2[2]) > cfg.bmax[2] || MAX(MAX(v0[2], v1[2]), v2[2]) < cfg.bmin[2]) {
+			continue;
+		}
+		tile_tris.push_back(tris[i * 3 + 0]);
+		tile_tris.push_back(tris[i * 3 + 1]);
+		tile_tris.push_back(tris[i * 3 + 2]);
+	}
+	const int tile_ntris = tile_tris.size() / 3;
+
+	if (tile_ntris == 0) {
+		// Nothing to walk on in this tile.
+		r_tile.vertices.clear();
+		r_tile.polygons.clear();
+		return true;
+	}
+
 	bake_state = "Creating heightfield..."; // step #3
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch), false);
 
 	bake_state = "Marking walkable triangles..."; // step #4
 	{
 		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+		tri_areas.resize(tile_ntris);
 
-		ERR_FAIL_COND(tri_areas.size() == 0);
+		memset(tri_areas.ptrw(), 0, tile_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tile_tris.ptr(), tile_ntris, tri_areas.ptrw());
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
-
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, verts, nverts, tile_tris.ptr(), tri_areas.ptr(), tile_ntris, *hf, cfg.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
@@ -724,43 +1059,43 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
 	bake_state = "Eroding walkable area..."; // step #6
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf), false);
 
 	bake_state = "Partitioning..."; // step #7
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, 0, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea), false);
 	}
 
 	bake_state = "Creating contours..."; // step #8
 
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset), false);
 
 	bake_state = "Creating polymesh..."; // step #9
 
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
@@ -769,15 +1104,14 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Converting to native navigation mesh..."; // step #10
 
-	Vector<Vector3> nav_vertices;
-
+	r_tile.vertices.resize(detail_mesh->nverts);
+	Vector3 *tile_vertices = r_tile.vertices.ptrw();
 	for (int i = 0; i < detail_mesh->nverts; i++) {
 		const float *v = &detail_mesh->verts[i * 3];
-		nav_vertices.push_back(Vector3(v[0], v[1], v[2]));
+		tile_vertices[i] = Vector3(v[0], v[1], v[2]);
 	}
-	p_navigation_mesh->set_vertices(nav_vertices);
-	p_navigation_mesh->clear_polygons();
 
+	r_tile.polygons.clear();
 	for (int i = 0; i < detail_mesh->nmeshes; i++) {
 		const unsigned int *detail_mesh_m = &detail_mesh->meshes[i * 4];
 		const unsigned int detail_mesh_bverts = detail_mesh_m[0];
@@ -791,7 +1125,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			nav_indices.write[0] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 0]));
 			nav_indices.write[1] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 2]));
 			nav_indices.write[2] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 1]));
-			p_navigation_mesh->add_polygon(nav_indices);
+			r_tile.polygons.push_back(nav_indices);
 		}
 	}
 
@@ -803,6 +1137,315 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	detail_mesh = nullptr;
 
 	bake_state = "Baking finished."; // step #12
+
+	return true;
+}
+
+void NavMeshGenerator3D::generator_thread_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshGeneratorTileBake3D *tile_bake = static_cast<NavMeshGeneratorTileBake3D *>(p_arg);
+	NavMeshGeneratorTile3D &tile = tile_bake->tiles[p_index];
+
+	tile.baked = generator_bake_tile(tile_bake->navigation_mesh, *tile_bake->config, tile_bake->source_geometry_data, tile);
+}
+
+void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) {
+	if (p_navigation_mesh.is_null() || p_source_geometry_data.is_null()) {
+		return;
+	}
+
+	rcConfig cfg;
+	if (!generator_setup_bake(p_navigation_mesh, p_source_geometry_data, cfg)) {
+		return;
+	}
+
+	NavMeshGeneratorTileBake3D tile_bake;
+	tile_bake.navigation_mesh = p_navigation_mesh;
+	tile_bake.config = &cfg;
+	tile_bake.source_geometry_data = p_source_geometry_data;
+
+	if (cfg.tileSize > 0) {
+		// Split the baked area in tiles aligned to the world origin.
+		const float tile_world_size = cfg.tileSize * cfg.cs;
+		const int tile_min_x = (int)Math::floor(cfg.bmin[0] / tile_world_size);
+		const int tile_min_z = (int)Math::floor(cfg.bmin[2] / tile_world_size);
+		const int tile_max_x = MAX(tile_min_x, (int)Math::ceil(cfg.bmax[0] / tile_world_size) - 1);
+		const int tile_max_z = MAX(tile_min_z, (int)Math::ceil(cfg.bmax[2] / tile_world_size) - 1);
+
+		for (int z = tile_min_z; z <= tile_max_z; z++) {
+			for (int x = tile_min_x; x <= tile_max_x; x++) {
+				NavMeshGeneratorTile3D tile;
+				generator_get_tile_bounds(cfg, Vector2i(x, z), tile.bmin, tile.bmax);
+				tile_bake.tiles.push_back(tile);
+			}
+		}
+	} else {
+		NavMeshGeneratorTile3D tile;
+		memcpy(tile.bmin, cfg.bmin, sizeof(tile.bmin));
+		memcpy(tile.bmax, cfg.bmax, sizeof(tile.bmax));
+		tile_bake.tiles.push_back(tile);
+	}
+
+	// Waiting for the tiles from inside a pool thread could starve the pool, so async bakes on high priority threads stay serial.
+	if (baking_use_multiple_threads && tile_bake.tiles.size() > 1 && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_thread_bake_tile, &tile_bake, tile_bake.tiles.size(), -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < tile_bake.tiles.size(); i++) {
+			generator_thread_bake_tile(&tile_bake, i);
+		}
+	}
+
+	if (cfg.tileSize <= 0 && !tile_bake.tiles[0].baked) {
+		return;
+	}
+
+	// Merge the tiles and stitch them together along their shared edges.
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	for (const NavMeshGeneratorTile3D &tile : tile_bake.tiles) {
+		if (!tile.baked) {
+			continue;
+		}
+		generator_append_tile(tile, nav_vertices, nav_polygons);
+	}
+	if (cfg.tileSize > 0) {
+		generator_stitch_tile_seams(cfg.tileSize * cfg.cs, cfg.cs, MAX(p_navigation_mesh->get_agent_max_climb(), cfg.ch), nav_vertices, nav_polygons);
+	}
+
+	p_navigation_mesh->set_vertices(nav_vertices);
+	p_navigation_mesh->clear_polygons();
+	for (const Vector<int> &nav_polygon : nav_polygons) {
+		p_navigation_mesh->add_polygon(nav_polygon);
+	}
+}
+
+void NavMeshGenerator3D::generator_append_tile(const NavMeshGeneratorTile3D &p_tile, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	const int vertex_offset = r_vertices.size();
+	r_vertices.append_array(p_tile.vertices);
+	for (Vector<int> polygon : p_tile.polygons) {
+		int *indices = polygon.ptrw();
+		for (int i = 0; i < polygon.size(); i++) {
+			indices[i] += vertex_offset;
+		}
+		r_polygons.push_back(polygon);
+	}
+}
+
+void NavMeshGenerator3D::generator_stitch_tile_seams(float p_tile_world_size, float p_cell_size, float p_max_height_delta, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	// Every tile has its own copy of the vertices on its edges, and a tile can have vertices along
+	// a shared edge that its neighbor does not have. Weld the vertices on the tile edges and split
+	// the polygon edges that lie on a tile edge at the vertices of the neighbor tile, so that the
+	// polygons on both sides end up with identical edges that the navigation map connects.
+	const float tolerance = p_cell_size * 0.1f;
+
+	struct TileEdgeVertex {
+		real_t position = 0.0; // Along the tile edge.
+		int index = -1;
+
+		bool operator<(const TileEdgeVertex &p_other) const {
+			return position < p_other.position;
+		}
+	};
+
+	// The vertices on the tile edges of constant X (0) and of constant Z (1), by tile edge index.
+	HashMap<int, LocalVector<TileEdgeVertex>> tile_edges[2];
+
+	const auto get_tile_edge = [p_tile_world_size, tolerance](real_t p_coordinate, int &r_tile_edge) -> bool {
+		r_tile_edge = (int)Math::round(p_coordinate / p_tile_world_size);
+		return Math::abs(p_coordinate - r_tile_edge * p_tile_world_size) <= tolerance;
+	};
+
+	Vector<Vector3> vertices;
+	LocalVector<int> vertex_remap;
+	vertex_remap.resize(r_vertices.size());
+	HashMap<Vector2i, LocalVector<int>> welded_vertices;
+
+	for (int i = 0; i < r_vertices.size(); i++) {
+		const Vector3 &vertex = r_vertices[i];
+		int tile_edge_x = 0;
+		int tile_edge_z = 0;
+		const bool on_tile_edge_x = get_tile_edge(vertex.x, tile_edge_x);
+		const bool on_tile_edge_z = get_tile_edge(vertex.z, tile_edge_z);
+		if (!on_tile_edge_x && !on_tile_edge_z) {
+			vertex_remap[i] = vertices.size();
+			vertices.push_back(vertex);
+			continue;
+		}
+
+		LocalVector<int> &cell_vertices = welded_vertices[Vector2i((int)Math::round(vertex.x / p_cell_size), (int)Math::round(vertex.z / p_cell_size))];
+		int index = -1;
+		for (int welded_index : cell_vertices) {
+			if (Math::abs(vertices[welded_index].y - vertex.y) <= p_max_height_delta) {
+				index = welded_index;
+				break;
+			}
+		}
+		if (index == -1) {
+			index = vertices.size();
+			vertices.push_back(vertex);
+			cell_vertices.push_back(index);
+			if (on_tile_edge_x) {
+				tile_edges[0][tile_edge_x].push_back({ vertex.z, index });
+			}
+			if (on_tile_edge_z) {
+				tile_edges[1][tile_edge_z].push_back({ vertex.x, index });
+			}
+		}
+		vertex_remap[i] = index;
+	}
+
+	for (HashMap<int, LocalVector<TileEdgeVertex>> &axis_tile_edges : tile_edges) {
+		for (KeyValue<int, LocalVector<TileEdgeVertex>> &E : axis_tile_edges) {
+			E.value.sort();
+		}
+	}
+
+	Vector<Vector<int>> polygons;
+	LocalVector<int> split_vertices;
+
+	for (const Vector<int> &polygon : r_polygons) {
+		Vector<int> stitched_polygon;
+		for (int i = 0; i < polygon.size(); i++) {
+			const int from = vertex_remap[polygon[i]];
+			const int to = vertex_remap[polygon[(i + 1) % polygon.size()]];
+			if (from == to) {
+				continue; // Collapsed by the welding.
+			}
+			stitched_polygon.push_back(from);
+
+			const Vector3 &from_vertex = vertices[from];
+			const Vector3 &to_vertex = vertices[to];
+			for (int axis = 0; axis < 2; axis++) {
+				const int coordinate = axis == 0 ? 0 : 2;
+				const int along = axis == 0 ? 2 : 0;
+
+				int from_tile_edge = 0;
+				int to_tile_edge = 0;
+				if (!get_tile_edge(from_vertex[coordinate], from_tile_edge) || !get_tile_edge(to_vertex[coordinate], to_tile_edge) || from_tile_edge != to_tile_edge) {
+					continue;
+				}
+				HashMap<int, LocalVector<TileEdgeVertex>>::ConstIterator E = tile_edges[axis].find(from_tile_edge);
+				if (!E) {
+					continue;
+				}
+
+				// Find the vertices that lie strictly between both ends of the polygon edge.
+				const LocalVector<TileEdgeVertex> &edge_vertices = E->value;
+				const real_t from_position = from_vertex[along];
+				const real_t to_position = to_vertex[along];
+				const real_t low = MIN(from_position, to_position) + tolerance;
+				const real_t high = MAX(from_position, to_position) - tolerance;
+
+				uint32_t first = 0;
+				uint32_t last = edge_vertices.size();
+				while (first < last) {
+					const uint32_t middle = (first + last) / 2;
+					if (edge_vertices[middle].position < low) {
+						first = middle + 1;
+					} else {
+						last = middle;
+					}
+				}
+
+				split_vertices.clear();
+				for (uint32_t j = first; j < edge_vertices.size() && edge_vertices[j].position <= high; j++) {
+					const TileEdgeVertex &edge_vertex = edge_vertices[j];
+					const real_t weight = (edge_vertex.position - from_position) / (to_position - from_position);
+					if (Math::abs(vertices[edge_vertex.index].y - Math::lerp(from_vertex.y, to_vertex.y, weight)) <= p_max_height_delta) {
+						split_vertices.push_back(edge_vertex.index);
+					}
+				}
+				if (from_position < to_position) {
+					for (uint32_t j = 0; j < split_vertices.size(); j++) {
+						stitched_polygon.push_back(split_vertices[j]);
+					}
+				} else {
+					for (int64_t j = (int64_t)split_vertices.size() - 1; j >= 0; j--) {
+						stitched_polygon.push_back(split_vertices[j]);
+					}
+				}
+				break;
+			}
+		}
+
+		if (stitched_polygon.size() >= 3) {
+			polygons.push_back(stitched_polygon);
+		}
+	}
+
+	r_vertices = vertices;
+	r_polygons = polygons;
+}
+
+void NavMeshGenerator3D::generator_bake_tile_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Vector2i &p_tile) {
+	if (p_navigation_mesh.is_null() || p_source_geometry_data.is_null()) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(p_navigation_mesh->get_tile_size() <= 0.0f, "Baking a single tile requires a NavigationMesh with a tile_size greater than 0.");
+
+	const int tile_cells = MAX(1, (int)Math::round(p_navigation_mesh->get_tile_size() / p_navigation_mesh->get_cell_size()));
+	const float tile_world_size = tile_cells * p_navigation_mesh->get_cell_size();
+	const Rect2 tile_rect(p_tile.x * tile_world_size, p_tile.y * tile_world_size, tile_world_size, tile_world_size);
+
+	// Bake the tile, without source geometry it is left empty.
+	NavMeshGeneratorTile3D tile;
+	rcConfig cfg;
+	if (generator_setup_bake(p_navigation_mesh, p_source_geometry_data, cfg)) {
+		generator_get_tile_bounds(cfg, p_tile, tile.bmin, tile.bmax);
+		if (tile.bmin[0] < tile.bmax[0] && tile.bmin[2] < tile.bmax[2] && !generator_bake_tile(p_navigation_mesh, cfg, p_source_geometry_data, tile)) {
+			return;
+		}
+	}
+
+	// Keep the polygons of the other tiles, all polygons of a tile lie within its bounds.
+	const Vector<Vector3> old_vertices = p_navigation_mesh->get_vertices();
+	LocalVector<int> vertex_remap;
+	vertex_remap.resize(old_vertices.size());
+	for (int &index : vertex_remap) {
+		index = -1;
+	}
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	for (int i = 0; i < p_navigation_mesh->get_polygon_count(); i++) {
+		Vector<int> polygon = p_navigation_mesh->get_polygon(i);
+		if (polygon.is_empty()) {
+			continue;
+		}
+
+		Vector2 center;
+		bool valid = true;
+		for (int index : polygon) {
+			if (index < 0 || index >= old_vertices.size()) {
+				valid = false;
+				break;
+			}
+			center += Vector2(old_vertices[index].x, old_vertices[index].z);
+		}
+		ERR_CONTINUE_MSG(!valid, "The navigation mesh has polygons with invalid vertex indices.");
+		if (tile_rect.has_point(center / polygon.size())) {
+			continue;
+		}
+
+		int *indices = polygon.ptrw();
+		for (int j = 0; j < polygon.size(); j++) {
+			if (vertex_remap[indices[j]] == -1) {
+				vertex_remap[indices[j]] = nav_vertices.size();
+				nav_vertices.push_back(old_vertices[indices[j]]);
+			}
+			indices[j] = vertex_remap[indices[j]];
+		}
+		nav_polygons.push_back(polygon);
+	}
+
+	generator_append_tile(tile, nav_vertices, nav_polygons);
+	generator_stitch_tile_seams(tile_world_size, p_navigation_mesh->get_cell_size(), MAX(p_navigation_mesh->get_agent_max_climb(), p_navigation_mesh->get_cell_height()), nav_vertices, nav_polygons);
+
+	p_navigation_mesh->set_vertices(nav_vertices);
+	p_navigation_mesh->clear_polygons();
+	for (const Vector<int> &nav_polygon : nav_polygons) {
+		p_navigation_mesh->add_polygon(nav_polygon);
+	}
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
@@ -37,9 +37,11 @@
 #include "core/object/worker_thread_pool.h"
 #include "modules/modules_enabled.gen.h" // For csg, gridmap.
 
+class Mesh;
 class Node;
 class NavigationMesh;
 class NavigationMeshSourceGeometryData3D;
+struct rcConfig;
 
 class NavMeshGenerator3D : public Object {
 	static NavMeshGenerator3D *singleton;
@@ -63,6 +65,8 @@ class NavMeshGenerator3D : public Object {
 		Ref<NavigationMesh> navigation_mesh;
 		Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
 		Callable callback;
+		bool bake_tile = false;
+		Vector2i tile;
 		WorkerThreadPool::TaskID thread_task_id = WorkerThreadPool::INVALID_TASK_ID;
 		NavMeshGeneratorTask3D::TaskStatus status = NavMeshGeneratorTask3D::TaskStatus::BAKING_STARTED;
 	};
@@ -73,18 +77,72 @@ class NavMeshGenerator3D : public Object {
 
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
-	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
+	struct NavMeshGeneratorTile3D {
+		float bmin[3] = {};
+		float bmax[3] = {};
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+		bool baked = false;
+	};
+
+	struct NavMeshGeneratorTileBake3D {
+		Ref<NavigationMesh> navigation_mesh;
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
+		const rcConfig *config = nullptr;
+		LocalVector<NavMeshGeneratorTile3D> tiles;
+	};
+
+	static void generator_thread_bake_tile(void *p_arg, uint32_t p_index);
+
+	struct NavMeshGeneratorParsedGeometry3D {
+		Vector<Vector3> vertices;
+		Vector<int> indices;
+		Transform3D xform;
+		int vertex_offset = 0;
+		int index_offset = 0;
+	};
+
+	struct NavMeshGeneratorParseState3D {
+		LocalVector<NavMeshGeneratorParsedGeometry3D> geometries;
+		Transform3D root_node_transform;
+		float *vertices_ptrw = nullptr;
+		int *indices_ptrw = nullptr;
+	};
+
+	struct NavMeshGeneratorMeshCache3D {
+		Vector<Vector3> vertices;
+		Vector<int> indices;
+	};
+
+	static Mutex mesh_cache_mutex;
+	static HashMap<ObjectID, NavMeshGeneratorMeshCache3D> mesh_cache;
+
+	static void generator_on_mesh_changed(ObjectID p_mesh_id);
+	static void generator_get_mesh_geometry(const Ref<Mesh> &p_mesh, Vector<Vector3> &r_vertices, Vector<int> &r_indices);
+	static void generator_append_triangles(const int *p_indices, int p_index_count, int p_vertex_offset, Vector<int> &r_indices);
+	static void generator_add_mesh(NavMeshGeneratorParseState3D &r_parse_state, const Ref<Mesh> &p_mesh, const Transform3D &p_xform);
+	static void generator_add_mesh_array(NavMeshGeneratorParseState3D &r_parse_state, const Array &p_mesh_array, const Transform3D &p_xform);
+	static void generator_add_faces(NavMeshGeneratorParseState3D &r_parse_state, const PackedVector3Array &p_faces, const Transform3D &p_xform);
+	static void generator_thread_transform_geometry(void *p_arg, uint32_t p_index);
+
+	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
-
-	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_bake_tile_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Vector2i &p_tile);
+	static bool generator_setup_bake(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, rcConfig &r_config);
+	static void generator_get_tile_bounds(const rcConfig &p_config, const Vector2i &p_tile, float *r_bmin, float *r_bmax);
+	static bool generator_bake_tile(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_config, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, NavMeshGeneratorTile3D &r_tile);
+	static void generator_append_tile(const NavMeshGeneratorTile3D &p_tile, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
+	static void generator_stitch_tile_seams(float p_tile_world_size, float p_cell_size, float p_max_height_delta, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
+
+	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node);
+	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node);
+	static void generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node);
 #ifdef MODULE_CSG_ENABLED
-	static void generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node);
 #endif // MODULE_CSG_ENABLED
 #ifdef MODULE_GRIDMAP_ENABLED
-	static void generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeneratorParseState3D &r_parse_state, Node *p_node);
 #endif // MODULE_GRIDMAP_ENABLED
 
 	static bool generator_emit_callback(const Callable &p_callback);
@@ -99,6 +157,8 @@ public:
 	static void parse_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
+	static void bake_tile_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Vector2i &p_tile, const Callable &p_callback = Callable());
+	static void bake_tile_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Vector2i &p_tile, const Callable &p_callback = Callable());
 
 	NavMeshGenerator3D();
 	~NavMeshGenerator3D();
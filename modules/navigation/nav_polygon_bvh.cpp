@@ -0,0 +1,210 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_bvh.h"
+
+#include "core/math/geometry_3d.h"
+#include "core/templates/sort_array.h"
+
+void NavPolygonBVH::_build_node(uint32_t p_node_index, LocalVector<BuildItem> &r_build_items, uint32_t p_begin, uint32_t p_end, uint32_t p_depth) {
+	AABB aabb = r_build_items[p_begin].aabb;
+	AABB center_bounds(r_build_items[p_begin].center, Vector3());
+	for (uint32_t i = p_begin + 1; i < p_end; i++) {
+		aabb.merge_with(r_build_items[i].aabb);
+		center_bounds.expand_to(r_build_items[i].center);
+	}
+	nodes[p_node_index].aabb = aabb;
+
+	if (p_end - p_begin <= MAX_LEAF_SIZE || p_depth + 1 >= MAX_DEPTH) {
+		nodes[p_node_index].first = items.size();
+		nodes[p_node_index].count = p_end - p_begin;
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			items.push_back(r_build_items[i].polygon_index);
+		}
+		return;
+	}
+
+	// Split at the median of the polygon centers along the longest axis.
+	const uint32_t middle = (p_begin + p_end) / 2;
+	SortArray<BuildItem, BuildItemComparator> sorter;
+	sorter.compare.axis = Vector3::Axis(center_bounds.get_longest_axis_index());
+	sorter.nth_element(p_begin, p_end, middle, r_build_items.ptr());
+
+	const uint32_t first_child = nodes.size();
+	nodes.resize(first_child + 2);
+	nodes[p_node_index].first = first_child;
+	nodes[p_node_index].count = 0;
+
+	_build_node(first_child, r_build_items, p_begin, middle, p_depth + 1);
+	_build_node(first_child + 1, r_build_items, middle, p_end, p_depth + 1);
+}
+
+void NavPolygonBVH::build(const LocalVector<gd::Polygon> &p_polygons) {
+	clear();
+
+	LocalVector<BuildItem> build_items;
+	build_items.reserve(p_polygons.size());
+	for (uint32_t polygon_index = 0; polygon_index < p_polygons.size(); polygon_index++) {
+		const gd::Polygon &polygon = p_polygons[polygon_index];
+		if (polygon.points.size() < 3) {
+			continue;
+		}
+
+		BuildItem build_item;
+		build_item.aabb = AABB(polygon.points[0].pos, Vector3());
+		for (uint32_t point_id = 1; point_id < polygon.points.size(); point_id++) {
+			build_item.aabb.expand_to(polygon.points[point_id].pos);
+		}
+		// Flat polygons have flat boxes, keep them from missing segments that only touch them.
+		build_item.aabb = build_item.aabb.grow(CMP_EPSILON);
+		build_item.center = build_item.aabb.get_center();
+		build_item.polygon_index = polygon_index;
+		build_items.push_back(build_item);
+	}
+
+	if (build_items.is_empty()) {
+		return;
+	}
+
+	nodes.reserve(build_items.size() * 2 / MAX_LEAF_SIZE + 1);
+	items.reserve(build_items.size());
+	nodes.resize(1);
+	_build_node(0, build_items, 0, build_items.size(), 0);
+}
+
+void NavPolygonBVH::clear() {
+	nodes.clear();
+	items.clear();
+}
+
+bool NavPolygonBVH::intersect_segment(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_intersection) const {
+	if (nodes.is_empty()) {
+		return false;
+	}
+
+	bool intersects = false;
+	real_t closest_distance = FLT_MAX;
+
+	uint32_t stack[MAX_DEPTH * 2];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const Node &node = nodes[stack[--stack_size]];
+		if (!node.aabb.intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		if (node.count == 0) {
+			stack[stack_size++] = node.first;
+			stack[stack_size++] = node.first + 1;
+			continue;
+		}
+
+		for (uint32_t i = node.first; i < node.first + node.count; i++) {
+			const gd::Polygon &polygon = p_polygons[items[i]];
+			for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+				const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+				Vector3 intersection;
+				if (face.intersects_segment(p_from, p_to, &intersection)) {
+					const real_t distance = p_from.distance_to(intersection);
+					if (distance < closest_distance) {
+						closest_distance = distance;
+						r_intersection = intersection;
+						intersects = true;
+					}
+				}
+			}
+		}
+	}
+
+	return intersects;
+}
+
+bool NavPolygonBVH::get_closest_outline_point_to_segment(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_closest_point) const {
+	if (nodes.is_empty()) {
+		return false;
+	}
+
+	// The distance between the boxes of the segment and of a node is a lower bound for the distance between their contents.
+	AABB segment_aabb(p_from, Vector3());
+	segment_aabb.expand_to(p_to);
+
+	bool found = false;
+	real_t closest_distance_squared = FLT_MAX;
+
+	uint32_t stack[MAX_DEPTH * 2];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const Node &node = nodes[stack[--stack_size]];
+		if (_get_distance_squared(node.aabb, segment_aabb) > closest_distance_squared) {
+			continue;
+		}
+
+		if (node.count == 0) {
+			const real_t first_distance_squared = _get_distance_squared(nodes[node.first].aabb, segment_aabb);
+			const real_t second_distance_squared = _get_distance_squared(nodes[node.first + 1].aabb, segment_aabb);
+			if (first_distance_squared < second_distance_squared) {
+				stack[stack_size++] = node.first + 1;
+				stack[stack_size++] = node.first;
+			} else {
+				stack[stack_size++] = node.first;
+				stack[stack_size++] = node.first + 1;
+			}
+			continue;
+		}
+
+		for (uint32_t i = node.first; i < node.first + node.count; i++) {
+			const gd::Polygon &polygon = p_polygons[items[i]];
+			for (uint32_t point_id = 0; point_id < polygon.points.size(); point_id++) {
+				Vector3 segment_point;
+				Vector3 outline_point;
+				Geometry3D::get_closest_points_between_segments(
+						p_from,
+						p_to,
+						polygon.points[point_id].pos,
+						polygon.points[(point_id + 1) % polygon.points.size()].pos,
+						segment_point,
+						outline_point);
+
+				const real_t distance_squared = segment_point.distance_squared_to(outline_point);
+				if (distance_squared < closest_distance_squared) {
+					closest_distance_squared = distance_squared;
+					r_closest_point = outline_point;
+					found = true;
+				}
+			}
+		}
+	}
+
+	return found;
+}
@@ -0,0 +1,165 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_POLYGON_BVH_H
+#define NAV_POLYGON_BVH_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+#include "core/math/face3.h"
+#include "core/templates/local_vector.h"
+
+/// Bounding volume hierarchy over the polygons of a map.
+///
+/// Built once per map synchronization so that the closest point and segment
+/// queries only test the polygons close to the query instead of all of them.
+class NavPolygonBVH {
+	struct Node {
+		AABB aabb;
+		/// Leaves: first entry in `items`. Internal nodes: first child, the second child directly follows it.
+		uint32_t first = 0;
+		/// Number of items of a leaf, 0 for internal nodes.
+		uint32_t count = 0;
+	};
+
+	struct BuildItem {
+		AABB aabb;
+		Vector3 center;
+		uint32_t polygon_index = 0;
+	};
+
+	struct BuildItemComparator {
+		Vector3::Axis axis = Vector3::AXIS_X;
+
+		_FORCE_INLINE_ bool operator()(const BuildItem &p_a, const BuildItem &p_b) const {
+			return p_a.center[axis] < p_b.center[axis];
+		}
+	};
+
+	static const uint32_t MAX_LEAF_SIZE = 4;
+	static const uint32_t MAX_DEPTH = 64;
+
+	LocalVector<Node> nodes;
+	/// Polygon indices, grouped per leaf.
+	LocalVector<uint32_t> items;
+
+	void _build_node(uint32_t p_node_index, LocalVector<BuildItem> &r_build_items, uint32_t p_begin, uint32_t p_end, uint32_t p_depth);
+
+	static _FORCE_INLINE_ real_t _get_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+		return p_point.clamp(p_aabb.position, p_aabb.position + p_aabb.size).distance_squared_to(p_point);
+	}
+
+	static _FORCE_INLINE_ real_t _get_distance_squared(const AABB &p_aabb, const AABB &p_other) {
+		const Vector3 end = p_aabb.position + p_aabb.size;
+		const Vector3 other_end = p_other.position + p_other.size;
+		real_t distance_squared = 0.0;
+		for (int axis = 0; axis < 3; axis++) {
+			const real_t gap = MAX(MAX(p_aabb.position[axis] - other_end[axis], p_other.position[axis] - end[axis]), real_t(0.0));
+			distance_squared += gap * gap;
+		}
+		return distance_squared;
+	}
+
+public:
+	void build(const LocalVector<gd::Polygon> &p_polygons);
+	void clear();
+
+	bool is_empty() const { return nodes.is_empty(); }
+
+	/// Returns the polygon accepted by `p_filter` that is closest to `p_point`, or `nullptr`.
+	/// Ties are resolved in favor of the polygon that comes first in `p_polygons`, like a linear scan would.
+	template <typename F>
+	const gd::Polygon *get_closest_polygon(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, F p_filter, Vector3 &r_closest_point, Vector3 *r_normal = nullptr) const {
+		if (nodes.is_empty()) {
+			return nullptr;
+		}
+
+		uint32_t closest_polygon_index = UINT32_MAX;
+		real_t closest_distance_squared = FLT_MAX;
+
+		uint32_t stack[MAX_DEPTH * 2];
+		uint32_t stack_size = 0;
+		stack[stack_size++] = 0;
+
+		while (stack_size > 0) {
+			const Node &node = nodes[stack[--stack_size]];
+			if (_get_distance_squared(node.aabb, p_point) > closest_distance_squared) {
+				continue;
+			}
+
+			if (node.count == 0) {
+				// Visit the closer child first, it is more likely to shrink the search radius.
+				const real_t first_distance_squared = _get_distance_squared(nodes[node.first].aabb, p_point);
+				const real_t second_distance_squared = _get_distance_squared(nodes[node.first + 1].aabb, p_point);
+				if (first_distance_squared < second_distance_squared) {
+					stack[stack_size++] = node.first + 1;
+					stack[stack_size++] = node.first;
+				} else {
+					stack[stack_size++] = node.first;
+					stack[stack_size++] = node.first + 1;
+				}
+				continue;
+			}
+
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const uint32_t polygon_index = items[i];
+				const gd::Polygon &polygon = p_polygons[polygon_index];
+				if (!p_filter(polygon)) {
+					continue;
+				}
+
+				for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+					const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+					const Vector3 point = face.get_closest_point_to(p_point);
+					const real_t distance_squared = point.distance_squared_to(p_point);
+					if (distance_squared < closest_distance_squared || (distance_squared == closest_distance_squared && polygon_index < closest_polygon_index)) {
+						closest_distance_squared = distance_squared;
+						closest_polygon_index = polygon_index;
+						r_closest_point = point;
+						if (r_normal) {
+							*r_normal = face.get_plane().normal;
+						}
+					}
+				}
+			}
+		}
+
+		return closest_polygon_index == UINT32_MAX ? nullptr : &p_polygons[closest_polygon_index];
+	}
+
+	/// Finds the intersection of the segment with the polygons that is closest to `p_from`.
+	bool intersect_segment(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_intersection) const;
+
+	/// Finds the point on the polygon outlines that is closest to the segment.
+	bool get_closest_outline_point_to_segment(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_closest_point) const;
+};
+
+#endif // NAV_POLYGON_BVH_H
@@ -112,30 +112,29 @@ Vector3 NavRegion::get_random_point(uint32_t p_navigation_layers, bool p_uniform
 	}
 
 	if (p_uniformly) {
-		real_t accumulated_area = 0;
-		RBMap<real_t, uint32_t> region_area_map;
-
-		for (uint32_t rp_index = 0; rp_index < region_polygons.size(); rp_index++) {
-			const gd::Polygon &region_polygon = region_polygons[rp_index];
-			real_t polyon_area = region_polygon.surface_area;
-
-			if (polyon_area == 0.0) {
-				continue;
-			}
-			region_area_map[accumulated_area] = rp_index;
-			accumulated_area += polyon_area;
-		}
-		if (region_area_map.is_empty() || accumulated_area == 0) {
+		ERR_FAIL_COND_V(polygon_area_offsets.size() != region_polygons.size(), Vector3());
+		if (surface_area == 0) {
 			// All polygons have no real surface / no area.
 			return Vector3();
 		}
 
-		real_t region_area_map_pos = Math::random(real_t(0), accumulated_area);
-
-		RBMap<real_t, uint32_t>::Iterator region_E = region_area_map.find_closest(region_area_map_pos);
-		ERR_FAIL_COND_V(!region_E, Vector3());
-		uint32_t rrp_polygon_index = region_E->value;
-		ERR_FAIL_UNSIGNED_INDEX_V(rrp_polygon_index, region_polygons.size(), Vector3());
+		const real_t region_area_pos = Math::random(real_t(0), surface_area);
+
+		// Binary search the last polygon starting at or before the random position.
+		uint32_t rrp_polygon_index = 0;
+		uint32_t search_end = polygon_area_offsets.size();
+		while (rrp_polygon_index + 1 < search_end) {
+			const uint32_t search_middle = (rrp_polygon_index + search_end) / 2;
+			if (polygon_area_offsets[search_middle] <= region_area_pos) {
+				rrp_polygon_index = search_middle;
+			} else {
+				search_end = search_middle;
+			}
+		}
+		// Polygons without area can only be hit at the very end.
+		while (rrp_polygon_index > 0 && region_polygons[rrp_polygon_index].surface_area == 0.0) {
+			rrp_polygon_index--;
+		}
 
 		const gd::Polygon &rr_polygon = region_polygons[rrp_polygon_index];
 
@@ -195,9 +194,16 @@ void NavRegion::update_polygons() {
 		return;
 	}
 	polygons.clear();
+	bounds = AABB();
+	merged_edges.clear();
+	border_edges.clear();
 	surface_area = 0.0;
+	polygon_area_offsets.clear();
 	polygons_dirty = false;
 
+	static uint64_t last_polygons_revision = 0;
+	polygons_revision = ++last_polygons_revision;
+
 	if (map == nullptr) {
 		return;
 	}
@@ -234,6 +240,7 @@ void NavRegion::update_polygons() {
 
 	// Build
 	int navigation_mesh_polygon_index = 0;
+	bool first_point = true;
 	for (gd::Polygon &polygon : polygons) {
 		polygon.owner = this;
 		polygon.surface_area = 0.0;
@@ -280,6 +287,13 @@ void NavRegion::update_polygons() {
 			polygon.points[j].pos = point_position;
 			polygon.points[j].key = map->get_point_key(point_position);
 
+			if (first_point) {
+				bounds.position = point_position;
+				first_point = false;
+			} else {
+				bounds.expand_to(point_position);
+			}
+
 			polygon_center += point_position; // Composing the center of the polygon
 
 			if (j >= 2) {
@@ -301,4 +315,52 @@ void NavRegion::update_polygons() {
 	}
 
 	surface_area = _new_region_surface_area;
+
+	polygon_area_offsets.resize(polygons.size());
+	real_t polygon_area_offset = 0.0;
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		polygon_area_offsets[i] = polygon_area_offset;
+		polygon_area_offset += polygons[i].surface_area;
+	}
+
+	update_edges();
+}
+
+void NavRegion::update_edges() {
+	// Group the edges per key, the edges that share a key with another polygon of this region are merged
+	// once here so the map only has to connect the remaining border edges with other regions.
+	HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey> edge_indices;
+	LocalVector<gd::RegionEdge> edges;
+	LocalVector<bool> edges_merged;
+
+	for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+		const gd::Polygon &polygon = polygons[polygon_index];
+		for (uint32_t p = 0; p < polygon.points.size(); p++) {
+			int next_point = (p + 1) % polygon.points.size();
+			gd::RegionEdge edge;
+			edge.polygon = polygon_index;
+			edge.edge = p;
+			edge.key = gd::EdgeKey(polygon.points[p].key, polygon.points[next_point].key);
+
+			HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey>::Iterator E = edge_indices.find(edge.key);
+			if (!E) {
+				edge_indices.insert(edge.key, edges.size());
+				edges.push_back(edge);
+				edges_merged.push_back(false);
+			} else if (!edges_merged[E->value]) {
+				merged_edges.push_back(edges[E->value]);
+				merged_edges.push_back(edge);
+				edges_merged[E->value] = true;
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'.");
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < edges.size(); i++) {
+		if (!edges_merged[i]) {
+			border_edges.push_back(edges[i]);
+		}
+	}
 }
@@ -46,11 +46,21 @@ class NavRegion : public NavBase {
 	bool use_edge_connections = true;
 
 	bool polygons_dirty = true;
+	/// Changes each time the polygons are rebuilt, unique among all regions.
+	uint64_t polygons_revision = 0;
 
 	/// Cache
 	LocalVector<gd::Polygon> polygons;
+	AABB bounds;
+
+	/// Edges shared by two polygons of this region, stored in consecutive pairs.
+	LocalVector<gd::RegionEdge> merged_edges;
+	/// Edges left to be connected with other regions.
+	LocalVector<gd::RegionEdge> border_edges;
 
 	real_t surface_area = 0.0;
+	/// Surface area of all the polygons before each polygon, to pick random polygons by area.
+	LocalVector<real_t> polygon_area_offsets;
 
 public:
 	NavRegion() {
@@ -94,6 +104,18 @@ public:
 	LocalVector<gd::Polygon> const &get_polygons() const {
 		return polygons;
 	}
+	uint64_t get_polygons_revision() const {
+		return polygons_revision;
+	}
+	const AABB &get_bounds() const {
+		return bounds;
+	}
+	const LocalVector<gd::RegionEdge> &get_merged_edges() const {
+		return merged_edges;
+	}
+	const LocalVector<gd::RegionEdge> &get_border_edges() const {
+		return border_edges;
+	}
 
 	Vector3 get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const;
 
@@ -103,6 +125,7 @@ public:
 
 private:
 	void update_polygons();
+	void update_edges();
 };
 
 #endif // NAV_REGION_H
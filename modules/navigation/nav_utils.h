@@ -31,6 +31,7 @@
 #ifndef NAV_UTILS_H
 #define NAV_UTILS_H
 
+#include "core/error/error_macros.h"
 #include "core/math/vector3.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hashfuncs.h"
@@ -98,6 +99,9 @@ struct Edge {
 };
 
 struct Polygon {
+	/// Id of the polygon in the map, used to index the path search state.
+	uint32_t id = UINT32_MAX;
+
 	/// Navigation region or link that contains this polygon.
 	const NavBase *owner = nullptr;
 
@@ -116,6 +120,13 @@ struct Polygon {
 	real_t surface_area = 0.0;
 };
 
+/// Edge of a region polygon, the polygon being referenced by its index in the region.
+struct RegionEdge {
+	uint32_t polygon = 0;
+	uint32_t edge = 0;
+	EdgeKey key;
+};
+
 struct NavigationPoly {
 	uint32_t self_id = 0;
 	/// This poly.
@@ -131,6 +142,13 @@ struct NavigationPoly {
 	Vector3 entry;
 	/// The distance to the destination.
 	real_t traveled_distance = 0.0;
+	/// The traveled distance plus the estimated distance to the end, used to order the open set.
+	real_t total_cost = 0.0;
+
+	/// The path search this poly was last reached in, so the search state does not need clearing.
+	uint32_t search_generation = 0;
+	/// Position of this poly in the open set heap, or `UINT32_MAX` when not in it.
+	uint32_t heap_index = UINT32_MAX;
 
 	NavigationPoly() { poly = nullptr; }
 
@@ -146,6 +164,102 @@ struct NavigationPoly {
 	}
 };
 
+struct NavPolyTravelCostLessThan {
+	_FORCE_INLINE_ bool operator()(const NavigationPoly *p_poly_a, const NavigationPoly *p_poly_b) const {
+		return p_poly_a->total_cost < p_poly_b->total_cost;
+	}
+};
+
+struct NavPolyHeapIndexer {
+	_FORCE_INLINE_ void operator()(NavigationPoly *p_poly, uint32_t p_heap_index) const {
+		p_poly->heap_index = p_heap_index;
+	}
+};
+
+/// Binary min-heap which reports the position of its elements through `Indexer`,
+/// so an element whose priority improved can be moved up with `shift()`.
+template <typename T, typename LessThan, typename Indexer>
+class Heap {
+	LocalVector<T> buffer;
+	LessThan less_than;
+	Indexer indexer;
+
+	void _shift_up(uint32_t p_index) {
+		T element = buffer[p_index];
+		while (p_index > 0) {
+			uint32_t parent = (p_index - 1) / 2;
+			if (!less_than(element, buffer[parent])) {
+				break;
+			}
+			buffer[p_index] = buffer[parent];
+			indexer(buffer[p_index], p_index);
+			p_index = parent;
+		}
+		buffer[p_index] = element;
+		indexer(element, p_index);
+	}
+
+	void _shift_down(uint32_t p_index) {
+		T element = buffer[p_index];
+		uint32_t size = buffer.size();
+		while (true) {
+			uint32_t child = p_index * 2 + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && less_than(buffer[child + 1], buffer[child])) {
+				child++;
+			}
+			if (!less_than(buffer[child], element)) {
+				break;
+			}
+			buffer[p_index] = buffer[child];
+			indexer(buffer[p_index], p_index);
+			p_index = child;
+		}
+		buffer[p_index] = element;
+		indexer(element, p_index);
+	}
+
+public:
+	static const uint32_t INVALID_INDEX = UINT32_MAX;
+
+	void reserve(uint32_t p_size) { buffer.reserve(p_size); }
+	uint32_t size() const { return buffer.size(); }
+	bool is_empty() const { return buffer.is_empty(); }
+
+	void push(const T &p_element) {
+		buffer.push_back(p_element);
+		_shift_up(buffer.size() - 1);
+	}
+
+	T pop() {
+		ERR_FAIL_COND_V_MSG(buffer.is_empty(), T(), "Can't pop an empty heap.");
+		T top = buffer[0];
+		T last = buffer[buffer.size() - 1];
+		buffer.remove_at(buffer.size() - 1);
+		if (!buffer.is_empty()) {
+			buffer[0] = last;
+			_shift_down(0);
+		}
+		indexer(top, INVALID_INDEX);
+		return top;
+	}
+
+	/// Moves an element up after its priority improved.
+	void shift(uint32_t p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, buffer.size());
+		_shift_up(p_index);
+	}
+
+	void clear() {
+		for (const T &element : buffer) {
+			indexer(element, INVALID_INDEX);
+		}
+		buffer.clear();
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
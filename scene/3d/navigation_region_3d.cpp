@@ -256,6 +256,23 @@ void NavigationRegion3D::bake_navigation_mesh(bool p_on_thread) {
 	}
 }
 
+void NavigationRegion3D::bake_navigation_mesh_tile(const Vector2i &p_tile, bool p_on_thread) {
+	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "The SceneTree can only be parsed on the main thread. Call this function from the main thread or use call_deferred().");
+	ERR_FAIL_COND_MSG(!navigation_mesh.is_valid(), "Baking the navigation mesh requires a valid `NavigationMesh` resource.");
+	ERR_FAIL_COND_MSG(navigation_mesh->get_tile_size() <= 0.0f, "Baking a navigation mesh tile requires a `NavigationMesh` with a `tile_size` greater than 0.");
+
+	Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
+	source_geometry_data.instantiate();
+
+	NavigationServer3D::get_singleton()->parse_source_geometry_data(navigation_mesh, source_geometry_data, this);
+
+	if (p_on_thread) {
+		NavigationServer3D::get_singleton()->bake_tile_from_source_geometry_data_async(navigation_mesh, source_geometry_data, p_tile, callable_mp(this, &NavigationRegion3D::_bake_finished).bind(navigation_mesh));
+	} else {
+		NavigationServer3D::get_singleton()->bake_tile_from_source_geometry_data(navigation_mesh, source_geometry_data, p_tile, callable_mp(this, &NavigationRegion3D::_bake_finished).bind(navigation_mesh));
+	}
+}
+
 void NavigationRegion3D::_bake_finished(Ref<NavigationMesh> p_navigation_mesh) {
 	if (!Thread::is_main_thread()) {
 		call_deferred(SNAME("_bake_finished"), p_navigation_mesh);
@@ -308,6 +325,7 @@ void NavigationRegion3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_travel_cost"), &NavigationRegion3D::get_travel_cost);
 
 	ClassDB::bind_method(D_METHOD("bake_navigation_mesh", "on_thread"), &NavigationRegion3D::bake_navigation_mesh, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("bake_navigation_mesh_tile", "tile", "on_thread"), &NavigationRegion3D::bake_navigation_mesh_tile, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("_bake_finished", "navigation_mesh"), &NavigationRegion3D::_bake_finished);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "navigation_mesh", PROPERTY_HINT_RESOURCE_TYPE, "NavigationMesh"), "set_navigation_mesh", "get_navigation_mesh");
@@ -104,6 +104,7 @@ public:
 	/// Bakes the navigation mesh; once done, automatically
 	/// sets the new navigation mesh and emits a signal
 	void bake_navigation_mesh(bool p_on_thread);
+	void bake_navigation_mesh_tile(const Vector2i &p_tile, bool p_on_thread);
 	void _bake_finished(Ref<NavigationMesh> p_navigation_mesh);
 
 	PackedStringArray get_configuration_warnings() const override;
@@ -92,6 +92,7 @@ void HeightMapShape3D::_update_shape() {
 	d["heights"] = map_data;
 	d["min_height"] = min_height;
 	d["max_height"] = max_height;
+	d["compressed"] = compressed;
 	PhysicsServer3D::get_singleton()->shape_set_data(get_shape(), d);
 	Shape3D::_update_shape();
 }
@@ -179,6 +180,44 @@ Vector<real_t> HeightMapShape3D::get_map_data() const {
 	return map_data;
 }
 
+void HeightMapShape3D::set_compressed(bool p_compressed) {
+	if (compressed == p_compressed) {
+		return;
+	}
+	compressed = p_compressed;
+	_update_shape();
+	emit_changed();
+}
+
+bool HeightMapShape3D::is_compressed() const {
+	return compressed;
+}
+
+void HeightMapShape3D::update_map_data_region(const Rect2i &p_region, const Vector<real_t> &p_data) {
+	ERR_FAIL_COND(p_region.position.x < 0 || p_region.position.y < 0 || p_region.size.x <= 0 || p_region.size.y <= 0);
+	ERR_FAIL_COND(p_region.position.x + p_region.size.x > map_width || p_region.position.y + p_region.size.y > map_depth);
+	ERR_FAIL_COND(p_data.size() != p_region.size.x * p_region.size.y);
+
+	real_t *w = map_data.ptrw();
+	const real_t *r = p_data.ptr();
+	for (int z = 0; z < p_region.size.y; z++) {
+		for (int x = 0; x < p_region.size.x; x++) {
+			real_t val = r[z * p_region.size.x + x];
+			w[(p_region.position.y + z) * map_width + p_region.position.x + x] = val;
+			min_height = MIN(min_height, val);
+			max_height = MAX(max_height, val);
+		}
+	}
+
+	// Only send the changed region, so streaming tiles into a large terrain doesn't rebuild the whole shape.
+	Dictionary d;
+	d["region"] = p_region;
+	d["heights"] = p_data;
+	PhysicsServer3D::get_singleton()->shape_set_data(get_shape(), d);
+	Shape3D::_update_shape();
+	emit_changed();
+}
+
 void HeightMapShape3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_map_width", "width"), &HeightMapShape3D::set_map_width);
 	ClassDB::bind_method(D_METHOD("get_map_width"), &HeightMapShape3D::get_map_width);
@@ -186,10 +225,14 @@ void HeightMapShape3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_map_depth"), &HeightMapShape3D::get_map_depth);
 	ClassDB::bind_method(D_METHOD("set_map_data", "data"), &HeightMapShape3D::set_map_data);
 	ClassDB::bind_method(D_METHOD("get_map_data"), &HeightMapShape3D::get_map_data);
+	ClassDB::bind_method(D_METHOD("set_compressed", "compressed"), &HeightMapShape3D::set_compressed);
+	ClassDB::bind_method(D_METHOD("is_compressed"), &HeightMapShape3D::is_compressed);
+	ClassDB::bind_method(D_METHOD("update_map_data_region", "region", "data"), &HeightMapShape3D::update_map_data_region);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "map_width", PROPERTY_HINT_RANGE, "0.001,100,0.001,or_greater"), "set_map_width", "get_map_width");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "map_depth", PROPERTY_HINT_RANGE, "0.001,100,0.001,or_greater"), "set_map_depth", "get_map_depth");
 	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "map_data"), "set_map_data", "get_map_data");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compressed"), "set_compressed", "is_compressed");
 }
 
 HeightMapShape3D::HeightMapShape3D() :
@@ -41,6 +41,7 @@ class HeightMapShape3D : public Shape3D {
 	Vector<real_t> map_data;
 	real_t min_height = 0.0;
 	real_t max_height = 0.0;
+	bool compressed = false;
 
 protected:
 	static void _bind_methods();
@@ -53,6 +54,10 @@ public:
 	int get_map_depth() const;
 	void set_map_data(Vector<real_t> p_new);
 	Vector<real_t> get_map_data() const;
+	void set_compressed(bool p_compressed);
+	bool is_compressed() const;
+
+	void update_map_data_region(const Rect2i &p_region, const Vector<real_t> &p_data);
 
 	virtual Vector<Vector3> get_debug_mesh_lines() const override;
 	virtual real_t get_enclosing_radius() const override;
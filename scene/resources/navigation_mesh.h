@@ -104,6 +104,8 @@ protected:
 	bool filter_walkable_low_height_spans = false;
 	AABB filter_baking_aabb;
 	Vector3 filter_baking_aabb_offset;
+	float tile_size = 0.0f;
+	float border_size = 0.0f;
 
 public:
 	// Recast settings
@@ -179,6 +181,12 @@ public:
 	void set_filter_baking_aabb_offset(const Vector3 &p_aabb_offset);
 	Vector3 get_filter_baking_aabb_offset() const;
 
+	void set_tile_size(float p_value);
+	float get_tile_size() const;
+
+	void set_border_size(float p_value);
+	float get_border_size() const;
+
 	void create_from_mesh(const Ref<Mesh> &p_mesh);
 
 	void set_vertices(const Vector<Vector3> &p_vertices);
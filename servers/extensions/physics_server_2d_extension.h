@@ -237,6 +237,9 @@ public:
 	EXBIND1RC(Vector<Vector2>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
 
+	EXBIND1RC(PackedByteArray, space_save_state, RID)
+	EXBIND2(space_restore_state, RID, const PackedByteArray &)
+
 	/* AREA API */
 
 	//EXBIND0RID(area);
@@ -99,6 +99,9 @@ public:
 	virtual TypedArray<RID> map_get_links(RID p_map) const = 0;
 	virtual TypedArray<RID> map_get_regions(RID p_map) const = 0;
 	virtual TypedArray<RID> map_get_agents(RID p_map) const = 0;
+
+	/// Returns the last avoidance velocities of all agents on the map in map_get_agents order.
+	virtual PackedVector2Array map_get_agents_safe_velocities(RID p_map) const = 0;
 	virtual TypedArray<RID> map_get_obstacles(RID p_map) const = 0;
 
 	virtual void map_force_update(RID p_map) = 0;
@@ -110,6 +110,9 @@ public:
 	virtual TypedArray<RID> map_get_links(RID p_map) const = 0;
 	virtual TypedArray<RID> map_get_regions(RID p_map) const = 0;
 	virtual TypedArray<RID> map_get_agents(RID p_map) const = 0;
+
+	/// Returns the last avoidance velocities of all agents on the map in map_get_agents order.
+	virtual PackedVector3Array map_get_agents_safe_velocities(RID p_map) const = 0;
 	virtual TypedArray<RID> map_get_obstacles(RID p_map) const = 0;
 
 	virtual void map_force_update(RID p_map) = 0;
@@ -320,6 +323,27 @@ public:
 	virtual void obstacle_set_avoidance_layers(RID p_obstacle, uint32_t p_layers) = 0;
 	virtual uint32_t obstacle_get_avoidance_layers(RID p_obstacle) const = 0;
 
+	/// Creates the flow field.
+	virtual RID flow_field_create() = 0;
+
+	/// Set the map of this flow field.
+	virtual void flow_field_set_map(RID p_flow_field, RID p_map) = 0;
+	virtual RID flow_field_get_map(RID p_flow_field) const = 0;
+
+	/// Set the positions all paths of this flow field lead to.
+	virtual void flow_field_set_targets(RID p_flow_field, Vector<Vector3> p_targets) = 0;
+	virtual Vector<Vector3> flow_field_get_targets(RID p_flow_field) const = 0;
+
+	/// Set the navigation layers of the polygons the flow field may cross.
+	virtual void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers) = 0;
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const = 0;
+
+	/// Returns where to move to next from the given position to reach the closest target.
+	virtual Vector3 flow_field_get_next_position(RID p_flow_field, const Vector3 &p_position) const = 0;
+
+	/// Returns the travel cost from the given position to the closest target.
+	virtual real_t flow_field_get_distance(RID p_flow_field, const Vector3 &p_position) const = 0;
+
 	/// Destroy the `RID`
 	virtual void free(RID p_object) = 0;
 
@@ -340,9 +364,15 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const = 0;
 
+	/// Queues a path query that runs on worker threads, returns a ticket to poll it.
+	virtual int64_t query_path_async(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, const Ref<NavigationPathQueryResult3D> &p_query_result, const Callable &p_callback = Callable(), int p_priority = 0) = 0;
+	virtual bool query_path_async_is_completed(int64_t p_ticket) const = 0;
+
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
+	virtual void bake_tile_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Vector2i &p_tile, const Callable &p_callback = Callable()) = 0;
+	virtual void bake_tile_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Vector2i &p_tile, const Callable &p_callback = Callable()) = 0;
 
 	NavigationServer3D();
 	~NavigationServer3D() override;
@@ -357,6 +387,8 @@ public:
 		INFO_EDGE_MERGE_COUNT,
 		INFO_EDGE_CONNECTION_COUNT,
 		INFO_EDGE_FREE_COUNT,
+		INFO_PATH_QUERY_QUEUE_COUNT,
+		INFO_PATH_QUERY_LATENCY,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) const = 0;
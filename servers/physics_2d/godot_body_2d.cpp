@@ -715,6 +715,41 @@ bool GodotBody2D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody2D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody2D::set_snapshot_state(const SnapshotState &p_state) {
+	if (mode == PhysicsServer2D::BODY_MODE_STATIC) {
+		// Static bodies are only moved through the API, nothing to restore.
+		return;
+	}
+
+	if (get_transform() != p_state.transform) {
+		_set_transform(p_state.transform);
+		_set_inv_transform(p_state.transform.affine_inverse());
+		_update_transform_dependent();
+	}
+	new_transform = p_state.new_transform;
+
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	biased_linear_velocity = Vector2();
+	biased_angular_velocity = 0.0;
+	still_time = p_state.still_time;
+
+	set_active(p_state.active);
+}
+
 void GodotBody2D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
@@ -591,18 +591,48 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair2D::get_snapshot_state(SnapshotState &r_state) const {
+	for (int i = 0; i < contact_count; i++) {
+		r_state.contacts[i] = contacts[i];
+	}
+	r_state.contact_count = contact_count;
+	r_state.sep_axis = sep_axis;
+	r_state.collided = collided;
+	r_state.oneway_disabled = oneway_disabled;
+}
+
+void GodotBodyPair2D::set_snapshot_state(const SnapshotState &p_state) {
+	contact_count = CLAMP(p_state.contact_count, 0, (int)MAX_CONTACTS);
+	for (int i = 0; i < contact_count; i++) {
+		contacts[i] = p_state.contacts[i];
+	}
+	sep_axis = p_state.sep_axis;
+	collided = p_state.collided;
+	oneway_disabled = p_state.oneway_disabled;
+}
+
+void GodotBodyPair2D::clear_snapshot_state() {
+	contact_count = 0;
+	sep_axis = Vector2();
+	collided = false;
+	oneway_disabled = false;
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
-		GodotConstraint2D(_arr, 2) {
+		GodotConstraint2D(_arr, 2),
+		body_pair_list(this) {
 	A = p_A;
 	B = p_B;
 	shape_A = p_shape_A;
 	shape_B = p_shape_B;
 	space = A->get_space();
+	space->body_pair_add_to_list(&body_pair_list);
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
 }
 
 GodotBodyPair2D::~GodotBodyPair2D() {
+	space->body_pair_remove_from_list(&body_pair_list);
 	A->remove_constraint(this, 0);
 	B->remove_constraint(this, 1);
 }
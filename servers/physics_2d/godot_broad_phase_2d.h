@@ -42,6 +42,12 @@ public:
 
 	static CreateFunction create_func;
 
+	// Selected with the "physics/2d/broadphase/type" project setting.
+	enum Type {
+		TYPE_BVH,
+		TYPE_HASH_GRID,
+	};
+
 	typedef uint32_t ID;
 
 	typedef void *(*PairCallback)(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_userdata);
@@ -0,0 +1,426 @@
+/**************************************************************************/
+/*  godot_broad_phase_2d_hash_grid.cpp                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_broad_phase_2d_hash_grid.h"
+
+#include "godot_collision_object_2d.h"
+
+#include "core/config/project_settings.h"
+
+bool GodotBroadPhase2DHashGrid::_get_cell_range(const Rect2 &p_aabb, Vector2i &r_from, Vector2i &r_to) const {
+	Vector2 from = p_aabb.position * inv_cell_size;
+	Vector2 to = (p_aabb.position + p_aabb.size) * inv_cell_size;
+
+	// Computed in doubles so huge or infinite bounds (e.g. world boundaries) are caught before converting to cells.
+	double cell_count = 1.0;
+	for (int i = 0; i < 2; i++) {
+		cell_count *= Math::floor((double)to[i]) - Math::floor((double)from[i]) + 1.0;
+	}
+
+	if (!(cell_count <= large_object_threshold)) {
+		return false;
+	}
+
+	for (int i = 0; i < 2; i++) {
+		r_from[i] = (int32_t)Math::floor(from[i]);
+		r_to[i] = (int32_t)Math::floor(to[i]);
+	}
+
+	return true;
+}
+
+void GodotBroadPhase2DHashGrid::_enter_grid(Element *p_elem) {
+	p_elem->large = !_get_cell_range(p_elem->aabb, p_elem->cell_from, p_elem->cell_to);
+
+	if (p_elem->large) {
+		large_elements.push_back(p_elem);
+		return;
+	}
+
+	for (int i = p_elem->cell_from.x; i <= p_elem->cell_to.x; i++) {
+		for (int j = p_elem->cell_from.y; j <= p_elem->cell_to.y; j++) {
+			cells[Vector2i(i, j)].push_back(p_elem);
+		}
+	}
+}
+
+void GodotBroadPhase2DHashGrid::_exit_grid(Element *p_elem) {
+	if (p_elem->large) {
+		large_elements.erase(p_elem);
+		return;
+	}
+
+	for (int i = p_elem->cell_from.x; i <= p_elem->cell_to.x; i++) {
+		for (int j = p_elem->cell_from.y; j <= p_elem->cell_to.y; j++) {
+			HashMap<Vector2i, LocalVector<Element *>>::Iterator E = cells.find(Vector2i(i, j));
+			ERR_CONTINUE(!E);
+
+			LocalVector<Element *> &cell = E->value;
+			int64_t index = cell.find(p_elem);
+			ERR_CONTINUE(index < 0);
+			cell.remove_at_unordered(index);
+
+			if (cell.is_empty()) {
+				cells.remove(E);
+			}
+		}
+	}
+}
+
+void GodotBroadPhase2DHashGrid::_mark_changed(Element *p_elem, bool p_full_check) {
+	p_elem->full_check = p_elem->full_check || p_full_check;
+	if (!p_elem->changed) {
+		p_elem->changed = true;
+		changed_elements.push_back(p_elem);
+	}
+}
+
+bool GodotBroadPhase2DHashGrid::_can_pair(const Element *p_elem_A, const Element *p_elem_B) const {
+	if (p_elem_A->owner == p_elem_B->owner) {
+		return false;
+	}
+	if (p_elem_A->_static && p_elem_B->_static) {
+		return false;
+	}
+	return p_elem_A->owner->interacts_with(p_elem_B->owner);
+}
+
+bool GodotBroadPhase2DHashGrid::_is_paired(const Element *p_elem_A, const Element *p_elem_B) const {
+	// Search the shorter list.
+	if (p_elem_A->pairs.size() > p_elem_B->pairs.size()) {
+		SWAP(p_elem_A, p_elem_B);
+	}
+	for (const PairLink &link : p_elem_A->pairs) {
+		if (link.other == p_elem_B) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void GodotBroadPhase2DHashGrid::_pair(Element *p_elem_A, Element *p_elem_B) {
+	// Keep callbacks in a stable order, like the BVH does.
+	if (p_elem_A->self > p_elem_B->self) {
+		SWAP(p_elem_A, p_elem_B);
+	}
+
+	void *data = nullptr;
+	if (pair_callback) {
+		data = pair_callback(p_elem_A->owner, p_elem_A->subindex, p_elem_B->owner, p_elem_B->subindex, pair_userdata);
+	}
+
+	PairLink link;
+	link.data = data;
+	link.other = p_elem_B;
+	p_elem_A->pairs.push_back(link);
+	link.other = p_elem_A;
+	p_elem_B->pairs.push_back(link);
+}
+
+void GodotBroadPhase2DHashGrid::_unpair(Element *p_elem_A, Element *p_elem_B) {
+	if (p_elem_A->self > p_elem_B->self) {
+		SWAP(p_elem_A, p_elem_B);
+	}
+
+	void *data = nullptr;
+	for (uint32_t i = 0; i < p_elem_A->pairs.size(); i++) {
+		if (p_elem_A->pairs[i].other == p_elem_B) {
+			data = p_elem_A->pairs[i].data;
+			p_elem_A->pairs.remove_at_unordered(i);
+			break;
+		}
+	}
+	for (uint32_t i = 0; i < p_elem_B->pairs.size(); i++) {
+		if (p_elem_B->pairs[i].other == p_elem_A) {
+			p_elem_B->pairs.remove_at_unordered(i);
+			break;
+		}
+	}
+
+	if (unpair_callback) {
+		unpair_callback(p_elem_A->owner, p_elem_A->subindex, p_elem_B->owner, p_elem_B->subindex, data, unpair_userdata);
+	}
+}
+
+void GodotBroadPhase2DHashGrid::_check_pair(Element *p_elem, Element *p_other) {
+	if (p_other == p_elem || !p_elem->aabb.intersects(p_other->aabb, true)) {
+		return;
+	}
+	if (!_can_pair(p_elem, p_other) || _is_paired(p_elem, p_other)) {
+		return;
+	}
+	_pair(p_elem, p_other);
+}
+
+template <class Tester>
+int GodotBroadPhase2DHashGrid::_cull(const Rect2 &p_aabb, const Tester &p_tester, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices) const {
+	int count = 0;
+
+	Vector2i from, to;
+	if (!_get_cell_range(p_aabb, from, to)) {
+		// Too many cells to visit, testing every element is cheaper.
+		for (const KeyValue<ID, Element *> &E : element_map) {
+			if (count >= p_max_results) {
+				break;
+			}
+			const Element *elem = E.value;
+			if (!p_tester(elem->aabb)) {
+				continue;
+			}
+			p_results[count] = elem->owner;
+			if (p_result_indices) {
+				p_result_indices[count] = elem->subindex;
+			}
+			count++;
+		}
+		return count;
+	}
+
+	// Queries don't write anything, so they can run from several threads at once like with the BVH.
+	for (int i = from.x; i <= to.x; i++) {
+		for (int j = from.y; j <= to.y; j++) {
+			const Vector2i cell = Vector2i(i, j);
+			HashMap<Vector2i, LocalVector<Element *>>::ConstIterator E = cells.find(cell);
+			if (!E) {
+				continue;
+			}
+
+			for (const Element *elem : E->value) {
+				if (count >= p_max_results) {
+					return count;
+				}
+				if (!_is_first_shared_cell(elem, from, cell)) {
+					continue;
+				}
+				if (!p_tester(elem->aabb)) {
+					continue;
+				}
+				p_results[count] = elem->owner;
+				if (p_result_indices) {
+					p_result_indices[count] = elem->subindex;
+				}
+				count++;
+			}
+		}
+	}
+
+	for (const Element *elem : large_elements) {
+		if (count >= p_max_results) {
+			break;
+		}
+		if (!p_tester(elem->aabb)) {
+			continue;
+		}
+		p_results[count] = elem->owner;
+		if (p_result_indices) {
+			p_result_indices[count] = elem->subindex;
+		}
+		count++;
+	}
+
+	return count;
+}
+
+GodotBroadPhase2DHashGrid::ID GodotBroadPhase2DHashGrid::create(GodotCollisionObject2D *p_object, int p_subindex, const Rect2 &p_aabb, bool p_static) {
+	current++;
+
+	Element *elem = element_allocator.alloc();
+	elem->self = current;
+	elem->owner = p_object;
+	elem->subindex = p_subindex;
+	elem->_static = p_static;
+	elem->aabb = p_aabb;
+
+	element_map.insert(current, elem);
+	_enter_grid(elem);
+	_mark_changed(elem, true);
+
+	return current;
+}
+
+void GodotBroadPhase2DHashGrid::move(ID p_id, const Rect2 &p_aabb) {
+	HashMap<ID, Element *>::Iterator E = element_map.find(p_id);
+	ERR_FAIL_COND(!E);
+
+	Element *elem = E->value;
+	if (elem->aabb == p_aabb) {
+		return;
+	}
+
+	elem->aabb = p_aabb;
+
+	Vector2i from, to;
+	bool large = !_get_cell_range(p_aabb, from, to);
+	if (large != elem->large || (!large && (from != elem->cell_from || to != elem->cell_to))) {
+		_exit_grid(elem);
+		_enter_grid(elem);
+	}
+
+	_mark_changed(elem, false);
+}
+
+void GodotBroadPhase2DHashGrid::set_static(ID p_id, bool p_static) {
+	HashMap<ID, Element *>::Iterator E = element_map.find(p_id);
+	ERR_FAIL_COND(!E);
+
+	Element *elem = E->value;
+	if (elem->_static == p_static) {
+		return;
+	}
+
+	elem->_static = p_static;
+	_mark_changed(elem, true);
+}
+
+void GodotBroadPhase2DHashGrid::remove(ID p_id) {
+	HashMap<ID, Element *>::Iterator E = element_map.find(p_id);
+	ERR_FAIL_COND(!E);
+
+	Element *elem = E->value;
+
+	// Pairs must be removed right away, their data may reference the object being removed.
+	while (elem->pairs.size()) {
+		_unpair(elem, elem->pairs[0].other);
+	}
+
+	_exit_grid(elem);
+
+	if (elem->changed) {
+		changed_elements.erase(elem);
+	}
+
+	element_map.remove(E);
+	element_allocator.free(elem);
+}
+
+GodotCollisionObject2D *GodotBroadPhase2DHashGrid::get_object(ID p_id) const {
+	HashMap<ID, Element *>::ConstIterator E = element_map.find(p_id);
+	ERR_FAIL_COND_V(!E, nullptr);
+	return E->value->owner;
+}
+
+bool GodotBroadPhase2DHashGrid::is_static(ID p_id) const {
+	HashMap<ID, Element *>::ConstIterator E = element_map.find(p_id);
+	ERR_FAIL_COND_V(!E, false);
+	return E->value->_static;
+}
+
+int GodotBroadPhase2DHashGrid::get_subindex(ID p_id) const {
+	HashMap<ID, Element *>::ConstIterator E = element_map.find(p_id);
+	ERR_FAIL_COND_V(!E, 0);
+	return E->value->subindex;
+}
+
+int GodotBroadPhase2DHashGrid::cull_segment(const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices) {
+	Rect2 segment_aabb(p_from, Vector2());
+	segment_aabb.expand_to(p_to);
+	return _cull(
+			segment_aabb, [&](const Rect2 &p_aabb) { return p_aabb.intersects_segment(p_from, p_to); }, p_results, p_max_results, p_result_indices);
+}
+
+int GodotBroadPhase2DHashGrid::cull_aabb(const Rect2 &p_aabb, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices) {
+	return _cull(
+			p_aabb, [&](const Rect2 &p_elem_aabb) { return p_elem_aabb.intersects(p_aabb); }, p_results, p_max_results, p_result_indices);
+}
+
+void GodotBroadPhase2DHashGrid::set_pair_callback(PairCallback p_pair_callback, void *p_userdata) {
+	pair_callback = p_pair_callback;
+	pair_userdata = p_userdata;
+}
+
+void GodotBroadPhase2DHashGrid::set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) {
+	unpair_callback = p_unpair_callback;
+	unpair_userdata = p_userdata;
+}
+
+void GodotBroadPhase2DHashGrid::update() {
+	for (uint32_t n = 0; n < changed_elements.size(); n++) {
+		Element *elem = changed_elements[n];
+
+		// Find the pairs that no longer overlap, or that are no longer allowed after a full check.
+		for (uint32_t i = 0; i < elem->pairs.size(); i++) {
+			Element *other = elem->pairs[i].other;
+			if (elem->aabb.intersects(other->aabb, true) && (!elem->full_check || _can_pair(elem, other))) {
+				continue;
+			}
+			_unpair(elem, other);
+			i--;
+		}
+
+		// Find the new pairs.
+		if (elem->large) {
+			for (const KeyValue<ID, Element *> &E : element_map) {
+				_check_pair(elem, E.value);
+			}
+		} else {
+			for (int i = elem->cell_from.x; i <= elem->cell_to.x; i++) {
+				for (int j = elem->cell_from.y; j <= elem->cell_to.y; j++) {
+					const Vector2i cell = Vector2i(i, j);
+					HashMap<Vector2i, LocalVector<Element *>>::Iterator E = cells.find(cell);
+					if (!E) {
+						continue;
+					}
+
+					for (Element *other : E->value) {
+						if (_is_first_shared_cell(other, elem->cell_from, cell)) {
+							_check_pair(elem, other);
+						}
+					}
+				}
+			}
+
+			for (Element *other : large_elements) {
+				_check_pair(elem, other);
+			}
+		}
+
+		elem->changed = false;
+		elem->full_check = false;
+	}
+
+	changed_elements.clear();
+}
+
+GodotBroadPhase2D *GodotBroadPhase2DHashGrid::_create() {
+	return memnew(GodotBroadPhase2DHashGrid);
+}
+
+GodotBroadPhase2DHashGrid::GodotBroadPhase2DHashGrid() {
+	cell_size = GLOBAL_GET("physics/2d/broadphase/hash_grid_cell_size");
+	cell_size = MAX(cell_size, (real_t)CMP_EPSILON);
+	inv_cell_size = 1.0 / cell_size;
+	large_object_threshold = MAX((int)GLOBAL_GET("physics/2d/broadphase/hash_grid_large_object_threshold"), 1);
+}
+
+GodotBroadPhase2DHashGrid::~GodotBroadPhase2DHashGrid() {
+	for (const KeyValue<ID, Element *> &E : element_map) {
+		element_allocator.free(E.value);
+	}
+}
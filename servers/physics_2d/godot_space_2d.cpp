@@ -1008,6 +1008,204 @@ bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::
 	return collided;
 }
 
+// Snapshots are raw copies of the simulation state and are only meant to be
+// restored by the same build, the header rejects buffers with another layout.
+#define SPACE_SNAPSHOT_MAGIC_2D 0x32505347 // "GSP2"
+#define SPACE_SNAPSHOT_VERSION_2D 1
+
+struct SpaceSnapshotHeader2D {
+	uint32_t magic = SPACE_SNAPSHOT_MAGIC_2D;
+	uint32_t version = SPACE_SNAPSHOT_VERSION_2D;
+	uint32_t real_size = sizeof(real_t);
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+};
+
+struct SpaceSnapshotBody2D {
+	uint64_t rid = 0;
+	GodotBody2D::SnapshotState state;
+};
+
+struct SpaceSnapshotPair2D {
+	uint64_t rid_A = 0;
+	uint64_t rid_B = 0;
+	int32_t shape_A = 0;
+	int32_t shape_B = 0;
+	GodotBodyPair2D::SnapshotState state;
+};
+
+struct SpaceSnapshotPairKey2D {
+	uint64_t rid_A = 0;
+	uint64_t rid_B = 0;
+	int32_t shape_A = 0;
+	int32_t shape_B = 0;
+
+	static uint32_t hash(const SpaceSnapshotPairKey2D &p_key) {
+		uint32_t h = hash_murmur3_one_64(p_key.rid_A);
+		h = hash_murmur3_one_64(p_key.rid_B, h);
+		h = hash_murmur3_one_32(p_key.shape_A, h);
+		h = hash_murmur3_one_32(p_key.shape_B, h);
+		return hash_fmix32(h);
+	}
+
+	bool operator==(const SpaceSnapshotPairKey2D &p_key) const {
+		return rid_A == p_key.rid_A && rid_B == p_key.rid_B && shape_A == p_key.shape_A && shape_B == p_key.shape_B;
+	}
+
+	SpaceSnapshotPairKey2D() {}
+	SpaceSnapshotPairKey2D(const GodotBodyPair2D *p_pair) :
+			rid_A(p_pair->get_body_A()->get_self().get_id()),
+			rid_B(p_pair->get_body_B()->get_self().get_id()),
+			shape_A(p_pair->get_shape_A()),
+			shape_B(p_pair->get_shape_B()) {}
+	SpaceSnapshotPairKey2D(const SpaceSnapshotPair2D &p_record) :
+			rid_A(p_record.rid_A),
+			rid_B(p_record.rid_B),
+			shape_A(p_record.shape_A),
+			shape_B(p_record.shape_B) {}
+};
+
+Vector<uint8_t> GodotSpace2D::save_state() const {
+	SpaceSnapshotHeader2D header;
+	for (const GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			header.body_count++;
+		}
+	}
+	for (const SelfList<GodotBodyPair2D> *E = body_pair_list.first(); E; E = E->next()) {
+		header.pair_count++;
+	}
+
+	Vector<uint8_t> state;
+	state.resize(sizeof(SpaceSnapshotHeader2D) + header.body_count * sizeof(SpaceSnapshotBody2D) + header.pair_count * sizeof(SpaceSnapshotPair2D));
+	uint8_t *w = state.ptrw();
+
+	memcpy(w, &header, sizeof(SpaceSnapshotHeader2D));
+	w += sizeof(SpaceSnapshotHeader2D);
+
+	SpaceSnapshotBody2D body_record;
+	for (const GodotCollisionObject2D *E : objects) {
+		if (E->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody2D *body = static_cast<const GodotBody2D *>(E);
+		body_record.rid = body->get_self().get_id();
+		body->get_snapshot_state(body_record.state);
+		memcpy(w, &body_record, sizeof(SpaceSnapshotBody2D));
+		w += sizeof(SpaceSnapshotBody2D);
+	}
+
+	SpaceSnapshotPair2D pair_record;
+	for (const SelfList<GodotBodyPair2D> *E = body_pair_list.first(); E; E = E->next()) {
+		const GodotBodyPair2D *pair = E->self();
+		pair_record.rid_A = pair->get_body_A()->get_self().get_id();
+		pair_record.rid_B = pair->get_body_B()->get_self().get_id();
+		pair_record.shape_A = pair->get_shape_A();
+		pair_record.shape_B = pair->get_shape_B();
+		pair->get_snapshot_state(pair_record.state);
+		memcpy(w, &pair_record, sizeof(SpaceSnapshotPair2D));
+		w += sizeof(SpaceSnapshotPair2D);
+	}
+
+	return state;
+}
+
+bool GodotSpace2D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, false, "Space state can't be restored while the space is being stepped.");
+	ERR_FAIL_COND_V((uint64_t)p_state.size() < sizeof(SpaceSnapshotHeader2D), false);
+
+	const uint8_t *r = p_state.ptr();
+	SpaceSnapshotHeader2D header;
+	memcpy(&header, r, sizeof(SpaceSnapshotHeader2D));
+	r += sizeof(SpaceSnapshotHeader2D);
+
+	ERR_FAIL_COND_V_MSG(header.magic != SPACE_SNAPSHOT_MAGIC_2D || header.version != SPACE_SNAPSHOT_VERSION_2D || header.real_size != sizeof(real_t), false, "Invalid or incompatible 2D physics space state.");
+	ERR_FAIL_COND_V((uint64_t)p_state.size() != sizeof(SpaceSnapshotHeader2D) + header.body_count * sizeof(SpaceSnapshotBody2D) + header.pair_count * sizeof(SpaceSnapshotPair2D), false);
+
+	const uint8_t *body_data = r;
+	const uint8_t *pair_data = r + header.body_count * sizeof(SpaceSnapshotBody2D);
+
+	// Objects are usually the same ones that existed when saving (and iterate in the same order),
+	// so records are matched in sequence and only fall back to a lookup table when that fails.
+	SpaceSnapshotBody2D body_record;
+	uint32_t body_index = 0;
+	bool bodies_in_order = true;
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		GodotBody2D *body = static_cast<GodotBody2D *>(E);
+		if (body_index < header.body_count) {
+			memcpy(&body_record, body_data + body_index * sizeof(SpaceSnapshotBody2D), sizeof(SpaceSnapshotBody2D));
+			if (body_record.rid == body->get_self().get_id()) {
+				body->set_snapshot_state(body_record.state);
+				body_index++;
+				continue;
+			}
+		}
+		bodies_in_order = false;
+		break;
+	}
+
+	if (!bodies_in_order) {
+		HashMap<uint64_t, uint32_t> body_records;
+		body_records.reserve(header.body_count);
+		for (uint32_t i = 0; i < header.body_count; i++) {
+			memcpy(&body_record.rid, body_data + i * sizeof(SpaceSnapshotBody2D), sizeof(uint64_t));
+			body_records.insert(body_record.rid, i);
+		}
+		for (GodotCollisionObject2D *E : objects) {
+			if (E->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+				continue;
+			}
+			// Bodies added after the state was saved are left untouched.
+			GodotBody2D *body = static_cast<GodotBody2D *>(E);
+			HashMap<uint64_t, uint32_t>::ConstIterator F = body_records.find(body->get_self().get_id());
+			if (F) {
+				memcpy(&body_record, body_data + F->value * sizeof(SpaceSnapshotBody2D), sizeof(SpaceSnapshotBody2D));
+				body->set_snapshot_state(body_record.state);
+			}
+		}
+	}
+
+	// Contact caches are restored for pairs that still exist, pairs created since then lose
+	// their warm starting data and pairs that disappeared are regenerated by the next step.
+	SpaceSnapshotPair2D pair_record;
+	uint32_t pair_index = 0;
+	SelfList<GodotBodyPair2D> *pair_element = body_pair_list.first();
+	while (pair_element && pair_index < header.pair_count) {
+		GodotBodyPair2D *pair = pair_element->self();
+		memcpy(&pair_record, pair_data + pair_index * sizeof(SpaceSnapshotPair2D), sizeof(SpaceSnapshotPair2D));
+		if (!(SpaceSnapshotPairKey2D(pair) == SpaceSnapshotPairKey2D(pair_record))) {
+			break;
+		}
+		pair->set_snapshot_state(pair_record.state);
+		pair_index++;
+		pair_element = pair_element->next();
+	}
+
+	if (pair_element) {
+		HashMap<SpaceSnapshotPairKey2D, uint32_t, SpaceSnapshotPairKey2D> pair_records;
+		pair_records.reserve(header.pair_count - pair_index);
+		for (uint32_t i = pair_index; i < header.pair_count; i++) {
+			memcpy(&pair_record, pair_data + i * sizeof(SpaceSnapshotPair2D), sizeof(SpaceSnapshotPair2D));
+			pair_records.insert(SpaceSnapshotPairKey2D(pair_record), i);
+		}
+		for (; pair_element; pair_element = pair_element->next()) {
+			GodotBodyPair2D *pair = pair_element->self();
+			HashMap<SpaceSnapshotPairKey2D, uint32_t, SpaceSnapshotPairKey2D>::ConstIterator F = pair_records.find(SpaceSnapshotPairKey2D(pair));
+			if (F) {
+				memcpy(&pair_record, pair_data + F->value * sizeof(SpaceSnapshotPair2D), sizeof(SpaceSnapshotPair2D));
+				pair->set_snapshot_state(pair_record.state);
+			} else {
+				pair->clear_snapshot_state();
+			}
+		}
+	}
+
+	return true;
+}
+
 // Assumes a valid collision pair, this should have been checked beforehand in the BVH or octree.
 void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_self) {
 	GodotCollisionObject2D::Type type_A = A->get_type();
@@ -1116,6 +1314,14 @@ const SelfList<GodotArea2D>::List &GodotSpace2D::get_moved_area_list() const {
 	return area_moved_list;
 }
 
+void GodotSpace2D::body_pair_add_to_list(SelfList<GodotBodyPair2D> *p_body_pair) {
+	body_pair_list.add(p_body_pair);
+}
+
+void GodotSpace2D::body_pair_remove_from_list(SelfList<GodotBodyPair2D> *p_body_pair) {
+	body_pair_list.remove(p_body_pair);
+}
+
 void GodotSpace2D::call_queries() {
 	while (state_query_list.first()) {
 		GodotBody2D *b = state_query_list.first()->self();
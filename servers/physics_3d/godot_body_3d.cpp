@@ -609,6 +609,7 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	prev_angular_velocity = angular_velocity;
 
 	Vector3 motion;
+	real_t angular_motion = 0.0;
 	bool do_motion = false;
 
 	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
@@ -629,8 +630,10 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 		if (!omit_force_integration) {
 			//overridden by direct state query
 
-			Vector3 force = gravity * mass + applied_force + constant_force;
-			Vector3 torque = applied_torque + constant_torque;
+			// Applied forces are gathered once per tick, scale them to the time covered by the whole step.
+			real_t applied_force_scale = get_space()->get_applied_force_scale();
+			Vector3 force = gravity * mass + applied_force * applied_force_scale + callback_force + constant_force;
+			Vector3 torque = applied_torque * applied_force_scale + callback_torque + constant_torque;
 
 			real_t damp = 1.0 - p_step * total_linear_damp;
 
@@ -653,18 +656,24 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 
 		if (continuous_cd) {
 			motion = linear_velocity * p_step;
+			angular_motion = angular_velocity.length() * p_step;
 			do_motion = true;
 		}
 	}
 
-	applied_force = Vector3();
-	applied_torque = Vector3();
+	// Applied forces act on every substep of the tick.
+	if (get_space()->is_last_substep()) {
+		applied_force = Vector3();
+		applied_torque = Vector3();
+	}
+	callback_force = Vector3();
+	callback_torque = Vector3();
 
 	biased_angular_velocity = Vector3();
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_update_shapes_with_motion(motion, angular_motion);
 	}
 
 	contact_count = 0;
@@ -675,7 +684,8 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		return;
 	}
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
+	extrapolating = false;
+	if ((fi_callback_data || body_state_callback.is_valid()) && !direct_state_query_list.in_list()) {
 		get_space()->body_add_to_state_query_list(&direct_state_query_list);
 	}
 
@@ -759,17 +769,17 @@ void GodotBody3D::wakeup_neighbours() {
 void GodotBody3D::call_queries() {
 	Variant direct_state_variant = get_direct_state();
 
-	if (fi_callback_data) {
-		if (!fi_callback_data->callable.is_valid()) {
-			set_force_integration_callback(Callable());
-		} else {
-			const Variant *vp[2] = { &direct_state_variant, &fi_callback_data->udata };
-
-			Callable::CallError ce;
-			int argc = (fi_callback_data->udata.get_type() == Variant::NIL) ? 1 : 2;
-			Variant rv;
-			fi_callback_data->callable.callp(vp, argc, rv, ce);
+	if (extrapolating) {
+		// Only the transform changed, forces aren't integrated until the space is stepped again.
+		if (body_state_callback.is_valid()) {
+			body_state_callback.call(direct_state_variant);
 		}
+		extrapolating = false;
+		return;
+	}
+
+	if (fi_callback_data) {
+		call_force_integration_callback(direct_state_variant);
 	}
 
 	if (body_state_callback.is_valid()) {
@@ -777,6 +787,53 @@ void GodotBody3D::call_queries() {
 	}
 }
 
+void GodotBody3D::call_force_integration_callback(const Variant &p_direct_state) {
+	if (!fi_callback_data->callable.is_valid()) {
+		set_force_integration_callback(Callable());
+		return;
+	}
+
+	// Forces applied from the callback are meant for the next integration step only, keep them apart from the ones applied during the tick.
+	Vector3 tick_force = applied_force;
+	Vector3 tick_torque = applied_torque;
+
+	const Variant *vp[2] = { &p_direct_state, &fi_callback_data->udata };
+
+	Callable::CallError ce;
+	int argc = (fi_callback_data->udata.get_type() == Variant::NIL) ? 1 : 2;
+	Variant rv;
+	fi_callback_data->callable.callp(vp, argc, rv, ce);
+
+	callback_force += applied_force - tick_force;
+	callback_torque += applied_torque - tick_torque;
+	applied_force = tick_force;
+	applied_torque = tick_torque;
+}
+
+void GodotBody3D::extrapolate_state(real_t p_time) {
+	if (mode < PhysicsServer3D::BODY_MODE_RIGID || !body_state_callback.is_valid()) {
+		return;
+	}
+
+	extrapolated_transform = get_transform();
+
+	real_t ang_vel = angular_velocity.length();
+	if (!Math::is_zero_approx(ang_vel)) {
+		Vector3 ang_vel_axis = angular_velocity / ang_vel;
+		Basis rot(ang_vel_axis, ang_vel * p_time);
+		Basis identity3(1, 0, 0, 0, 1, 0, 0, 0, 1);
+		extrapolated_transform.origin += ((identity3 - rot) * extrapolated_transform.basis).xform(center_of_mass_local);
+		extrapolated_transform.basis = rot * extrapolated_transform.basis;
+		extrapolated_transform.orthonormalize();
+	}
+	extrapolated_transform.origin += linear_velocity * p_time;
+
+	extrapolating = true;
+	if (!direct_state_query_list.in_list()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+}
+
 bool GodotBody3D::sleep_test(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC || mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
 		return true;
@@ -794,6 +851,41 @@ bool GodotBody3D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody3D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody3D::set_snapshot_state(const SnapshotState &p_state) {
+	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
+		// Static bodies are only moved through the API, nothing to restore.
+		return;
+	}
+
+	if (get_transform() != p_state.transform) {
+		_set_transform(p_state.transform);
+		_set_inv_transform(p_state.transform.affine_inverse());
+		_update_transform_dependent();
+	}
+	new_transform = p_state.new_transform;
+
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	biased_linear_velocity = Vector3();
+	biased_angular_velocity = Vector3();
+	still_time = p_state.still_time;
+
+	set_active(p_state.active);
+}
+
 void GodotBody3D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
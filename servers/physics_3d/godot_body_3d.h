@@ -93,6 +93,10 @@ class GodotBody3D : public GodotCollisionObject3D {
 	Vector3 applied_force;
 	Vector3 applied_torque;
 
+	// Applied from the force integration callback, only acts on the next integration step.
+	Vector3 callback_force;
+	Vector3 callback_torque;
+
 	Vector3 constant_force;
 	Vector3 constant_torque;
 
@@ -146,13 +150,33 @@ class GodotBody3D : public GodotCollisionObject3D {
 
 	uint64_t island_step = 0;
 
+	// Reported instead of the actual transform on ticks where the space isn't stepped.
+	Transform3D extrapolated_transform;
+	bool extrapolating = false;
+
 	void _update_transform_dependent();
 
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
 
 public:
+	// Simulation state saved and restored by space snapshots, kept POD so it can be copied in bulk.
+	struct SnapshotState {
+		Transform3D transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 prev_linear_velocity;
+		Vector3 prev_angular_velocity;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void get_snapshot_state(SnapshotState &r_state) const;
+	void set_snapshot_state(const SnapshotState &p_state);
+
 	void set_state_sync_callback(const Callable &p_callable);
 	void set_force_integration_callback(const Callable &p_callable, const Variant &p_udata = Variant());
+	_FORCE_INLINE_ bool has_force_integration_callback() const { return fi_callback_data != nullptr; }
 
 	GodotPhysicsDirectBodyState3D *get_direct_state();
 
@@ -339,6 +363,8 @@ public:
 
 	//void simulate_motion(const Transform3D& p_xform,real_t p_step);
 	void call_queries();
+	void call_force_integration_callback(const Variant &p_direct_state);
+	void extrapolate_state(real_t p_time);
 	void wakeup_neighbours();
 
 	bool sleep_test(real_t p_step);
@@ -92,7 +92,7 @@ void GodotPhysicsDirectBodyState3D::set_transform(const Transform3D &p_transform
 }
 
 Transform3D GodotPhysicsDirectBodyState3D::get_transform() const {
-	return body->get_transform();
+	return body->extrapolating ? body->extrapolated_transform : body->get_transform();
 }
 
 Vector3 GodotPhysicsDirectBodyState3D::get_velocity_at_local_position(const Vector3 &p_position) const {
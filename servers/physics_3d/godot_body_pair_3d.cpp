@@ -132,8 +132,8 @@ void GodotBodyPair3D::validate_contacts() {
 		Contact &c = contacts[i];
 
 		bool erase = false;
-		if (!c.used) {
-			// Was left behind in previous frame.
+		if (!c.used || c.speculative) {
+			// Was left behind in previous frame, or only predicted for it.
 			erase = true;
 		} else {
 			c.used = false;
@@ -297,19 +297,86 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
 
 	if (!collided) {
-		if (A->is_continuous_collision_detection_enabled() && collide_A) {
-			check_ccd = true;
-			return true;
+		bool ccd_A = A->is_continuous_collision_detection_enabled() && collide_A;
+		bool ccd_B = B->is_continuous_collision_detection_enabled() && collide_B;
+		if (!ccd_A && !ccd_B) {
+			return false;
 		}
 
-		if (B->is_continuous_collision_detection_enabled() && collide_B) {
-			check_ccd = true;
-			return true;
+		if (_setup_speculative_contact(p_step, shape_A_ptr, xform_A, shape_B_ptr, xform_B)) {
+			return collided;
 		}
 
+		// No distance query available for this pair, fall back to raycasting.
+		check_ccd = true;
+		return true;
+	}
+
+	return true;
+}
+
+bool GodotBodyPair3D::_setup_speculative_contact(real_t p_step, const GodotShape3D *p_shape_A, const Transform3D &p_xform_A, const GodotShape3D *p_shape_B, const Transform3D &p_xform_B) {
+	// Distance queries only accept concave shapes and world boundaries as the second shape.
+	bool swap = p_shape_A->is_concave() || p_shape_A->get_type() == PhysicsServer3D::SHAPE_WORLD_BOUNDARY;
+
+	const GodotShape3D *shape_1 = swap ? p_shape_B : p_shape_A;
+	const Transform3D &xform_1 = swap ? p_xform_B : p_xform_A;
+	const GodotShape3D *shape_2 = swap ? p_shape_A : p_shape_B;
+	const Transform3D &xform_2 = swap ? p_xform_A : p_xform_B;
+
+	// All positions are relative to A's origin, see setup().
+	Vector3 center_of_mass_A = A->get_center_of_mass();
+	Vector3 center_of_mass_B = B->get_center_of_mass() + offset_B;
+
+	AABB aabb_A = p_xform_A.xform(p_shape_A->get_aabb());
+	AABB aabb_B = p_xform_B.xform(p_shape_B->get_aabb());
+
+	// Upper bound of how far any point of each shape can travel due to rotation within the step.
+	real_t angular_motion_A = A->get_angular_velocity().length() * p_step;
+	real_t angular_motion_B = B->get_angular_velocity().length() * p_step;
+	real_t sweep_A = MIN(angular_motion_A, (real_t)2.0) * ((aabb_A.get_center() - center_of_mass_A).length() + aabb_A.size.length() * 0.5);
+	real_t sweep_B = MIN(angular_motion_B, (real_t)2.0) * ((aabb_B.get_center() - center_of_mass_B).length() + aabb_B.size.length() * 0.5);
+
+	Vector3 relative_motion = (A->get_linear_velocity() - B->get_linear_velocity()) * p_step;
+
+	// Concave shapes are only searched within the swept bounds of the other shape.
+	AABB concave_hint = swap ? aabb_B : aabb_A;
+	concave_hint.merge_with(AABB(concave_hint.position + (swap ? -relative_motion : relative_motion), concave_hint.size));
+	concave_hint.grow_by(sweep_A + sweep_B);
+
+	Vector3 point_1, point_2;
+	if (!GodotCollisionSolver3D::solve_distance(shape_1, xform_1, shape_2, xform_2, point_1, point_2, concave_hint)) {
+		return false;
+	}
+
+	Vector3 point_A = swap ? point_2 : point_1;
+	Vector3 point_B = swap ? point_1 : point_2;
+
+	Vector3 gap = point_B - point_A;
+	real_t distance = gap.length();
+	if (distance < CMP_EPSILON) {
 		return false;
 	}
 
+	Vector3 normal = gap / distance;
+
+	// Conservative advancement: if the shapes can't close the gap within the step, no contact is needed.
+	real_t max_approach = relative_motion.dot(normal) + sweep_A + sweep_B;
+	if (max_approach <= distance) {
+		return true;
+	}
+
+	Contact &c = contacts[0];
+	c = Contact();
+	c.local_A = A->get_inv_transform().basis.xform(point_A);
+	c.local_B = B->get_inv_transform().basis.xform(point_B - offset_B);
+	c.normal = normal;
+	c.used = true;
+	c.speculative = true;
+
+	contact_count = 1;
+	collided = true;
+
 	return true;
 }
 
@@ -381,12 +448,12 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 		Vector3 axis = global_A - global_B;
 		real_t depth = axis.dot(c.normal);
 
-		if (depth <= 0.0) {
+		if (depth <= 0.0 && !c.speculative) {
 			continue;
 		}
 
 #ifdef DEBUG_ENABLED
-		if (space->is_debugging_contacts()) {
+		if (space->is_debugging_contacts() && !c.speculative) {
 			space->add_debug_contact(global_A + offset_A);
 			space->add_debug_contact(global_B + offset_A);
 		}
@@ -402,6 +469,17 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 		kNormal += c.normal.dot(inertia_A.cross(c.rA)) + c.normal.dot(inertia_B.cross(c.rB));
 		c.mass_normal = 1.0f / kNormal;
 
+		if (c.speculative) {
+			// Allow the bodies to approach by the remaining gap, only the excess velocity is removed.
+			// Not reported, warm started or bounced since the bodies are not touching yet.
+			c.bias = 0.0;
+			c.bounce = MAX(-depth, (real_t)0.0) * inv_dt;
+			c.depth = depth;
+			c.active = true;
+			do_process = true;
+			continue;
+		}
+
 		c.bias = -bias * inv_dt * MIN(0.0f, -depth + max_penetration);
 		c.depth = depth;
 
@@ -483,7 +561,7 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 		real_t vbn = dbv.dot(c.normal);
 
-		if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
+		if (!c.speculative && Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
 			real_t jbn = (-vbn + c.bias) * c.mass_normal;
 			real_t jbnOld = c.acc_bias_impulse;
 			c.acc_bias_impulse = MAX(jbnOld + jbn, 0.0f);
@@ -595,18 +673,45 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair3D::get_snapshot_state(SnapshotState &r_state) const {
+	for (int i = 0; i < contact_count; i++) {
+		r_state.contacts[i] = contacts[i];
+	}
+	r_state.contact_count = contact_count;
+	r_state.sep_axis = sep_axis;
+	r_state.collided = collided;
+}
+
+void GodotBodyPair3D::set_snapshot_state(const SnapshotState &p_state) {
+	contact_count = CLAMP(p_state.contact_count, 0, (int)MAX_CONTACTS);
+	for (int i = 0; i < contact_count; i++) {
+		contacts[i] = p_state.contacts[i];
+	}
+	sep_axis = p_state.sep_axis;
+	collided = p_state.collided;
+}
+
+void GodotBodyPair3D::clear_snapshot_state() {
+	contact_count = 0;
+	sep_axis = Vector3();
+	collided = false;
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
-		GodotBodyContact3D(_arr, 2) {
+		GodotBodyContact3D(_arr, 2),
+		body_pair_list(this) {
 	A = p_A;
 	B = p_B;
 	shape_A = p_shape_A;
 	shape_B = p_shape_B;
 	space = A->get_space();
+	space->body_pair_add_to_list(&body_pair_list);
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
 }
 
 GodotBodyPair3D::~GodotBodyPair3D() {
+	space->body_pair_remove_from_list(&body_pair_list);
 	A->remove_constraint(this);
 	B->remove_constraint(this);
 }
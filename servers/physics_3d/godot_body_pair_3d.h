@@ -36,6 +36,7 @@
 #include "godot_soft_body_3d.h"
 
 #include "core/templates/local_vector.h"
+#include "core/templates/self_list.h"
 
 class GodotBodyContact3D : public GodotConstraint3D {
 protected:
@@ -56,6 +57,7 @@ protected:
 		real_t depth = 0.0;
 		bool active = false;
 		bool used = false;
+		bool speculative = false; // Separated contact that only limits approach velocity, used by continuous collision detection.
 		Vector3 rA, rB; // Offset in world orientation with respect to center of mass
 	};
 
@@ -97,14 +99,34 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	SelfList<GodotBodyPair3D> body_pair_list;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
+	bool _setup_speculative_contact(real_t p_step, const GodotShape3D *p_shape_A, const Transform3D &p_xform_A, const GodotShape3D *p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	// Cached contacts used for warm starting, saved and restored by space snapshots.
+	struct SnapshotState {
+		Contact contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		Vector3 sep_axis;
+		bool collided = false;
+	};
+
+	_FORCE_INLINE_ GodotBody3D *get_body_A() const { return A; }
+	_FORCE_INLINE_ GodotBody3D *get_body_B() const { return B; }
+	_FORCE_INLINE_ int get_shape_A() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_B() const { return shape_B; }
+
+	void get_snapshot_state(SnapshotState &r_state) const;
+	void set_snapshot_state(const SnapshotState &p_state);
+	void clear_snapshot_state();
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
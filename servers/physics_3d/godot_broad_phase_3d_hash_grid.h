@@ -0,0 +1,127 @@
+/**************************************************************************/
+/*  godot_broad_phase_3d_hash_grid.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_BROAD_PHASE_3D_HASH_GRID_H
+#define GODOT_BROAD_PHASE_3D_HASH_GRID_H
+
+#include "godot_broad_phase_3d.h"
+
+#include "core/math/vector3i.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/paged_allocator.h"
+
+// Uniform spatial hash grid. Cheaper than the BVH to update when there are many
+// moving objects of similar size, as moving only touches the cells around them.
+// Objects spanning too many cells are kept in a separate list instead.
+class GodotBroadPhase3DHashGrid : public GodotBroadPhase3D {
+	struct Element;
+
+	struct PairLink {
+		Element *other = nullptr;
+		void *data = nullptr;
+	};
+
+	struct Element {
+		ID self = 0;
+		GodotCollisionObject3D *owner = nullptr;
+		int subindex = 0;
+		bool _static = false;
+		bool large = false;
+		bool changed = false;
+		bool full_check = false;
+		AABB aabb;
+		Vector3i cell_from;
+		Vector3i cell_to;
+		LocalVector<PairLink> pairs;
+	};
+
+	PagedAllocator<Element> element_allocator;
+	HashMap<ID, Element *> element_map;
+	HashMap<Vector3i, LocalVector<Element *>> cells;
+	LocalVector<Element *> large_elements;
+	LocalVector<Element *> changed_elements;
+
+	ID current = 0;
+
+	real_t cell_size = 4.0;
+	real_t inv_cell_size = 0.25;
+	uint32_t large_object_threshold = 512;
+
+	PairCallback pair_callback = nullptr;
+	void *pair_userdata = nullptr;
+	UnpairCallback unpair_callback = nullptr;
+	void *unpair_userdata = nullptr;
+
+	bool _get_cell_range(const AABB &p_aabb, Vector3i &r_from, Vector3i &r_to) const;
+	void _enter_grid(Element *p_elem);
+	void _exit_grid(Element *p_elem);
+	void _mark_changed(Element *p_elem, bool p_full_check);
+
+	// Elements spanning several cells are only visited from the first cell they share with the searched range.
+	_FORCE_INLINE_ static bool _is_first_shared_cell(const Element *p_elem, const Vector3i &p_range_from, const Vector3i &p_cell) {
+		return p_cell == p_elem->cell_from.max(p_range_from);
+	}
+
+	_FORCE_INLINE_ bool _can_pair(const Element *p_elem_A, const Element *p_elem_B) const;
+	_FORCE_INLINE_ bool _is_paired(const Element *p_elem_A, const Element *p_elem_B) const;
+	void _pair(Element *p_elem_A, Element *p_elem_B);
+	void _unpair(Element *p_elem_A, Element *p_elem_B);
+	void _check_pair(Element *p_elem, Element *p_other);
+
+	template <class Tester>
+	int _cull(const AABB &p_aabb, const Tester &p_tester, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices) const;
+
+public:
+	// 0 is an invalid ID
+	virtual ID create(GodotCollisionObject3D *p_object, int p_subindex = 0, const AABB &p_aabb = AABB(), bool p_static = false) override;
+	virtual void move(ID p_id, const AABB &p_aabb) override;
+	virtual void set_static(ID p_id, bool p_static) override;
+	virtual void remove(ID p_id) override;
+
+	virtual GodotCollisionObject3D *get_object(ID p_id) const override;
+	virtual bool is_static(ID p_id) const override;
+	virtual int get_subindex(ID p_id) const override;
+
+	virtual int cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+
+	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) override;
+	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
+
+	virtual void update() override;
+
+	static GodotBroadPhase3D *_create();
+	GodotBroadPhase3DHashGrid();
+	~GodotBroadPhase3DHashGrid();
+};
+
+#endif // GODOT_BROAD_PHASE_3D_HASH_GRID_H
@@ -182,7 +182,7 @@ void GodotCollisionObject3D::_update_shapes() {
 	}
 }
 
-void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion) {
+void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion, real_t p_angular_motion) {
 	if (!space) {
 		return;
 	}
@@ -198,6 +198,11 @@ void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion)
 		Transform3D xform = transform * s.xform;
 		shape_aabb = xform.xform(shape_aabb);
 		shape_aabb.merge_with(AABB(shape_aabb.position + p_motion, shape_aabb.size)); //use motion
+		if (p_angular_motion > 0.0) {
+			// Points can't travel further than the rotation arc (or the diameter) around the origin.
+			real_t radius = (xform.origin - transform.origin).length() + s.shape->get_aabb().size.length() * 0.5;
+			shape_aabb.grow_by(MIN(p_angular_motion, (real_t)2.0) * radius);
+		}
 		s.aabb_cache = shape_aabb;
 
 		if (s.bpid == 0) {
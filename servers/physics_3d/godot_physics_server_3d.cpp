@@ -32,12 +32,14 @@
 
 #include "godot_body_direct_state_3d.h"
 #include "godot_broad_phase_3d_bvh.h"
+#include "godot_broad_phase_3d_hash_grid.h"
 #include "joints/godot_cone_twist_joint_3d.h"
 #include "joints/godot_generic_6dof_joint_3d.h"
 #include "joints/godot_hinge_joint_3d.h"
 #include "joints/godot_pin_joint_3d.h"
 #include "joints/godot_slider_joint_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
 #include "core/os/os.h"
 
@@ -214,6 +216,27 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+double GodotPhysicsServer3D::space_get_last_step_time(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0.0);
+	return USEC_TO_SEC(space->get_last_step_time_usec());
+}
+
+PackedByteArray GodotPhysicsServer3D::space_save_state(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+	ERR_FAIL_COND_V_MSG(space->is_locked(), PackedByteArray(), "Space state can't be saved while the space is being stepped.");
+
+	return space->save_state();
+}
+
+void GodotPhysicsServer3D::space_restore_state(RID p_space, const PackedByteArray &p_state) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+
+	space->restore_state(p_state);
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -1641,7 +1664,34 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	active_objects = 0;
 	collision_pairs = 0;
 	for (const GodotSpace3D *E : active_spaces) {
-		stepper->step(const_cast<GodotSpace3D *>(E), p_step);
+		GodotSpace3D *space = const_cast<GodotSpace3D *>(E);
+		int ticks_since_step = space->advance_tick();
+		if (ticks_since_step == 0) {
+			uint64_t step_begin = OS::get_singleton()->get_ticks_usec();
+
+			// Spaces using a tick divisor cover all the ticks they skipped in one go,
+			// forces applied on each of those ticks only act for the duration of one tick.
+			int substeps = space->get_substeps();
+			int tick_divisor = space->get_tick_divisor();
+			real_t substep = p_step * tick_divisor / substeps;
+			space->set_applied_force_scale(1.0 / tick_divisor);
+			for (int i = 0; i < substeps; i++) {
+				space->set_last_substep(i == substeps - 1);
+				stepper->step(space, substep);
+
+				// The last substep calls back from flush_queries(). With threads, script callbacks
+				// can't run from the step, so they only happen once per tick.
+				if (i < substeps - 1 && !using_threads) {
+					flushing_queries = true;
+					space->call_force_integration_callbacks();
+					flushing_queries = false;
+				}
+			}
+
+			space->set_last_step_time_usec(OS::get_singleton()->get_ticks_usec() - step_begin);
+		} else {
+			space->extrapolate_body_states(p_step * ticks_since_step);
+		}
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
@@ -1773,7 +1823,11 @@ void GodotPhysicsServer3D::_shape_col_cbk(const Vector3 &p_point_A, int p_index_
 GodotPhysicsServer3D *GodotPhysicsServer3D::godot_singleton = nullptr;
 GodotPhysicsServer3D::GodotPhysicsServer3D(bool p_using_threads) {
 	godot_singleton = this;
-	GodotBroadPhase3D::create_func = GodotBroadPhase3DBVH::_create;
+	if (int(GLOBAL_GET("physics/3d/broadphase/type")) == GodotBroadPhase3D::TYPE_HASH_GRID) {
+		GodotBroadPhase3D::create_func = GodotBroadPhase3DHashGrid::_create;
+	} else {
+		GodotBroadPhase3D::create_func = GodotBroadPhase3DBVH::_create;
+	}
 
 	using_threads = p_using_threads;
 };
@@ -117,6 +117,11 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual double space_get_last_step_time(RID p_space) const override;
+
+	virtual PackedByteArray space_save_state(RID p_space) const override;
+	virtual void space_restore_state(RID p_space, const PackedByteArray &p_state) override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
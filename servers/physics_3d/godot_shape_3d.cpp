@@ -1690,7 +1690,22 @@ GodotConcavePolygonShape3D::GodotConcavePolygonShape3D() {
 /* HEIGHT MAP SHAPE */
 
 Vector<real_t> GodotHeightMapShape3D::get_heights() const {
-	return heights;
+	if (compressed_heights.is_empty()) {
+		return heights;
+	}
+
+	Vector<real_t> decompressed;
+	decompressed.resize(compressed_heights.size());
+	real_t *w = decompressed.ptrw();
+	const uint16_t *r = compressed_heights.ptr();
+	for (int i = 0; i < compressed_heights.size(); i++) {
+		w[i] = compressed_min_height + r[i] * compressed_height_step;
+	}
+	return decompressed;
+}
+
+bool GodotHeightMapShape3D::is_compressed() const {
+	return !compressed_heights.is_empty();
 }
 
 int GodotHeightMapShape3D::get_width() const {
@@ -1749,6 +1764,22 @@ _FORCE_INLINE_ bool _heightmap_face_cull_segment(_HeightmapSegmentCullParams &p_
 }
 
 _FORCE_INLINE_ bool _heightmap_cell_cull_segment(_HeightmapSegmentCullParams &p_params, const _HeightmapGridCullState &p_state) {
+	if (p_state.dist > p_state.prev_dist && p_state.length_flat > CMP_EPSILON) {
+		// Skip the triangle tests when the segment passes fully above or below the cell.
+		GodotHeightMapShape3D::Range cell;
+		p_params.heightmap->_get_cell_range(p_state.x, p_state.z, cell);
+
+		real_t flat_to_3d = p_state.length / p_state.length_flat;
+		real_t enter_y = p_params.from.y + p_params.dir.y * p_state.prev_dist * flat_to_3d;
+		real_t exit_y = p_params.from.y + p_params.dir.y * p_state.dist * flat_to_3d;
+		if ((enter_y > cell.max) && (exit_y > cell.max)) {
+			return false;
+		}
+		if ((enter_y < cell.min) && (exit_y < cell.min)) {
+			return false;
+		}
+	}
+
 	// First triangle.
 	p_params.heightmap->_get_point(p_state.x, p_state.z, p_params.face->vertex[0]);
 	p_params.heightmap->_get_point(p_state.x + 1, p_state.z, p_params.face->vertex[1]);
@@ -1946,7 +1977,7 @@ bool GodotHeightMapShape3D::_intersect_grid_segment(ProcessFunction &p_process,
 }
 
 bool GodotHeightMapShape3D::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal, int &r_face_index, bool p_hit_back_faces) const {
-	if (heights.is_empty()) {
+	if (!_has_heights()) {
 		return false;
 	}
 
@@ -2026,7 +2057,7 @@ void GodotHeightMapShape3D::_get_cell(const Vector3 &p_point, int &r_x, int &r_y
 }
 
 void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
-	if (heights.is_empty()) {
+	if (!_has_heights()) {
 		return;
 	}
 
@@ -2051,27 +2082,59 @@ void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callb
 	int start_z = MAX(0, aabb_min[2]);
 	int end_z = MIN(depth - 1, aabb_max[2]);
 
+	const real_t min_y = local_aabb.position.y;
+	const real_t max_y = local_aabb.position.y + local_aabb.size.y;
+
 	GodotFaceShape3D face;
 	face.backface_collision = !p_invert_backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
-	for (int z = start_z; z < end_z; z++) {
-		for (int x = start_x; x < end_x; x++) {
-			// First triangle.
-			_get_point(x, z, face.vertex[0]);
-			_get_point(x + 1, z, face.vertex[1]);
-			_get_point(x, z + 1, face.vertex[2]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
+	// Walk the cells chunk by chunk, so that chunks entirely above or below
+	// the queried AABB (the common case for bodies resting on terrain) are skipped.
+	const int chunk_size = bounds_grid.is_empty() ? MAX(end_x - start_x, end_z - start_z) : BOUNDS_CHUNK_SIZE;
+	if (chunk_size <= 0) {
+		return;
+	}
+
+	for (int chunk_z = start_z / chunk_size; chunk_z * chunk_size < end_z; chunk_z++) {
+		for (int chunk_x = start_x / chunk_size; chunk_x * chunk_size < end_x; chunk_x++) {
+			if (!bounds_grid.is_empty()) {
+				const Range &chunk = _get_bounds_chunk(chunk_x, chunk_z);
+				if (chunk.max < min_y || chunk.min > max_y) {
+					continue;
+				}
 			}
 
-			// Second triangle.
-			face.vertex[0] = face.vertex[1];
-			_get_point(x + 1, z + 1, face.vertex[1]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
+			int cell_start_z = MAX(start_z, chunk_z * chunk_size);
+			int cell_end_z = MIN(end_z, (chunk_z + 1) * chunk_size);
+			int cell_start_x = MAX(start_x, chunk_x * chunk_size);
+			int cell_end_x = MIN(end_x, (chunk_x + 1) * chunk_size);
+
+			for (int z = cell_start_z; z < cell_end_z; z++) {
+				for (int x = cell_start_x; x < cell_end_x; x++) {
+					Range cell;
+					_get_cell_range(x, z, cell);
+					if (cell.max < min_y || cell.min > max_y) {
+						continue;
+					}
+
+					// First triangle.
+					_get_point(x, z, face.vertex[0]);
+					_get_point(x + 1, z, face.vertex[1]);
+					_get_point(x, z + 1, face.vertex[2]);
+					face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
+					if (p_callback(p_userdata, &face)) {
+						return;
+					}
+
+					// Second triangle.
+					face.vertex[0] = face.vertex[1];
+					_get_point(x + 1, z + 1, face.vertex[1]);
+					face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
+					if (p_callback(p_userdata, &face)) {
+						return;
+					}
+				}
 			}
 		}
 	}
@@ -2112,55 +2175,83 @@ void GodotHeightMapShape3D::_build_accelerator() {
 
 	// Compute min and max height for all chunks.
 	for (int cz = 0; cz < bounds_grid_depth; ++cz) {
-		int z0 = cz * BOUNDS_CHUNK_SIZE;
-
 		for (int cx = 0; cx < bounds_grid_width; ++cx) {
-			int x0 = cx * BOUNDS_CHUNK_SIZE;
-
-			Range r;
-
-			r.min = _get_height(x0, z0);
-			r.max = r.min;
-
-			// Compute min and max height for this chunk.
-			// We have to include one extra cell to account for neighbors.
-			// Here is why:
-			// Say we have a flat terrain, and a plateau that fits a chunk perfectly.
-			//
-			//   Left        Right
-			// 0---0---0---1---1---1
-			// |   |   |   |   |   |
-			// 0---0---0---1---1---1
-			// |   |   |   |   |   |
-			// 0---0---0---1---1---1
-			//           x
-			//
-			// If the AABB for the Left chunk did not share vertices with the Right,
-			// then we would fail collision tests at x due to a gap.
-			//
-			int z_max = MIN(z0 + BOUNDS_CHUNK_SIZE + 1, depth);
-			int x_max = MIN(x0 + BOUNDS_CHUNK_SIZE + 1, width);
-			for (int z = z0; z < z_max; ++z) {
-				for (int x = x0; x < x_max; ++x) {
-					real_t height = _get_height(x, z);
-					if (height < r.min) {
-						r.min = height;
-					} else if (height > r.max) {
-						r.max = height;
-					}
-				}
-			}
+			_update_bounds_chunk(cx, cz);
+		}
+	}
+}
 
-			bounds_grid[cx + cz * bounds_grid_width] = r;
+void GodotHeightMapShape3D::_update_bounds_chunk(int p_chunk_x, int p_chunk_z) {
+	int x0 = p_chunk_x * BOUNDS_CHUNK_SIZE;
+	int z0 = p_chunk_z * BOUNDS_CHUNK_SIZE;
+
+	Range r;
+
+	r.min = _get_height(x0, z0);
+	r.max = r.min;
+
+	// Compute min and max height for this chunk.
+	// We have to include one extra cell to account for neighbors.
+	// Here is why:
+	// Say we have a flat terrain, and a plateau that fits a chunk perfectly.
+	//
+	//   Left        Right
+	// 0---0---0---1---1---1
+	// |   |   |   |   |   |
+	// 0---0---0---1---1---1
+	// |   |   |   |   |   |
+	// 0---0---0---1---1---1
+	//           x
+	//
+	// If the AABB for the Left chunk did not share vertices with the Right,
+	// then we would fail collision tests at x due to a gap.
+	//
+	int z_max = MIN(z0 + BOUNDS_CHUNK_SIZE + 1, depth);
+	int x_max = MIN(x0 + BOUNDS_CHUNK_SIZE + 1, width);
+	for (int z = z0; z < z_max; ++z) {
+		for (int x = x0; x < x_max; ++x) {
+			real_t height = _get_height(x, z);
+			if (height < r.min) {
+				r.min = height;
+			} else if (height > r.max) {
+				r.max = height;
+			}
 		}
 	}
+
+	bounds_grid[p_chunk_x + p_chunk_z * bounds_grid_width] = r;
+}
+
+void GodotHeightMapShape3D::_compress_heights(real_t p_min_height, real_t p_max_height) {
+	compressed_min_height = p_min_height;
+	compressed_height_step = (p_max_height - p_min_height) / UINT16_MAX;
+	const real_t inv_step = compressed_height_step > 0.0 ? 1.0 / compressed_height_step : 0.0;
+
+	compressed_heights.resize(heights.size());
+	uint16_t *w = compressed_heights.ptrw();
+	const real_t *r = heights.ptr();
+	for (int i = 0; i < heights.size(); i++) {
+		w[i] = (uint16_t)CLAMP(Math::round((r[i] - p_min_height) * inv_step), 0, UINT16_MAX);
+	}
+
+	heights.clear();
 }
 
-void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height) {
+void GodotHeightMapShape3D::_decompress_heights() {
+	heights = get_heights();
+	compressed_heights.clear();
+}
+
+void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height, bool p_compressed) {
 	heights = p_heights;
 	width = p_width;
 	depth = p_depth;
 
+	compressed_heights.clear();
+	if (p_compressed) {
+		_compress_heights(p_min_height, p_max_height);
+	}
+
 	// Initialize aabb.
 	AABB aabb_new;
 	aabb_new.position = Vector3(0.0, p_min_height, 0.0);
@@ -2177,13 +2268,93 @@ void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width,
 	configure(aabb_new);
 }
 
+void GodotHeightMapShape3D::_update_region(const Vector<real_t> &p_heights, const Rect2i &p_region) {
+	ERR_FAIL_COND_MSG(!_has_heights(), "Heightmap regions can only be updated once the full heightmap was set.");
+	ERR_FAIL_COND(p_region.position.x < 0 || p_region.position.y < 0 || p_region.size.x <= 0 || p_region.size.y <= 0);
+	ERR_FAIL_COND(p_region.position.x + p_region.size.x > width || p_region.position.y + p_region.size.y > depth);
+	ERR_FAIL_COND(p_heights.size() != p_region.size.x * p_region.size.y);
+
+	const AABB &shape_aabb = get_aabb();
+	real_t min_height = shape_aabb.position.y;
+	real_t max_height = shape_aabb.position.y + shape_aabb.size.y;
+
+	real_t region_min = p_heights[0];
+	real_t region_max = p_heights[0];
+	const real_t *r = p_heights.ptr();
+	for (int i = 1; i < p_heights.size(); i++) {
+		region_min = MIN(region_min, r[i]);
+		region_max = MAX(region_max, r[i]);
+	}
+
+	// Heights outside of the current range need the whole map to be requantized.
+	bool compressed = is_compressed();
+	bool range_changed = region_min < min_height || region_max > max_height;
+	if (compressed && range_changed) {
+		_decompress_heights();
+	}
+	min_height = MIN(min_height, region_min);
+	max_height = MAX(max_height, region_max);
+
+	if (is_compressed()) {
+		const real_t inv_step = compressed_height_step > 0.0 ? 1.0 / compressed_height_step : 0.0;
+		uint16_t *w = compressed_heights.ptrw();
+		for (int z = 0; z < p_region.size.y; z++) {
+			for (int x = 0; x < p_region.size.x; x++) {
+				real_t height = r[z * p_region.size.x + x];
+				w[(p_region.position.y + z) * width + p_region.position.x + x] = (uint16_t)CLAMP(Math::round((height - compressed_min_height) * inv_step), 0, UINT16_MAX);
+			}
+		}
+	} else {
+		real_t *w = heights.ptrw();
+		for (int z = 0; z < p_region.size.y; z++) {
+			memcpy(w + (p_region.position.y + z) * width + p_region.position.x, r + z * p_region.size.x, p_region.size.x * sizeof(real_t));
+		}
+	}
+
+	if (compressed && range_changed) {
+		_compress_heights(min_height, max_height);
+	}
+
+	if (!bounds_grid.is_empty()) {
+		if (compressed && range_changed) {
+			_build_accelerator();
+		} else {
+			// Chunks share their border vertices with the previous chunk, see _update_bounds_chunk().
+			int chunk_start_x = MAX(p_region.position.x - 1, 0) / BOUNDS_CHUNK_SIZE;
+			int chunk_start_z = MAX(p_region.position.y - 1, 0) / BOUNDS_CHUNK_SIZE;
+			int chunk_end_x = MIN((p_region.position.x + p_region.size.x - 1) / BOUNDS_CHUNK_SIZE, bounds_grid_width - 1);
+			int chunk_end_z = MIN((p_region.position.y + p_region.size.y - 1) / BOUNDS_CHUNK_SIZE, bounds_grid_depth - 1);
+			for (int cz = chunk_start_z; cz <= chunk_end_z; cz++) {
+				for (int cx = chunk_start_x; cx <= chunk_end_x; cx++) {
+					_update_bounds_chunk(cx, cz);
+				}
+			}
+		}
+	}
+
+	if (range_changed) {
+		AABB aabb_new = shape_aabb;
+		aabb_new.position.y = min_height;
+		aabb_new.size.y = max_height - min_height;
+		configure(aabb_new);
+	}
+}
+
 void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 	ERR_FAIL_COND(p_data.get_type() != Variant::DICTIONARY);
 
 	Dictionary d = p_data;
+	ERR_FAIL_COND(!d.has("heights"));
+
+	if (d.has("region")) {
+		// Partial update of an existing heightmap, e.g. when streaming terrain tiles.
+		Vector<real_t> region_heights = d["heights"];
+		_update_region(region_heights, d["region"]);
+		return;
+	}
+
 	ERR_FAIL_COND(!d.has("width"));
 	ERR_FAIL_COND(!d.has("depth"));
-	ERR_FAIL_COND(!d.has("heights"));
 
 	int width_new = d["width"];
 	int depth_new = d["depth"];
@@ -2230,9 +2401,9 @@ void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 		min_height = d["min_height"];
 		max_height = d["max_height"];
 	} else {
-		int heights_size = heights.size();
+		int heights_size = heights_buffer.size();
 		for (int i = 0; i < heights_size; ++i) {
-			real_t h = heights[i];
+			real_t h = heights_buffer[i];
 			if (h < min_height) {
 				min_height = h;
 			} else if (h > max_height) {
@@ -2245,8 +2416,10 @@ void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 
 	ERR_FAIL_COND(heights_buffer.size() != (width_new * depth_new));
 
+	bool compressed = d.get("compressed", false);
+
 	// If specified, min and max height will be used as precomputed values.
-	_setup(heights_buffer, width_new, depth_new, min_height, max_height);
+	_setup(heights_buffer, width_new, depth_new, min_height, max_height, compressed);
 }
 
 Variant GodotHeightMapShape3D::get_data() const {
@@ -2258,7 +2431,8 @@ Variant GodotHeightMapShape3D::get_data() const {
 	d["min_height"] = shape_aabb.position.y;
 	d["max_height"] = shape_aabb.position.y + shape_aabb.size.y;
 
-	d["heights"] = heights;
+	d["heights"] = get_heights();
+	d["compressed"] = is_compressed();
 
 	return d;
 }
@@ -389,6 +389,11 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 	int depth = 0;
 	Vector3 local_origin;
 
+	// Heights quantized to 16 bits, used instead of `heights` when compression is enabled.
+	Vector<uint16_t> compressed_heights;
+	real_t compressed_min_height = 0.0;
+	real_t compressed_height_step = 0.0;
+
 	// Accelerator.
 	struct Range {
 		real_t min = 0.0;
@@ -405,9 +410,25 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 	}
 
 	_FORCE_INLINE_ real_t _get_height(int p_x, int p_z) const {
+		if (!compressed_heights.is_empty()) {
+			return compressed_min_height + compressed_heights[(p_z * width) + p_x] * compressed_height_step;
+		}
 		return heights[(p_z * width) + p_x];
 	}
 
+	_FORCE_INLINE_ bool _has_heights() const {
+		return !heights.is_empty() || !compressed_heights.is_empty();
+	}
+
+	_FORCE_INLINE_ void _get_cell_range(int p_x, int p_z, Range &r_range) const {
+		real_t h00 = _get_height(p_x, p_z);
+		real_t h10 = _get_height(p_x + 1, p_z);
+		real_t h01 = _get_height(p_x, p_z + 1);
+		real_t h11 = _get_height(p_x + 1, p_z + 1);
+		r_range.min = MIN(MIN(h00, h10), MIN(h01, h11));
+		r_range.max = MAX(MAX(h00, h10), MAX(h01, h11));
+	}
+
 	_FORCE_INLINE_ void _get_point(int p_x, int p_z, Vector3 &r_point) const {
 		r_point.x = p_x - 0.5 * (width - 1.0);
 		r_point.y = _get_height(p_x, p_z);
@@ -417,16 +438,22 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 	void _get_cell(const Vector3 &p_point, int &r_x, int &r_y, int &r_z) const;
 
 	void _build_accelerator();
+	void _update_bounds_chunk(int p_chunk_x, int p_chunk_z);
+
+	void _compress_heights(real_t p_min_height, real_t p_max_height);
+	void _decompress_heights();
 
 	template <typename ProcessFunction>
 	bool _intersect_grid_segment(ProcessFunction &p_process, const Vector3 &p_begin, const Vector3 &p_end, int p_width, int p_depth, const Vector3 &offset, Vector3 &r_point, Vector3 &r_normal) const;
 
-	void _setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height);
+	void _setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height, bool p_compressed);
+	void _update_region(const Vector<real_t> &p_heights, const Rect2i &p_region);
 
 public:
 	Vector<real_t> get_heights() const;
 	int get_width() const;
 	int get_depth() const;
+	bool is_compressed() const;
 
 	virtual PhysicsServer3D::ShapeType get_type() const override { return PhysicsServer3D::SHAPE_HEIGHTMAP; }
 
@@ -1027,6 +1027,204 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 	return collided;
 }
 
+// Snapshots are raw copies of the simulation state and are only meant to be
+// restored by the same build, the header rejects buffers with another layout.
+#define SPACE_SNAPSHOT_MAGIC_3D 0x33505347 // "GSP3"
+#define SPACE_SNAPSHOT_VERSION_3D 2
+
+struct SpaceSnapshotHeader3D {
+	uint32_t magic = SPACE_SNAPSHOT_MAGIC_3D;
+	uint32_t version = SPACE_SNAPSHOT_VERSION_3D;
+	uint32_t real_size = sizeof(real_t);
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+};
+
+struct SpaceSnapshotBody3D {
+	uint64_t rid = 0;
+	GodotBody3D::SnapshotState state;
+};
+
+struct SpaceSnapshotPair3D {
+	uint64_t rid_A = 0;
+	uint64_t rid_B = 0;
+	int32_t shape_A = 0;
+	int32_t shape_B = 0;
+	GodotBodyPair3D::SnapshotState state;
+};
+
+struct SpaceSnapshotPairKey3D {
+	uint64_t rid_A = 0;
+	uint64_t rid_B = 0;
+	int32_t shape_A = 0;
+	int32_t shape_B = 0;
+
+	static uint32_t hash(const SpaceSnapshotPairKey3D &p_key) {
+		uint32_t h = hash_murmur3_one_64(p_key.rid_A);
+		h = hash_murmur3_one_64(p_key.rid_B, h);
+		h = hash_murmur3_one_32(p_key.shape_A, h);
+		h = hash_murmur3_one_32(p_key.shape_B, h);
+		return hash_fmix32(h);
+	}
+
+	bool operator==(const SpaceSnapshotPairKey3D &p_key) const {
+		return rid_A == p_key.rid_A && rid_B == p_key.rid_B && shape_A == p_key.shape_A && shape_B == p_key.shape_B;
+	}
+
+	SpaceSnapshotPairKey3D() {}
+	SpaceSnapshotPairKey3D(const GodotBodyPair3D *p_pair) :
+			rid_A(p_pair->get_body_A()->get_self().get_id()),
+			rid_B(p_pair->get_body_B()->get_self().get_id()),
+			shape_A(p_pair->get_shape_A()),
+			shape_B(p_pair->get_shape_B()) {}
+	SpaceSnapshotPairKey3D(const SpaceSnapshotPair3D &p_record) :
+			rid_A(p_record.rid_A),
+			rid_B(p_record.rid_B),
+			shape_A(p_record.shape_A),
+			shape_B(p_record.shape_B) {}
+};
+
+Vector<uint8_t> GodotSpace3D::save_state() const {
+	SpaceSnapshotHeader3D header;
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			header.body_count++;
+		}
+	}
+	for (const SelfList<GodotBodyPair3D> *E = body_pair_list.first(); E; E = E->next()) {
+		header.pair_count++;
+	}
+
+	Vector<uint8_t> state;
+	state.resize(sizeof(SpaceSnapshotHeader3D) + header.body_count * sizeof(SpaceSnapshotBody3D) + header.pair_count * sizeof(SpaceSnapshotPair3D));
+	uint8_t *w = state.ptrw();
+
+	memcpy(w, &header, sizeof(SpaceSnapshotHeader3D));
+	w += sizeof(SpaceSnapshotHeader3D);
+
+	SpaceSnapshotBody3D body_record;
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(E);
+		body_record.rid = body->get_self().get_id();
+		body->get_snapshot_state(body_record.state);
+		memcpy(w, &body_record, sizeof(SpaceSnapshotBody3D));
+		w += sizeof(SpaceSnapshotBody3D);
+	}
+
+	SpaceSnapshotPair3D pair_record;
+	for (const SelfList<GodotBodyPair3D> *E = body_pair_list.first(); E; E = E->next()) {
+		const GodotBodyPair3D *pair = E->self();
+		pair_record.rid_A = pair->get_body_A()->get_self().get_id();
+		pair_record.rid_B = pair->get_body_B()->get_self().get_id();
+		pair_record.shape_A = pair->get_shape_A();
+		pair_record.shape_B = pair->get_shape_B();
+		pair->get_snapshot_state(pair_record.state);
+		memcpy(w, &pair_record, sizeof(SpaceSnapshotPair3D));
+		w += sizeof(SpaceSnapshotPair3D);
+	}
+
+	return state;
+}
+
+bool GodotSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, false, "Space state can't be restored while the space is being stepped.");
+	ERR_FAIL_COND_V((uint64_t)p_state.size() < sizeof(SpaceSnapshotHeader3D), false);
+
+	const uint8_t *r = p_state.ptr();
+	SpaceSnapshotHeader3D header;
+	memcpy(&header, r, sizeof(SpaceSnapshotHeader3D));
+	r += sizeof(SpaceSnapshotHeader3D);
+
+	ERR_FAIL_COND_V_MSG(header.magic != SPACE_SNAPSHOT_MAGIC_3D || header.version != SPACE_SNAPSHOT_VERSION_3D || header.real_size != sizeof(real_t), false, "Invalid or incompatible 3D physics space state.");
+	ERR_FAIL_COND_V((uint64_t)p_state.size() != sizeof(SpaceSnapshotHeader3D) + header.body_count * sizeof(SpaceSnapshotBody3D) + header.pair_count * sizeof(SpaceSnapshotPair3D), false);
+
+	const uint8_t *body_data = r;
+	const uint8_t *pair_data = r + header.body_count * sizeof(SpaceSnapshotBody3D);
+
+	// Objects are usually the same ones that existed when saving (and iterate in the same order),
+	// so records are matched in sequence and only fall back to a lookup table when that fails.
+	SpaceSnapshotBody3D body_record;
+	uint32_t body_index = 0;
+	bool bodies_in_order = true;
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		GodotBody3D *body = static_cast<GodotBody3D *>(E);
+		if (body_index < header.body_count) {
+			memcpy(&body_record, body_data + body_index * sizeof(SpaceSnapshotBody3D), sizeof(SpaceSnapshotBody3D));
+			if (body_record.rid == body->get_self().get_id()) {
+				body->set_snapshot_state(body_record.state);
+				body_index++;
+				continue;
+			}
+		}
+		bodies_in_order = false;
+		break;
+	}
+
+	if (!bodies_in_order) {
+		HashMap<uint64_t, uint32_t> body_records;
+		body_records.reserve(header.body_count);
+		for (uint32_t i = 0; i < header.body_count; i++) {
+			memcpy(&body_record.rid, body_data + i * sizeof(SpaceSnapshotBody3D), sizeof(uint64_t));
+			body_records.insert(body_record.rid, i);
+		}
+		for (GodotCollisionObject3D *E : objects) {
+			if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+				continue;
+			}
+			// Bodies added after the state was saved are left untouched.
+			GodotBody3D *body = static_cast<GodotBody3D *>(E);
+			HashMap<uint64_t, uint32_t>::ConstIterator F = body_records.find(body->get_self().get_id());
+			if (F) {
+				memcpy(&body_record, body_data + F->value * sizeof(SpaceSnapshotBody3D), sizeof(SpaceSnapshotBody3D));
+				body->set_snapshot_state(body_record.state);
+			}
+		}
+	}
+
+	// Contact caches are restored for pairs that still exist, pairs created since then lose
+	// their warm starting data and pairs that disappeared are regenerated by the next step.
+	SpaceSnapshotPair3D pair_record;
+	uint32_t pair_index = 0;
+	SelfList<GodotBodyPair3D> *pair_element = body_pair_list.first();
+	while (pair_element && pair_index < header.pair_count) {
+		GodotBodyPair3D *pair = pair_element->self();
+		memcpy(&pair_record, pair_data + pair_index * sizeof(SpaceSnapshotPair3D), sizeof(SpaceSnapshotPair3D));
+		if (!(SpaceSnapshotPairKey3D(pair) == SpaceSnapshotPairKey3D(pair_record))) {
+			break;
+		}
+		pair->set_snapshot_state(pair_record.state);
+		pair_index++;
+		pair_element = pair_element->next();
+	}
+
+	if (pair_element) {
+		HashMap<SpaceSnapshotPairKey3D, uint32_t, SpaceSnapshotPairKey3D> pair_records;
+		pair_records.reserve(header.pair_count - pair_index);
+		for (uint32_t i = pair_index; i < header.pair_count; i++) {
+			memcpy(&pair_record, pair_data + i * sizeof(SpaceSnapshotPair3D), sizeof(SpaceSnapshotPair3D));
+			pair_records.insert(SpaceSnapshotPairKey3D(pair_record), i);
+		}
+		for (; pair_element; pair_element = pair_element->next()) {
+			GodotBodyPair3D *pair = pair_element->self();
+			HashMap<SpaceSnapshotPairKey3D, uint32_t, SpaceSnapshotPairKey3D>::ConstIterator F = pair_records.find(SpaceSnapshotPairKey3D(pair));
+			if (F) {
+				memcpy(&pair_record, pair_data + F->value * sizeof(SpaceSnapshotPair3D), sizeof(SpaceSnapshotPair3D));
+				pair->set_snapshot_state(pair_record.state);
+			} else {
+				pair->clear_snapshot_state();
+			}
+		}
+	}
+
+	return true;
+}
+
 // Assumes a valid collision pair, this should have been checked beforehand in the BVH or octree.
 void *GodotSpace3D::_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self) {
 	GodotCollisionObject3D::Type type_A = A->get_type();
@@ -1160,6 +1358,14 @@ void GodotSpace3D::soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *
 	active_soft_body_list.remove(p_soft_body);
 }
 
+void GodotSpace3D::body_pair_add_to_list(SelfList<GodotBodyPair3D> *p_body_pair) {
+	body_pair_list.add(p_body_pair);
+}
+
+void GodotSpace3D::body_pair_remove_from_list(SelfList<GodotBodyPair3D> *p_body_pair) {
+	body_pair_list.remove(p_body_pair);
+}
+
 void GodotSpace3D::call_queries() {
 	while (state_query_list.first()) {
 		GodotBody3D *b = state_query_list.first()->self();
@@ -1212,6 +1418,13 @@ void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_v
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS:
 			solver_iterations = p_value;
 			break;
+		case PhysicsServer3D::SPACE_PARAM_SUBSTEPS:
+			substeps = MAX(1, (int)p_value);
+			break;
+		case PhysicsServer3D::SPACE_PARAM_TICK_DIVISOR:
+			tick_divisor = MAX(1, (int)p_value);
+			tick_count = 0;
+			break;
 	}
 }
 
@@ -1233,10 +1446,39 @@ real_t GodotSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 			return body_time_to_sleep;
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS:
 			return solver_iterations;
+		case PhysicsServer3D::SPACE_PARAM_SUBSTEPS:
+			return substeps;
+		case PhysicsServer3D::SPACE_PARAM_TICK_DIVISOR:
+			return tick_divisor;
 	}
 	return 0;
 }
 
+int GodotSpace3D::advance_tick() {
+	int ticks_since_step = tick_count;
+	tick_count = (tick_count + 1) % tick_divisor;
+	return ticks_since_step;
+}
+
+void GodotSpace3D::extrapolate_body_states(real_t p_time) {
+	for (const SelfList<GodotBody3D> *b = active_list.first(); b; b = b->next()) {
+		b->self()->extrapolate_state(p_time);
+	}
+}
+
+void GodotSpace3D::call_force_integration_callbacks() {
+	// Bodies stay in the query list, their state callbacks are only called once the whole tick is done.
+	const SelfList<GodotBody3D> *b = state_query_list.first();
+	while (b) {
+		const SelfList<GodotBody3D> *next = b->next();
+		GodotBody3D *body = b->self();
+		if (body->has_force_integration_callback()) {
+			body->call_force_integration_callback(body->get_direct_state());
+		}
+		b = next;
+	}
+}
+
 void GodotSpace3D::lock() {
 	locked = true;
 }
@@ -85,6 +85,7 @@ private:
 	SelfList<GodotArea3D>::List monitor_query_list;
 	SelfList<GodotArea3D>::List area_moved_list;
 	SelfList<GodotSoftBody3D>::List active_soft_body_list;
+	SelfList<GodotBodyPair3D>::List body_pair_list;
 
 	static void *_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
@@ -94,6 +95,11 @@ private:
 	GodotArea3D *area = nullptr;
 
 	int solver_iterations = 0;
+	int substeps = 1;
+	int tick_divisor = 1;
+	int tick_count = 0;
+	real_t applied_force_scale = 1.0;
+	bool last_substep = true;
 
 	real_t contact_recycle_radius = 0.0;
 	real_t contact_max_separation = 0.0;
@@ -114,6 +120,7 @@ private:
 	bool locked = false;
 
 	real_t last_step = 0.001;
+	uint64_t last_step_time_usec = 0;
 
 	int island_count = 0;
 	int active_objects = 0;
@@ -154,6 +161,9 @@ public:
 	void soft_body_add_to_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 	void soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 
+	void body_pair_add_to_list(SelfList<GodotBodyPair3D> *p_body_pair);
+	void body_pair_remove_from_list(SelfList<GodotBodyPair3D> *p_body_pair);
+
 	GodotBroadPhase3D *get_broadphase();
 
 	void add_object(GodotCollisionObject3D *p_object);
@@ -161,6 +171,8 @@ public:
 	const HashSet<GodotCollisionObject3D *> &get_objects() const;
 
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
+	_FORCE_INLINE_ int get_substeps() const { return substeps; }
+	_FORCE_INLINE_ int get_tick_divisor() const { return tick_divisor; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
@@ -180,6 +192,19 @@ public:
 	real_t get_last_step() const { return last_step; }
 	void set_last_step(real_t p_step) { last_step = p_step; }
 
+	// Returns the number of ticks elapsed since the last one the space was stepped on, 0 if it must be stepped now.
+	int advance_tick();
+	void extrapolate_body_states(real_t p_time);
+	void call_force_integration_callbacks();
+
+	_FORCE_INLINE_ real_t get_applied_force_scale() const { return applied_force_scale; }
+	void set_applied_force_scale(real_t p_scale) { applied_force_scale = p_scale; }
+	_FORCE_INLINE_ bool is_last_substep() const { return last_substep; }
+	void set_last_substep(bool p_last_substep) { last_substep = p_last_substep; }
+
+	uint64_t get_last_step_time_usec() const { return last_step_time_usec; }
+	void set_last_step_time_usec(uint64_t p_usec) { last_step_time_usec = p_usec; }
+
 	void set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value);
 	real_t get_param(PhysicsServer3D::SpaceParameter p_param) const;
 
@@ -211,6 +236,9 @@ public:
 
 	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
 
+	Vector<uint8_t> save_state() const;
+	bool restore_state(const Vector<uint8_t> &p_state);
+
 	GodotSpace3D();
 	~GodotSpace3D();
 };
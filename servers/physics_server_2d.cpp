@@ -638,6 +638,8 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer2D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer2D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer2D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer2D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer2D::space_restore_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer2D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer2D::area_set_space);
@@ -908,6 +910,9 @@ PhysicsServer2D::PhysicsServer2D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.01,10,0.01,or_greater"), 0.3);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/default_constraint_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.2);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "physics/2d/broadphase/type", PROPERTY_HINT_ENUM, "BVH,Hash Grid"), 0);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::FLOAT, "physics/2d/broadphase/hash_grid_cell_size", PROPERTY_HINT_RANGE, "1,1024,1,or_greater,suffix:px"), 128.0);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "physics/2d/broadphase/hash_grid_large_object_threshold", PROPERTY_HINT_RANGE, "1,4096,1,or_greater"), 512);
 }
 
 PhysicsServer2D::~PhysicsServer2D() {
@@ -276,6 +276,10 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Bulk save/restore of the simulation state, meant for rollback.
+	virtual PackedByteArray space_save_state(RID p_space) const = 0;
+	virtual void space_restore_state(RID p_space, const PackedByteArray &p_state) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
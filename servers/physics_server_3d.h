@@ -294,6 +294,8 @@ public:
 		SPACE_PARAM_BODY_ANGULAR_VELOCITY_SLEEP_THRESHOLD,
 		SPACE_PARAM_BODY_TIME_TO_SLEEP,
 		SPACE_PARAM_SOLVER_ITERATIONS,
+		SPACE_PARAM_SUBSTEPS,
+		SPACE_PARAM_TICK_DIVISOR,
 	};
 
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) = 0;
@@ -306,6 +308,12 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual double space_get_last_step_time(RID p_space) const = 0;
+
+	// Bulk save/restore of the simulation state, meant for rollback.
+	virtual PackedByteArray space_save_state(RID p_space) const = 0;
+	virtual void space_restore_state(RID p_space, const PackedByteArray &p_state) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
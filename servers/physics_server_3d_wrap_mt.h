@@ -119,6 +119,9 @@ public:
 	}
 
 	FUNC2(space_set_debug_contacts, RID, int);
+	FUNC1RC(double, space_get_last_step_time, RID);
+	FUNC1RC(PackedByteArray, space_save_state, RID);
+	FUNC2(space_restore_state, RID, const PackedByteArray &);
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override {
 		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), Vector<Vector3>());
 		return physics_server_3d->space_get_contacts(p_space);
@@ -0,0 +1,399 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const LocalVector<const LocalVector<Triangle> *> &p_triangles, float p_z_far) {
+	if (is_empty()) {
+		return;
+	}
+
+	const int pixel_count = sizes[0].x * sizes[0].y;
+	float *depth = mips[0];
+	for (int i = 0; i < pixel_count; i++) {
+		depth[i] = FLT_MAX;
+	}
+
+	debug_tex_range = p_z_far;
+
+	if (!p_triangles.is_empty()) {
+		RasterThreadData td;
+		td.band_count = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), (uint32_t)sizes[0].y);
+		td.triangles = &p_triangles;
+
+		if (td.band_count > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_band_threaded, &td, td.band_count, -1, true, SNAME("RasterOcclusionCullRasterize"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			_rasterize_band(p_triangles, 0, sizes[0].y);
+		}
+	}
+
+	update_mips();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_band_threaded(uint32_t p_band, const RasterThreadData *p_data) {
+	// Each band owns a range of rows, so no two threads ever write the same pixel.
+	uint32_t total_rows = sizes[0].y;
+	uint32_t from = p_band * total_rows / p_data->band_count;
+	uint32_t to = (p_band + 1 == p_data->band_count) ? total_rows : ((p_band + 1) * total_rows / p_data->band_count);
+	_rasterize_band(*p_data->triangles, from, to);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_band(const LocalVector<const LocalVector<Triangle> *> &p_triangles, int p_from_y, int p_to_y) {
+	const int width = sizes[0].x;
+	float *depth = mips[0];
+
+	for (const LocalVector<Triangle> *triangles : p_triangles) {
+		for (const Triangle &t : *triangles) {
+			int from_y = MAX(t.min_y, p_from_y);
+			int to_y = MIN(t.max_y, p_to_y - 1);
+
+			for (int y = from_y; y <= to_y; y++) {
+				float py = y + 0.5f;
+
+				// Only the X terms vary along a row, which keeps the inner loop branchless so it can be vectorized.
+				float e0 = t.edge_y[0] * py + t.edge_c[0];
+				float e1 = t.edge_y[1] * py + t.edge_c[1];
+				float e2 = t.edge_y[2] * py + t.edge_c[2];
+				float d = t.depth_y * py + t.depth_c;
+				float iw = t.inv_w_y * py + t.inv_w_c;
+
+				float *row = &depth[y * width];
+				for (int x = t.min_x; x <= t.max_x; x++) {
+					float px = x + 0.5f;
+					bool inside = (t.edge_x[0] * px + e0 >= 0.0f) & (t.edge_x[1] * px + e1 >= 0.0f) & (t.edge_x[2] * px + e2 >= 0.0f);
+					float z = (t.depth_x * px + d) / (t.inv_w_x * px + iw);
+					row[x] = (inside && z < row[x]) ? z : row[x];
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	occluder->aabb = AABB();
+	for (int i = 0; i < p_vertices.size(); i++) {
+		if (i == 0) {
+			occluder->aabb.position = p_vertices[i];
+		} else {
+			occluder->aabb.expand_to(p_vertices[i]);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+	instance.occluder = p_occluder;
+	instance.xform = p_xform;
+	instance.enabled = p_enabled;
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios[p_scenario].instances.erase(p_instance);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::_add_triangle(const Vector3 p_view[3], const SetupThreadData *p_data, LocalVector<Triangle> &r_triangles) {
+	Vector2 p[3];
+	float depth[3];
+	float inv_w[3];
+
+	for (int i = 0; i < 3; i++) {
+		Plane projected = p_data->cam_projection.xform4(Plane(p_view[i], 1.0));
+		if (projected.d <= 0.0) {
+			return;
+		}
+		inv_w[i] = 1.0 / projected.d;
+		p[i] = Vector2((projected.normal.x * inv_w[i] * 0.5f + 0.5f) * p_data->buffer_size.x, (projected.normal.y * inv_w[i] * 0.5f + 0.5f) * p_data->buffer_size.y);
+		// Depth over W is linear in screen space, like 1 / W, which allows perspective correct interpolation.
+		depth[i] = -p_view[i].z * inv_w[i];
+	}
+
+	float det = (p[1] - p[0]).cross(p[2] - p[0]);
+	if (Math::is_zero_approx(det)) {
+		return;
+	}
+
+	Triangle t;
+
+	t.min_x = MAX(0, (int)Math::ceil(MIN(p[0].x, MIN(p[1].x, p[2].x)) - 0.5f));
+	t.max_x = MIN(p_data->buffer_size.x - 1, (int)Math::floor(MAX(p[0].x, MAX(p[1].x, p[2].x)) - 0.5f));
+	t.min_y = MAX(0, (int)Math::ceil(MIN(p[0].y, MIN(p[1].y, p[2].y)) - 0.5f));
+	t.max_y = MIN(p_data->buffer_size.y - 1, (int)Math::floor(MAX(p[0].y, MAX(p[1].y, p[2].y)) - 0.5f));
+	if (t.min_x > t.max_x || t.min_y > t.max_y) {
+		return; // Off screen or between pixel centers.
+	}
+
+	// Occluders are double-sided, so the edges are flipped to face inwards regardless of winding.
+	float sign = det > 0.0f ? 1.0f : -1.0f;
+	for (int i = 0; i < 3; i++) {
+		const Vector2 &a = p[i];
+		const Vector2 &b = p[(i + 1) % 3];
+		t.edge_x[i] = (a.y - b.y) * sign;
+		t.edge_y[i] = (b.x - a.x) * sign;
+		t.edge_c[i] = (a.x * b.y - a.y * b.x) * sign;
+	}
+
+	float inv_det = 1.0f / det;
+	Vector2 d1 = p[1] - p[0];
+	Vector2 d2 = p[2] - p[0];
+
+#define PLANE_EQUATION(m_values, m_x, m_y, m_c)                                                \
+	m_x = ((m_values[1] - m_values[0]) * d2.y - (m_values[2] - m_values[0]) * d1.y) * inv_det; \
+	m_y = ((m_values[2] - m_values[0]) * d1.x - (m_values[1] - m_values[0]) * d2.x) * inv_det; \
+	m_c = m_values[0] - m_x * p[0].x - m_y * p[0].y
+
+	PLANE_EQUATION(depth, t.depth_x, t.depth_y, t.depth_c);
+	PLANE_EQUATION(inv_w, t.inv_w_x, t.inv_w_y, t.inv_w_c);
+
+#undef PLANE_EQUATION
+
+	r_triangles.push_back(t);
+}
+
+void RasterOcclusionCull::_setup_instance_threaded(uint32_t p_index, const SetupThreadData *p_data) {
+	OccluderInstance *instance = p_data->instances[p_index];
+	instance->triangles.clear();
+
+	const Occluder *occluder = occluder_owner.get_or_null(instance->occluder);
+	if (!occluder) {
+		return;
+	}
+
+	Transform3D view_xform = p_data->cam_inv_transform * instance->xform;
+
+	int vertex_count = occluder->vertices.size();
+	const Vector3 *vertices = occluder->vertices.ptr();
+	instance->view_vertices.resize(vertex_count);
+	for (int i = 0; i < vertex_count; i++) {
+		instance->view_vertices[i] = view_xform.xform(vertices[i]);
+	}
+
+	int index_count = occluder->indices.size();
+	const int32_t *indices = occluder->indices.ptr();
+
+	for (int i = 0; i + 2 < index_count; i += 3) {
+		Vector3 v[3];
+		float dist[3];
+		int inside_count = 0;
+		bool valid = true;
+
+		for (int j = 0; j < 3; j++) {
+			if (indices[i + j] < 0 || indices[i + j] >= vertex_count) {
+				valid = false;
+				break;
+			}
+			v[j] = instance->view_vertices[indices[i + j]];
+			dist[j] = -v[j].z - p_data->z_near;
+			inside_count += dist[j] >= 0.0f;
+		}
+
+		if (!valid || inside_count == 0) {
+			continue;
+		}
+
+		if (inside_count == 3) {
+			_add_triangle(v, p_data, instance->triangles);
+			continue;
+		}
+
+		// Clip against the near plane, which leaves either one or two triangles.
+		Vector3 polygon[4];
+		int polygon_size = 0;
+		for (int j = 0; j < 3; j++) {
+			int k = (j + 1) % 3;
+			if (dist[j] >= 0.0f) {
+				polygon[polygon_size++] = v[j];
+			}
+			if ((dist[j] >= 0.0f) != (dist[k] >= 0.0f)) {
+				polygon[polygon_size++] = v[j] + (v[k] - v[j]) * (dist[j] / (dist[j] - dist[k]));
+			}
+		}
+
+		_add_triangle(polygon, p_data, instance->triangles);
+		if (polygon_size == 4) {
+			Vector3 second[3] = { polygon[0], polygon[2], polygon[3] };
+			_add_triangle(second, p_data, instance->triangles);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+
+	// Skip occluders outside of the view before doing any per-triangle work.
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	visible_instances.clear();
+
+	for (KeyValue<RID, OccluderInstance> &E : scenario.instances) {
+		OccluderInstance &instance = E.value;
+		if (!instance.enabled) {
+			continue;
+		}
+
+		const Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+		if (!occluder || occluder->indices.is_empty()) {
+			continue;
+		}
+
+		AABB aabb = instance.xform.xform(occluder->aabb);
+		bool inside = true;
+		for (int i = 0; i < planes.size(); i++) {
+			if (planes[i].is_point_over(aabb.get_support(-planes[i].normal))) {
+				inside = false;
+				break;
+			}
+		}
+
+		if (inside) {
+			visible_instances.push_back(&instance);
+		}
+	}
+
+	SetupThreadData td;
+	td.instances = visible_instances.ptr();
+	td.cam_inv_transform = p_cam_transform.affine_inverse();
+	td.cam_projection = p_cam_projection;
+	td.buffer_size = buffer.get_size();
+	td.z_near = p_cam_projection.get_z_near();
+
+	if (visible_instances.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterOcclusionCull::_setup_instance_threaded, &td, visible_instances.size(), -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (visible_instances.size() == 1) {
+		_setup_instance_threaded(0, &td);
+	}
+
+	visible_triangles.clear();
+	for (const OccluderInstance *instance : visible_instances) {
+		if (!instance->triangles.is_empty()) {
+			visible_triangles.push_back(&instance->triangles);
+		}
+	}
+
+	buffer.rasterize(visible_triangles, p_cam_projection.get_z_far());
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
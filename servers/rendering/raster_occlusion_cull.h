@@ -0,0 +1,130 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RASTER_OCCLUSION_CULL_H
+#define RASTER_OCCLUSION_CULL_H
+
+#include "core/math/aabb.h"
+#include "core/math/projection.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Occlusion culling that rasterizes occluders into the depth buffer on the CPU.
+// Unlike the Embree based implementation, it has no dependency and is available in every build.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	struct Triangle {
+		// Edge functions and depth terms are linear in screen space, so they can be evaluated per pixel without any setup.
+		float edge_x[3];
+		float edge_y[3];
+		float edge_c[3];
+		float depth_x, depth_y, depth_c; // Depth divided by W.
+		float inv_w_x, inv_w_y, inv_w_c;
+		int min_x, min_y, max_x, max_y;
+	};
+
+	class RasterHZBuffer : public HZBuffer {
+		struct RasterThreadData {
+			uint32_t band_count;
+			const LocalVector<const LocalVector<Triangle> *> *triangles;
+		};
+
+		void _rasterize_band_threaded(uint32_t p_band, const RasterThreadData *p_data);
+		void _rasterize_band(const LocalVector<const LocalVector<Triangle> *> &p_triangles, int p_from_y, int p_to_y);
+
+	public:
+		RID scenario_rid;
+
+		Size2i get_size() const { return sizes.is_empty() ? Size2i() : sizes[0]; }
+		void rasterize(const LocalVector<const LocalVector<Triangle> *> &p_triangles, float p_z_far);
+	};
+
+private:
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		AABB aabb;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		Transform3D xform;
+		bool enabled = true;
+		LocalVector<Vector3> view_vertices;
+		LocalVector<Triangle> triangles;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+	};
+
+	struct SetupThreadData {
+		OccluderInstance **instances = nullptr;
+		Transform3D cam_inv_transform;
+		Projection cam_projection;
+		Size2i buffer_size;
+		float z_near = 0.0;
+	};
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	LocalVector<OccluderInstance *> visible_instances;
+	LocalVector<const LocalVector<Triangle> *> visible_triangles;
+
+	void _setup_instance_threaded(uint32_t p_index, const SetupThreadData *p_data);
+	static void _add_triangle(const Vector3 p_view[3], const SetupThreadData *p_data, LocalVector<Triangle> &r_triangles);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+};
+
+#endif // RASTER_OCCLUSION_CULL_H
@@ -66,6 +66,12 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 		}
 	}
 
+	if (r_render_info) {
+		for (RendererCanvasRender::Item *ri = list; ri; ri = ri->next) {
+			r_render_info->canvas_items_in_frame++;
+		}
+	}
+
 	RENDER_TIMESTAMP("Render CanvasItems");
 
 	bool sdf_flag;
@@ -182,7 +188,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		}
 	}
 
-	if (((ci->commands != nullptr || ci->visibility_notifier) && p_clip_rect.intersects(global_rect, true)) || ci->vp_render || ci->copy_back_buffer) {
+	if (((ci->commands != nullptr || ci->visibility_notifier) && (static_subtree_recording || p_clip_rect.intersects(global_rect, true))) || ci->vp_render || ci->copy_back_buffer) {
 		//something to draw?
 
 		if (ci->update_when_visible) {
@@ -234,6 +240,18 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		return;
 	}
 
+	if (ci->static_cache && allow_y_sort && p_canvas_clip == nullptr && !static_subtree_recording) {
+		if (_cull_static_subtree(ci, p_transform, p_clip_rect, p_modulate, p_z, r_z_list, r_z_last_list, p_material_owner, canvas_cull_mask)) {
+			return;
+		}
+	}
+
+	if (static_subtree_recording && (ci->clip || ci->canvas_group || ci->copy_back_buffer || ci->visibility_notifier || ci->update_when_visible || ci->skeleton.is_valid())) {
+		// These depend on where the item ends up on screen, or (for skinned items) change shape every frame,
+		// so they can't be replayed from a recording.
+		static_subtree_uncacheable = true;
+	}
+
 	if (ci->children_order_dirty) {
 		ci->child_items.sort_custom<ItemIndexSort>();
 		ci->children_order_dirty = false;
@@ -354,6 +372,119 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	}
 }
 
+void RendererCanvasCull::_record_static_subtree(Item *p_root, int p_z, Item *p_material_owner, uint32_t p_canvas_cull_mask) {
+	Item::StaticCache *cache = p_root->static_cache;
+	cache->entries.clear();
+	cache->dirty = false;
+	cache->z = p_z;
+	cache->material_owner = p_material_owner;
+	cache->cull_mask = p_canvas_cull_mask;
+	cache->snap_transforms_to_pixel = snapping_2d_transforms_to_pixel;
+
+	memset(static_z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	memset(static_z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+
+	// Cull the subtree in the space of its root and without a clip rect, so every drawable item gets recorded
+	// and moving the root (or anything above it) doesn't require recording again.
+	Transform2D root_xform = p_root->xform;
+	p_root->xform = Transform2D();
+
+	static_subtree_recording = true;
+	static_subtree_uncacheable = false;
+	_cull_canvas_item(p_root, Transform2D(), Rect2(), Color(1, 1, 1, 1), p_z, static_z_list, static_z_last_list, nullptr, p_material_owner, true, p_canvas_cull_mask);
+	static_subtree_recording = false;
+
+	p_root->xform = root_xform;
+
+	cache->cacheable = !static_subtree_uncacheable;
+	if (!cache->cacheable) {
+		return;
+	}
+
+	for (int i = 0; i < z_range; i++) {
+		for (RendererCanvasRender::Item *ri = static_z_list[i]; ri; ri = ri->next) {
+			Item::StaticCache::Entry entry;
+			entry.item = static_cast<Item *>(ri);
+			entry.xform = ri->final_transform;
+			entry.rect = ri->global_rect_cache;
+			entry.modulate = ri->final_modulate;
+			entry.z = ri->z_final;
+			cache->entries.push_back(entry);
+		}
+	}
+}
+
+bool RendererCanvasCull::_cull_static_subtree(Item *p_root, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_material_owner, uint32_t p_canvas_cull_mask) {
+	Item::StaticCache *cache = p_root->static_cache;
+	if (cache->dirty || cache->z != p_z || cache->material_owner != p_material_owner || cache->cull_mask != p_canvas_cull_mask || cache->snap_transforms_to_pixel != snapping_2d_transforms_to_pixel) {
+		_record_static_subtree(p_root, p_z, p_material_owner, p_canvas_cull_mask);
+	}
+
+	if (!cache->cacheable) {
+		return false;
+	}
+
+	if (p_modulate.a * p_root->modulate.a < 0.007) {
+		return true;
+	}
+
+	Transform2D root_xform = p_root->xform;
+	if (snapping_2d_transforms_to_pixel) {
+		root_xform.columns[2] = root_xform.columns[2].floor();
+	}
+	root_xform = p_transform * root_xform;
+
+	for (const Item::StaticCache::Entry &entry : cache->entries) {
+		Rect2 global_rect = root_xform.xform(entry.rect);
+		global_rect.position += p_clip_rect.position;
+		if (!p_clip_rect.intersects(global_rect, true)) {
+			continue;
+		}
+
+		Item *ci = entry.item;
+		ci->final_transform = root_xform * entry.xform;
+		ci->final_modulate = p_modulate * entry.modulate;
+		ci->global_rect_cache = global_rect;
+		ci->global_rect_cache.position -= p_clip_rect.position;
+		ci->light_masked = false;
+
+		int zidx = entry.z - RS::CANVAS_ITEM_Z_MIN;
+
+		if (r_z_last_list[zidx]) {
+			r_z_last_list[zidx]->next = ci;
+			r_z_last_list[zidx] = ci;
+
+		} else {
+			r_z_list[zidx] = ci;
+			r_z_last_list[zidx] = ci;
+		}
+
+		ci->z_final = entry.z;
+
+		ci->next = nullptr;
+	}
+
+	return true;
+}
+
+void RendererCanvasCull::_mark_static_subtree_dirty(Item *p_item, bool p_include_self) {
+	if (static_subtree_count == 0) {
+		return;
+	}
+
+	if (p_include_self && p_item->static_cache) {
+		p_item->static_cache->dirty = true;
+	}
+
+	Item *item = canvas_item_owner.owns(p_item->parent) ? canvas_item_owner.get_or_null(p_item->parent) : nullptr;
+	while (item) {
+		if (item->static_cache) {
+			item->static_cache->dirty = true;
+		}
+		item = canvas_item_owner.owns(item->parent) ? canvas_item_owner.get_or_null(item->parent) : nullptr;
+	}
+}
+
 void RendererCanvasCull::render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info) {
 	RENDER_TIMESTAMP("> Render Canvas");
 
@@ -455,6 +586,8 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	_mark_static_subtree_dirty(canvas_item, false);
+
 	if (canvas_item->parent.is_valid()) {
 		if (canvas_owner.owns(canvas_item->parent)) {
 			Canvas *canvas = canvas_owner.get_or_null(canvas_item->parent);
@@ -493,11 +626,14 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 	}
 
 	canvas_item->parent = p_parent;
+
+	_mark_static_subtree_dirty(canvas_item, false);
 }
 
 void RendererCanvasCull::canvas_item_set_visible(RID p_item, bool p_visible) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->visible = p_visible;
 
@@ -515,12 +651,16 @@ void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	// Static subtrees are recorded relative to their root, so only the ones above it need recording again.
+	_mark_static_subtree_dirty(canvas_item, false);
+
 	canvas_item->xform = p_transform;
 }
 
 void RendererCanvasCull::canvas_item_set_visibility_layer(RID p_item, uint32_t p_visibility_layer) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->visibility_layer = p_visibility_layer;
 }
@@ -535,6 +675,7 @@ uint32_t RendererCanvasCull::canvas_item_get_visibility_layer(RID p_item) {
 void RendererCanvasCull::canvas_item_set_clip(RID p_item, bool p_clip) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->clip = p_clip;
 }
@@ -549,6 +690,7 @@ void RendererCanvasCull::canvas_item_set_distance_field_mode(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
@@ -557,6 +699,7 @@ void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 void RendererCanvasCull::canvas_item_set_modulate(RID p_item, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->modulate = p_color;
 }
@@ -564,6 +707,7 @@ void RendererCanvasCull::canvas_item_set_modulate(RID p_item, const Color &p_col
 void RendererCanvasCull::canvas_item_set_self_modulate(RID p_item, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->self_modulate = p_color;
 }
@@ -571,6 +715,7 @@ void RendererCanvasCull::canvas_item_set_self_modulate(RID p_item, const Color &
 void RendererCanvasCull::canvas_item_set_draw_behind_parent(RID p_item, bool p_enable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->behind = p_enable;
 }
@@ -578,6 +723,7 @@ void RendererCanvasCull::canvas_item_set_draw_behind_parent(RID p_item, bool p_e
 void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_update) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->update_when_visible = p_update;
 }
@@ -585,6 +731,7 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(line);
@@ -817,6 +964,7 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Color color = Color(1, 1, 1, 1);
 
@@ -1088,6 +1236,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 	if (p_width < 0) {
 		Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 		ERR_FAIL_NULL(canvas_item);
+		_mark_static_subtree_dirty(canvas_item);
 
 		Vector<Color> colors;
 		if (p_colors.size() == 1) {
@@ -1130,6 +1279,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1140,6 +1290,7 @@ void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandPolygon *circle = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_NULL(circle);
@@ -1179,6 +1330,7 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1210,6 +1362,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range, float p_scale) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1244,6 +1397,7 @@ void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, co
 void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1276,6 +1430,7 @@ void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, con
 void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1317,6 +1472,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, RS::NinePatchAxisMode p_x_axis_mode, RS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	ERR_FAIL_NULL(style);
@@ -1341,6 +1497,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(prim);
@@ -1367,6 +1524,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 #ifdef DEBUG_ENABLED
 	int pointcount = p_points.size();
 	ERR_FAIL_COND(pointcount < 3);
@@ -1388,6 +1546,7 @@ void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2
 void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	int vertex_count = p_points.size();
 	ERR_FAIL_COND(vertex_count == 0);
@@ -1409,6 +1568,7 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	ERR_FAIL_NULL(tr);
@@ -1418,6 +1578,7 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 	ERR_FAIL_COND(!p_mesh.is_valid());
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
@@ -1437,6 +1598,7 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_NULL(part);
@@ -1451,6 +1613,7 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_NULL(mm);
@@ -1462,6 +1625,7 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_NULL(ci);
@@ -1471,6 +1635,7 @@ void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	Item::CommandAnimationSlice *as = canvas_item->alloc_command<Item::CommandAnimationSlice>();
 	ERR_FAIL_NULL(as);
@@ -1483,6 +1648,7 @@ void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_an
 void RendererCanvasCull::canvas_item_set_sort_children_by_y(RID p_item, bool p_enable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->sort_y = p_enable;
 
@@ -1494,6 +1660,7 @@ void RendererCanvasCull::canvas_item_set_z_index(RID p_item, int p_z) {
 
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->z_index = p_z;
 }
@@ -1501,6 +1668,7 @@ void RendererCanvasCull::canvas_item_set_z_index(RID p_item, int p_z) {
 void RendererCanvasCull::canvas_item_set_z_as_relative_to_parent(RID p_item, bool p_enable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->z_relative = p_enable;
 }
@@ -1511,6 +1679,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 	if (canvas_item->skeleton == p_skeleton) {
 		return;
 	}
+	_mark_static_subtree_dirty(canvas_item);
 	canvas_item->skeleton = p_skeleton;
 
 	Item::Command *c = canvas_item->commands;
@@ -1537,6 +1706,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_enable, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 	if (p_enable && (canvas_item->copy_back_buffer == nullptr)) {
 		canvas_item->copy_back_buffer = memnew(RendererCanvasRender::Item::CopyBackBuffer);
 	}
@@ -1554,6 +1724,7 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->clear();
 #ifdef DEBUG_ENABLED
@@ -1566,6 +1737,7 @@ void RendererCanvasCull::canvas_item_clear(RID p_item) {
 void RendererCanvasCull::canvas_item_set_draw_index(RID p_item, int p_index) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->index = p_index;
 
@@ -1592,6 +1764,7 @@ void RendererCanvasCull::canvas_item_set_material(RID p_item, RID p_material) {
 void RendererCanvasCull::canvas_item_set_use_parent_material(RID p_item, bool p_enable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	canvas_item->use_parent_material = p_enable;
 }
@@ -1599,6 +1772,7 @@ void RendererCanvasCull::canvas_item_set_use_parent_material(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_enable, const Rect2 &p_area, const Callable &p_enter_callable, const Callable &p_exit_callable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	if (p_enable) {
 		if (!canvas_item->visibility_notifier) {
@@ -1616,6 +1790,28 @@ void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_
 	}
 }
 
+void RendererCanvasCull::canvas_item_set_static_subtree(RID p_item, bool p_enabled) {
+	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
+	ERR_FAIL_NULL(canvas_item);
+
+	if (p_enabled == (canvas_item->static_cache != nullptr)) {
+		return;
+	}
+
+	if (p_enabled) {
+		if (static_z_list == nullptr) {
+			static_z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+			static_z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+		}
+		canvas_item->static_cache = memnew(Item::StaticCache);
+		static_subtree_count++;
+	} else {
+		memdelete(canvas_item->static_cache);
+		canvas_item->static_cache = nullptr;
+		static_subtree_count--;
+	}
+}
+
 void RendererCanvasCull::canvas_item_set_debug_redraw(bool p_enabled) {
 	debug_redraw = p_enabled;
 	RSG::canvas_render->set_debug_redraw(p_enabled, debug_redraw_time, debug_redraw_color);
@@ -1628,6 +1824,7 @@ bool RendererCanvasCull::canvas_item_get_debug_redraw() const {
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_static_subtree_dirty(canvas_item);
 
 	if (p_mode == RS::CANVAS_GROUP_MODE_DISABLED) {
 		if (canvas_item->canvas_group != nullptr) {
@@ -2079,6 +2276,8 @@ bool RendererCanvasCull::free(RID p_rid) {
 		Item *canvas_item = canvas_item_owner.get_or_null(p_rid);
 		ERR_FAIL_NULL_V(canvas_item, true);
 
+		_mark_static_subtree_dirty(canvas_item, false);
+
 		if (canvas_item->parent.is_valid()) {
 			if (canvas_owner.owns(canvas_item->parent)) {
 				Canvas *canvas = canvas_owner.get_or_null(canvas_item->parent);
@@ -2112,6 +2311,12 @@ bool RendererCanvasCull::free(RID p_rid) {
 			canvas_item->canvas_group = nullptr;
 		}
 
+		if (canvas_item->static_cache != nullptr) {
+			memdelete(canvas_item->static_cache);
+			canvas_item->static_cache = nullptr;
+			static_subtree_count--;
+		}
+
 		canvas_item_owner.free(p_rid);
 
 	} else if (canvas_light_owner.owns(p_rid)) {
@@ -2178,4 +2383,8 @@ RendererCanvasCull::RendererCanvasCull() {
 RendererCanvasCull::~RendererCanvasCull() {
 	memfree(z_list);
 	memfree(z_last_list);
+	if (static_z_list != nullptr) {
+		memfree(static_z_list);
+		memfree(static_z_last_list);
+	}
 }
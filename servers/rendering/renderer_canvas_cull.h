@@ -31,6 +31,7 @@
 #ifndef RENDERER_CANVAS_CULL_H
 #define RENDERER_CANVAS_CULL_H
 
+#include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
@@ -72,6 +73,28 @@ public:
 
 		VisibilityNotifierData *visibility_notifier = nullptr;
 
+		struct StaticCache {
+			struct Entry {
+				Item *item = nullptr;
+				Transform2D xform; // Relative to the root of the static subtree.
+				Rect2 rect; // Relative to the root of the static subtree.
+				Color modulate;
+				int z = 0;
+			};
+
+			LocalVector<Entry> entries; // Drawable items of the subtree, sorted by Z.
+			bool dirty = true;
+			bool cacheable = true;
+
+			// State the entries were recorded with, they are recorded again if any of it changes.
+			int z = 0;
+			Item *material_owner = nullptr;
+			uint32_t cull_mask = 0;
+			bool snap_transforms_to_pixel = false;
+		};
+
+		StaticCache *static_cache = nullptr; // Only allocated for the roots of static subtrees.
+
 		Item() {
 			children_order_dirty = true;
 			E = nullptr;
@@ -186,12 +209,22 @@ public:
 private:
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
 	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool allow_y_sort, uint32_t canvas_cull_mask);
+	void _record_static_subtree(Item *p_root, int p_z, Item *p_material_owner, uint32_t p_canvas_cull_mask);
+	bool _cull_static_subtree(Item *p_root, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_material_owner, uint32_t p_canvas_cull_mask);
+	void _mark_static_subtree_dirty(Item *p_item, bool p_include_self = true);
 
 	static constexpr int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
 
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	// Static subtrees are recorded into their own lists, so recording doesn't disturb the lists being built.
+	RendererCanvasRender::Item **static_z_list = nullptr;
+	RendererCanvasRender::Item **static_z_last_list = nullptr;
+	uint32_t static_subtree_count = 0;
+	bool static_subtree_recording = false;
+	bool static_subtree_uncacheable = false;
+
 public:
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
 
@@ -264,6 +297,8 @@ public:
 
 	void canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin = 5.0, bool p_fit_empty = false, float p_fit_margin = 0.0, bool p_blur_mipmaps = false);
 
+	void canvas_item_set_static_subtree(RID p_item, bool p_enabled);
+
 	void canvas_item_set_debug_redraw(bool p_enabled);
 	bool canvas_item_get_debug_redraw() const;
 
@@ -177,6 +177,8 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	print_line("\n**vertex_globals:\n" + gen_code.stage_globals[ShaderCompiler::STAGE_VERTEX]);
 	print_line("\n**fragment_globals:\n" + gen_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT]);
 #endif
+	// Color pipelines may be compiling in the background against the shader variants that are about to be replaced.
+	_clear_color_pipelines();
 	shader_singleton->shader.version_set_code(version, gen_code.code, gen_code.uniforms, gen_code.stage_globals[ShaderCompiler::STAGE_VERTEX], gen_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT], gen_code.defines);
 	ERR_FAIL_COND(!shader_singleton->shader.version_is_valid(version));
 
@@ -420,10 +422,21 @@ SceneShaderForwardClustered::ShaderData::ShaderData() :
 		shader_list_element(this) {
 }
 
+void SceneShaderForwardClustered::ShaderData::_clear_color_pipelines() {
+	for (int i = 0; i < CULL_VARIANT_MAX; i++) {
+		for (int j = 0; j < RS::PRIMITIVE_MAX; j++) {
+			for (int k = 0; k < PIPELINE_COLOR_PASS_FLAG_COUNT; k++) {
+				color_pipelines[i][j][k].clear();
+			}
+		}
+	}
+}
+
 SceneShaderForwardClustered::ShaderData::~ShaderData() {
 	SceneShaderForwardClustered *shader_singleton = (SceneShaderForwardClustered *)SceneShaderForwardClustered::singleton;
 	ERR_FAIL_NULL(shader_singleton);
 	//pipeline variants will clear themselves if shader is gone
+	_clear_color_pipelines();
 	if (version.is_valid()) {
 		shader_singleton->shader.version_free(version);
 	}
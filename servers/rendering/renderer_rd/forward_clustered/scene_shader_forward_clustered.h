@@ -187,6 +187,8 @@ public:
 		uint64_t last_pass = 0;
 		uint32_t index = 0;
 
+		void _clear_color_pipelines();
+
 		virtual void set_code(const String &p_Code);
 
 		virtual bool is_animated() const;
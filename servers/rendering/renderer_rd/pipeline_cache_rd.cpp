@@ -31,15 +31,15 @@
 #include "pipeline_cache_rd.h"
 
 #include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
 
-RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+RID PipelineCacheRD::_create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
 	RD::PipelineMultisampleState multisample_state_version = multisample_state;
 	multisample_state_version.sample_count = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, p_render_pass);
 
-	bool wireframe = p_wireframe;
-
 	RD::PipelineRasterizationState raster_state_version = rasterization_state;
-	raster_state_version.wireframe = wireframe;
+	raster_state_version.wireframe = p_wireframe;
 
 	Vector<RD::PipelineSpecializationConstant> specialization_constants = base_specialization_constants;
 
@@ -57,21 +57,149 @@ RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD
 		bool_index++;
 	}
 
-	RID pipeline = RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
-	ERR_FAIL_COND_V(pipeline.is_null(), RID());
+	return RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
+}
+
+RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, bool p_async, bool *r_pending) {
+	// Called with the lock held. The version is registered before compiling so that other
+	// threads asking for the same pipeline wait for it instead of creating it twice.
+	uint32_t index = version_count;
 	versions = static_cast<Version *>(memrealloc(versions, sizeof(Version) * (version_count + 1)));
-	versions[version_count].framebuffer_id = p_framebuffer_format_id;
-	versions[version_count].vertex_id = p_vertex_format_id;
-	versions[version_count].wireframe = wireframe;
-	versions[version_count].pipeline = pipeline;
-	versions[version_count].render_pass = p_render_pass;
-	versions[version_count].bool_specializations = p_bool_specializations;
+	versions[index].framebuffer_id = p_framebuffer_format_id;
+	versions[index].vertex_id = p_vertex_format_id;
+	versions[index].wireframe = p_wireframe;
+	versions[index].pipeline = RID();
+	versions[index].render_pass = p_render_pass;
+	versions[index].bool_specializations = p_bool_specializations;
+	versions[index].compiling = true;
+	versions[index].compile_task = WorkerThreadPool::INVALID_TASK_ID;
 	version_count++;
+
+	if (p_async) {
+		RID fallback = _find_fallback_version(index);
+		spin_lock.unlock();
+
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_template_task(this, &PipelineCacheRD::_compile_version_task, index, false, "PipelineCacheRD: Compile pipeline");
+
+		spin_lock.lock();
+		versions[index].compile_task = task;
+		spin_lock.unlock();
+
+		if (r_pending) {
+			*r_pending = true;
+		}
+		return fallback;
+	}
+
+	spin_lock.unlock();
+	RID pipeline = _create_pipeline(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+
+	spin_lock.lock();
+	versions[index].pipeline = pipeline;
+	versions[index].compiling = false;
+	spin_lock.unlock();
+
+	ERR_FAIL_COND_V(pipeline.is_null(), RID());
+	return pipeline;
+}
+
+RID PipelineCacheRD::_resolve_version(uint32_t p_index, bool p_async, bool *r_pending) {
+	// Called with the lock held, for a version that is compiling or whose task was not collected yet.
+	if (versions[p_index].compiling && p_async) {
+		RID fallback = _find_fallback_version(p_index);
+		spin_lock.unlock();
+
+		if (r_pending) {
+			*r_pending = true;
+		}
+		return fallback;
+	}
+
+	WorkerThreadPool::TaskID task = versions[p_index].compile_task;
+	versions[p_index].compile_task = WorkerThreadPool::INVALID_TASK_ID;
+	spin_lock.unlock();
+
+	if (task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+
+		// Whoever collects a failed background compilation retries it once on this thread, in case
+		// the failure came from compiling in the background. A failure after that is final.
+		spin_lock.lock();
+		if (versions[p_index].pipeline.is_null()) {
+			Version version = versions[p_index];
+			versions[p_index].compiling = true;
+			spin_lock.unlock();
+
+			RID pipeline = _create_pipeline(version.vertex_id, version.framebuffer_id, version.wireframe, version.render_pass, version.bool_specializations);
+			if (pipeline.is_null()) {
+				ERR_PRINT("Failed to compile a render pipeline, draws using it will be skipped.");
+			}
+
+			spin_lock.lock();
+			versions[p_index].pipeline = pipeline;
+			versions[p_index].compiling = false;
+		}
+		spin_lock.unlock();
+	}
+
+	// Another thread may own the compilation (or the wait on its task), so poll until it is done.
+	spin_lock.lock();
+	while (versions[p_index].compiling) {
+		spin_lock.unlock();
+		OS::get_singleton()->yield();
+		spin_lock.lock();
+	}
+	RID pipeline = versions[p_index].pipeline;
+	spin_lock.unlock();
 	return pipeline;
 }
 
+RID PipelineCacheRD::_find_fallback_version(uint32_t p_index) const {
+	// A version differing only in its specializations is close enough to draw with while the
+	// requested one is compiled.
+	const Version &version = versions[p_index];
+	for (uint32_t i = 0; i < version_count; i++) {
+		if (i != p_index && !versions[i].compiling && versions[i].pipeline.is_valid() && versions[i].vertex_id == version.vertex_id && versions[i].framebuffer_id == version.framebuffer_id && versions[i].wireframe == version.wireframe && versions[i].render_pass == version.render_pass) {
+			return versions[i].pipeline;
+		}
+	}
+	return RID();
+}
+
+void PipelineCacheRD::_compile_version_task(uint32_t p_index) {
+	spin_lock.lock();
+	Version version = versions[p_index];
+	spin_lock.unlock();
+
+	RID pipeline = _create_pipeline(version.vertex_id, version.framebuffer_id, version.wireframe, version.render_pass, version.bool_specializations);
+
+	spin_lock.lock();
+	versions[p_index].pipeline = pipeline;
+	versions[p_index].compiling = false;
+	spin_lock.unlock();
+}
+
+void PipelineCacheRD::_wait_for_compilations() {
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+
+	spin_lock.lock();
+	for (uint32_t i = 0; i < version_count; i++) {
+		if (versions[i].compile_task != WorkerThreadPool::INVALID_TASK_ID) {
+			tasks.push_back(versions[i].compile_task);
+			versions[i].compile_task = WorkerThreadPool::INVALID_TASK_ID;
+		}
+	}
+	spin_lock.unlock();
+
+	for (const WorkerThreadPool::TaskID &task : tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+}
+
 void PipelineCacheRD::_clear() {
 	// TODO: Clear should probably recompile all the variants already compiled instead to avoid stalls? Needs discussion.
+	_wait_for_compilations();
+
 	if (versions) {
 		for (uint32_t i = 0; i < version_count; i++) {
 			//shader may be gone, so this may not be valid
@@ -99,8 +227,9 @@ void PipelineCacheRD::setup(RID p_shader, RD::RenderPrimitive p_primitive, const
 	base_specialization_constants = p_base_specialization_constants;
 }
 void PipelineCacheRD::update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants) {
-	base_specialization_constants = p_base_specialization_constants;
+	// Clear first, background compilations may still be reading the old constants.
 	_clear();
+	base_specialization_constants = p_base_specialization_constants;
 }
 
 void PipelineCacheRD::update_shader(RID p_shader) {
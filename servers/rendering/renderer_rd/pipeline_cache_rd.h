@@ -31,6 +31,7 @@
 #ifndef PIPELINE_CACHE_RD_H
 #define PIPELINE_CACHE_RD_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/spin_lock.h"
 #include "servers/rendering/rendering_device.h"
 
@@ -55,12 +56,19 @@ class PipelineCacheRD {
 		bool wireframe;
 		uint32_t bool_specializations;
 		RID pipeline;
+		bool compiling; // The pipeline is being created, either by another caller or in the background.
+		WorkerThreadPool::TaskID compile_task; // Background compilation that still needs to be waited on.
 	};
 
 	Version *versions = nullptr;
 	uint32_t version_count;
 
-	RID _generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations = 0);
+	RID _create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+	RID _generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, bool p_async, bool *r_pending);
+	RID _resolve_version(uint32_t p_index, bool p_async, bool *r_pending);
+	RID _find_fallback_version(uint32_t p_index) const;
+	void _compile_version_task(uint32_t p_index);
+	void _wait_for_compilations();
 
 	void _clear();
 
@@ -69,7 +77,11 @@ public:
 	void update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants);
 	void update_shader(RID p_shader);
 
-	_FORCE_INLINE_ RID get_render_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe = false, uint32_t p_render_pass = 0, uint32_t p_bool_specializations = 0) {
+	// When p_async is true, a missing pipeline is compiled in the background and a compatible
+	// version with other specializations (or a null RID, meaning "skip the draw") is returned meanwhile.
+	// r_pending is set to true while the requested pipeline is still compiling. A null RID without
+	// pending means the pipeline failed to compile and won't become available.
+	_FORCE_INLINE_ RID get_render_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe = false, uint32_t p_render_pass = 0, uint32_t p_bool_specializations = 0, bool p_async = false, bool *r_pending = nullptr) {
 #ifdef DEBUG_ENABLED
 		ERR_FAIL_COND_V_MSG(shader.is_null(), RID(),
 				"Attempted to use an unused shader variant (shader is null),");
@@ -81,14 +93,15 @@ public:
 		RID result;
 		for (uint32_t i = 0; i < version_count; i++) {
 			if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].bool_specializations == p_bool_specializations) {
+				if (unlikely(versions[i].compiling || versions[i].compile_task != WorkerThreadPool::INVALID_TASK_ID)) {
+					return _resolve_version(i, p_async, r_pending); // Releases the lock.
+				}
 				result = versions[i].pipeline;
 				spin_lock.unlock();
 				return result;
 			}
 		}
-		result = _generate_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
-		spin_lock.unlock();
-		return result;
+		return _generate_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations, p_async, r_pending); // Releases the lock.
 	}
 
 	_FORCE_INLINE_ uint64_t get_vertex_input_mask() {
@@ -227,81 +227,67 @@ void ShaderRD::_compile_variant(uint32_t p_variant, const CompileData *p_data) {
 		return; // Variant is disabled, return.
 	}
 
-	Vector<RD::ShaderStageSPIRVData> stages;
-
-	String error;
-	String current_source;
-	RD::ShaderStage current_stage = RD::SHADER_STAGE_VERTEX;
-	bool build_ok = true;
+	// Build the code of every stage first, it is also the key of the variant cache.
+	RD::ShaderStage stage_types[2];
+	String stage_sources[2];
+	uint32_t stage_count = 0;
 
 	if (!is_compute) {
-		//vertex stage
-
 		StringBuilder builder;
 		_build_variant_code(builder, variant, p_data->version, stage_templates[STAGE_TYPE_VERTEX]);
+		stage_types[stage_count] = RD::SHADER_STAGE_VERTEX;
+		stage_sources[stage_count++] = builder.as_string();
 
-		current_source = builder.as_string();
-		RD::ShaderStageSPIRVData stage;
-		stage.spirv = RD::get_singleton()->shader_compile_spirv_from_source(RD::SHADER_STAGE_VERTEX, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
-		if (stage.spirv.size() == 0) {
-			build_ok = false;
-		} else {
-			stage.shader_stage = RD::SHADER_STAGE_VERTEX;
-			stages.push_back(stage);
-		}
-	}
-
-	if (!is_compute && build_ok) {
-		//fragment stage
-		current_stage = RD::SHADER_STAGE_FRAGMENT;
-
-		StringBuilder builder;
+		builder = StringBuilder();
 		_build_variant_code(builder, variant, p_data->version, stage_templates[STAGE_TYPE_FRAGMENT]);
-
-		current_source = builder.as_string();
-		RD::ShaderStageSPIRVData stage;
-		stage.spirv = RD::get_singleton()->shader_compile_spirv_from_source(RD::SHADER_STAGE_FRAGMENT, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
-		if (stage.spirv.size() == 0) {
-			build_ok = false;
-		} else {
-			stage.shader_stage = RD::SHADER_STAGE_FRAGMENT;
-			stages.push_back(stage);
-		}
-	}
-
-	if (is_compute) {
-		//compute stage
-		current_stage = RD::SHADER_STAGE_COMPUTE;
-
+		stage_types[stage_count] = RD::SHADER_STAGE_FRAGMENT;
+		stage_sources[stage_count++] = builder.as_string();
+	} else {
 		StringBuilder builder;
 		_build_variant_code(builder, variant, p_data->version, stage_templates[STAGE_TYPE_COMPUTE]);
+		stage_types[stage_count] = RD::SHADER_STAGE_COMPUTE;
+		stage_sources[stage_count++] = builder.as_string();
+	}
 
-		current_source = builder.as_string();
+	String variant_sha256;
+	Vector<uint8_t> shader_data;
 
-		RD::ShaderStageSPIRVData stage;
-		stage.spirv = RD::get_singleton()->shader_compile_spirv_from_source(RD::SHADER_STAGE_COMPUTE, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
-		if (stage.spirv.size() == 0) {
-			build_ok = false;
-		} else {
-			stage.shader_stage = RD::SHADER_STAGE_COMPUTE;
-			stages.push_back(stage);
-		}
+	if (shader_cache_dir_valid) {
+		variant_sha256 = _variant_get_sha256(stage_sources, stage_count);
+		shader_data = _load_variant_from_cache(variant_sha256);
 	}
 
-	if (!build_ok) {
-		MutexLock lock(variant_set_mutex); //properly print the errors
-		ERR_PRINT("Error compiling " + String(current_stage == RD::SHADER_STAGE_COMPUTE ? "Compute " : (current_stage == RD::SHADER_STAGE_VERTEX ? "Vertex" : "Fragment")) + " shader, variant #" + itos(variant) + " (" + variant_defines[variant].text.get_data() + ").");
-		ERR_PRINT(error);
+	if (shader_data.size()) {
+		p_data->variants_from_cache->increment();
+	} else {
+		Vector<RD::ShaderStageSPIRVData> stages;
+
+		for (uint32_t i = 0; i < stage_count; i++) {
+			String error;
+			RD::ShaderStageSPIRVData stage;
+			stage.spirv = RD::get_singleton()->shader_compile_spirv_from_source(stage_types[i], stage_sources[i], RD::SHADER_LANGUAGE_GLSL, &error);
+			if (stage.spirv.size() == 0) {
+				MutexLock lock(variant_set_mutex); //properly print the errors
+				ERR_PRINT("Error compiling " + String(stage_types[i] == RD::SHADER_STAGE_COMPUTE ? "Compute " : (stage_types[i] == RD::SHADER_STAGE_VERTEX ? "Vertex" : "Fragment")) + " shader, variant #" + itos(variant) + " (" + variant_defines[variant].text.get_data() + ").");
+				ERR_PRINT(error);
 
 #ifdef DEBUG_ENABLED
-		ERR_PRINT("code:\n" + current_source.get_with_code_lines());
+				ERR_PRINT("code:\n" + stage_sources[i].get_with_code_lines());
 #endif
-		return;
-	}
+				return;
+			}
+			stage.shader_stage = stage_types[i];
+			stages.push_back(stage);
+		}
 
-	Vector<uint8_t> shader_data = RD::get_singleton()->shader_compile_binary_from_spirv(stages, name + ":" + itos(variant));
+		shader_data = RD::get_singleton()->shader_compile_binary_from_spirv(stages, name + ":" + itos(variant));
 
-	ERR_FAIL_COND(shader_data.size() == 0);
+		ERR_FAIL_COND(shader_data.size() == 0);
+
+		if (shader_cache_dir_valid) {
+			_save_variant_to_cache(variant_sha256, shader_data);
+		}
+	}
 
 	{
 		MutexLock lock(variant_set_mutex);
@@ -393,6 +379,10 @@ String ShaderRD::_version_get_sha1(Version *p_version) const {
 }
 
 static const char *shader_file_header = "GDSC";
+static const char *variant_file_header = "GDSV";
+static const char *variant_cache_dir = "variants";
+// Every edit of a shader leaves the binaries of its old variants behind, so keep only the newest ones.
+static const uint32_t variant_cache_max_files = 4096;
 static const uint32_t cache_file_version = 3;
 
 bool ShaderRD::_load_from_cache(Version *p_version, int p_group) {
@@ -479,6 +469,101 @@ void ShaderRD::_save_to_cache(Version *p_version, int p_group) {
 	}
 }
 
+String ShaderRD::_variant_get_sha256(const String *p_stage_sources, uint32_t p_stage_count) const {
+	StringBuilder hash_build;
+
+	// The base hash covers the engine version and the SPIR-V and binary cache keys of the driver.
+	hash_build.append("[base_hash]");
+	hash_build.append(base_sha256);
+	for (uint32_t i = 0; i < p_stage_count; i++) {
+		hash_build.append("[stage:" + itos(i) + "]");
+		hash_build.append(p_stage_sources[i]);
+	}
+
+	return hash_build.as_string().sha256_text();
+}
+
+Vector<uint8_t> ShaderRD::_load_variant_from_cache(const String &p_sha256) {
+	String path = shader_cache_dir.path_join(name).path_join(variant_cache_dir).path_join(p_sha256) + ".cache";
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	if (f.is_null()) {
+		return Vector<uint8_t>();
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	ERR_FAIL_COND_V(header != String(variant_file_header), Vector<uint8_t>());
+
+	uint32_t file_version = f->get_32();
+	if (file_version != cache_file_version) {
+		return Vector<uint8_t>(); // wrong version
+	}
+
+	uint32_t variant_size = f->get_32();
+	ERR_FAIL_COND_V(variant_size == 0, Vector<uint8_t>());
+
+	Vector<uint8_t> variant_bytes;
+	variant_bytes.resize(variant_size);
+
+	uint32_t br = f->get_buffer(variant_bytes.ptrw(), variant_size);
+
+	ERR_FAIL_COND_V(br != variant_size, Vector<uint8_t>());
+
+	return variant_bytes;
+}
+
+void ShaderRD::_save_variant_to_cache(const String &p_sha256, const Vector<uint8_t> &p_shader_data) {
+	String path = shader_cache_dir.path_join(name).path_join(variant_cache_dir).path_join(p_sha256) + ".cache";
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	ERR_FAIL_COND(f.is_null());
+	f->store_buffer((const uint8_t *)variant_file_header, 4);
+	f->store_32(cache_file_version); // File version.
+	f->store_32(p_shader_data.size());
+	f->store_buffer(p_shader_data.ptr(), p_shader_data.size());
+}
+
+void ShaderRD::_prune_variant_cache() {
+	String dir = shader_cache_dir.path_join(name).path_join(variant_cache_dir);
+	Ref<DirAccess> d = DirAccess::open(dir);
+	ERR_FAIL_COND(d.is_null());
+
+	struct CacheFile {
+		uint64_t modified_time = 0;
+		String file;
+
+		bool operator<(const CacheFile &p_other) const {
+			return modified_time > p_other.modified_time; // Newest first.
+		}
+	};
+
+	LocalVector<CacheFile> files;
+	d->list_dir_begin();
+	String file = d->get_next();
+	while (!file.is_empty()) {
+		if (!d->current_is_dir() && file.get_extension() == "cache") {
+			CacheFile cache_file;
+			cache_file.file = file;
+			cache_file.modified_time = FileAccess::get_modified_time(dir.path_join(file));
+			files.push_back(cache_file);
+		}
+		file = d->get_next();
+	}
+	d->list_dir_end();
+
+	if (files.size() <= variant_cache_max_files) {
+		return;
+	}
+
+	files.sort();
+	for (uint32_t i = variant_cache_max_files; i < files.size(); i++) {
+		d->remove(files[i].file);
+	}
+
+	print_verbose(vformat("Shader '%s' removed %d old entries from the variant cache.", name, files.size() - variant_cache_max_files));
+}
+
 void ShaderRD::_allocate_placeholders(Version *p_version, int p_group) {
 	ERR_FAIL_NULL(p_version->variants);
 	for (uint32_t i = 0; i < group_to_variant_map[p_group].size(); i++) {
@@ -503,15 +588,21 @@ void ShaderRD::_compile_version(Version *p_version, int p_group) {
 
 	p_version->dirty = false;
 
+	uint64_t time_start = OS::get_singleton()->get_ticks_usec();
+
 	if (shader_cache_dir_valid) {
 		if (_load_from_cache(p_version, p_group)) {
+			print_verbose(vformat("Shader '%s' (group %d) loaded from cache in %.2f ms.", name, p_group, (OS::get_singleton()->get_ticks_usec() - time_start) / 1000.0));
 			return;
 		}
 	}
 
+	SafeNumeric<uint32_t> variants_from_cache;
+
 	CompileData compile_data;
 	compile_data.version = p_version;
 	compile_data.group = p_group;
+	compile_data.variants_from_cache = &variants_from_cache;
 
 #if 1
 	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ShaderRD::_compile_variant, &compile_data, group_to_variant_map[p_group].size(), -1, true, SNAME("ShaderCompilation"));
@@ -523,6 +614,8 @@ void ShaderRD::_compile_version(Version *p_version, int p_group) {
 	}
 #endif
 
+	print_verbose(vformat("Shader '%s' (group %d) built %d variants (%d from the variant cache) in %.2f ms.", name, p_group, group_to_variant_map[p_group].size(), variants_from_cache.get(), (OS::get_singleton()->get_ticks_usec() - time_start) / 1000.0));
+
 	bool all_valid = true;
 
 	for (uint32_t i = 0; i < group_to_variant_map[p_group].size(); i++) {
@@ -758,6 +851,11 @@ void ShaderRD::_initialize_cache() {
 			d->change_dir(name);
 		}
 
+		if (!d->dir_exists(variant_cache_dir)) {
+			Error err = d->make_dir(variant_cache_dir);
+			ERR_FAIL_COND(err != OK);
+		}
+
 		// Erase other versions?
 		if (shader_cache_cleanup_on_start) {
 		}
@@ -770,6 +868,10 @@ void ShaderRD::_initialize_cache() {
 
 		print_verbose("Shader '" + name + "' (group " + itos(E.key) + ") SHA256: " + group_sha256[E.key]);
 	}
+
+	if (shader_cache_dir_valid) {
+		_prune_variant_cache();
+	}
 }
 
 // Same as above, but allows specifying shader compilation groups.
@@ -37,6 +37,7 @@
 #include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 #include "servers/rendering_server.h"
 
@@ -83,6 +84,7 @@ private:
 	struct CompileData {
 		Version *version;
 		int group = 0;
+		SafeNumeric<uint32_t> *variants_from_cache = nullptr;
 	};
 
 	void _compile_variant(uint32_t p_variant, const CompileData *p_data);
@@ -145,6 +147,10 @@ private:
 	String _version_get_sha1(Version *p_version) const;
 	bool _load_from_cache(Version *p_version, int p_group);
 	void _save_to_cache(Version *p_version, int p_group);
+	String _variant_get_sha256(const String *p_stage_sources, uint32_t p_stage_count) const;
+	Vector<uint8_t> _load_variant_from_cache(const String &p_sha256);
+	void _save_variant_to_cache(const String &p_sha256, const Vector<uint8_t> &p_shader_data);
+	void _prune_variant_cache();
 	void _initialize_cache();
 
 protected:
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_server_default.h"
 
 #include <new>
@@ -1778,6 +1779,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 			idata.flags |= InstanceData::FLAG_IGNORE_ALL_CULLING;
 		}
 
+		idata.bounds_version = ++p_instance->scenario->instance_bounds_version;
 		p_instance->scenario->instance_data.push_back(idata);
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
 		_update_instance_visibility_dependencies(p_instance);
@@ -1788,6 +1790,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_data[p_instance->array_index].bounds_version = ++p_instance->scenario->instance_bounds_version;
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1875,6 +1878,8 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		// Cached frustum masks are stored by array index, so the moved instance must be tested again.
+		p_instance->scenario->instance_data[p_instance->array_index].bounds_version = ++p_instance->scenario->instance_bounds_version;
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -2291,14 +2296,60 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	}
 }
 
+void RendererSceneCull::_light_instance_add_shadow_cull(Instance *p_instance, uint32_t p_pass, const Vector<Plane> &p_planes, Scenario *p_scenario, uint32_t p_visible_layers) {
+	if (shadow_cull_jobs_used == shadow_cull_jobs.size()) {
+		shadow_cull_jobs.resize(shadow_cull_jobs_used + 1);
+	}
+
+	ShadowCullJob &job = shadow_cull_jobs[shadow_cull_jobs_used++];
+	job.light = p_instance;
+	job.scenario = p_scenario;
+	job.planes = p_planes;
+	job.visible_layers = p_visible_layers;
+	job.shadow_data = &render_shadow_data[max_shadows_used++];
+	job.animated_material_found = false;
+	job.mesh_instances.clear();
+
+	job.shadow_data->light = static_cast<InstanceLightData *>(p_instance->base_data)->instance;
+	job.shadow_data->pass = p_pass;
+}
+
+void RendererSceneCull::_light_instance_shadow_cull(uint32_t p_job, ShadowCullJob *p_jobs) {
+	ShadowCullJob &job = p_jobs[p_job];
+
+	Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&job.planes[0], job.planes.size());
+
+	struct CullConvex {
+		ShadowCullJob *job;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+			if (!p_instance->visible || !((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(p_instance->base_data)->can_cast_shadows || !(job->visible_layers & p_instance->layer_mask)) {
+				return false;
+			}
+			if (static_cast<InstanceGeometryData *>(p_instance->base_data)->material_is_animated) {
+				job->animated_material_found = true;
+			}
+			if (p_instance->mesh_instance.is_valid()) {
+				// Mesh storage isn't thread safe, updates are requested once all jobs are done.
+				job->mesh_instances.push_back(p_instance->mesh_instance);
+			}
+			job->shadow_data->instances.push_back(static_cast<InstanceGeometryData *>(p_instance->base_data)->geometry_instance);
+			return false;
+		}
+	};
+
+	CullConvex cull_convex;
+	cull_convex.job = &job;
+
+	job.scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(job.planes.ptr(), job.planes.size(), points.ptr(), points.size(), cull_convex);
+}
+
 bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold, uint32_t p_visible_layers) {
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform3D light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
-
 	switch (RSG::light_storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
 		} break;
@@ -2311,8 +2362,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				}
 				for (int i = 0; i < 2; i++) {
 					//using this one ensures that raster deferred will have it
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Paraboloid, Half " + itos(i));
-
 					real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
 					real_t z = i == 0 ? -1 : 1;
@@ -2325,48 +2374,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
+					_light_instance_add_shadow_cull(p_instance, i, planes, p_scenario, p_visible_layers);
 
 					RSG::light_storage->light_instance_set_shadow_transform(light->instance, Projection(), light_transform, radius, 0, i, 0);
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
 				}
 			} else { //shadow cube
 
@@ -2379,7 +2389,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				cm.set_perspective(90, 1, radius * 0.005f, radius);
 
 				for (int i = 0; i < 6; i++) {
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Cube, Side " + itos(i));
 					//using this one ensures that raster deferred will have it
 
 					static const Vector3 view_normals[6] = {
@@ -2401,49 +2410,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Transform3D xform = light_transform * Transform3D().looking_at(view_normals[i], view_up[i]);
 
-					Vector<Plane> planes = cm.get_projection_planes(xform);
-
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
+					_light_instance_add_shadow_cull(p_instance, i, cm.get_projection_planes(xform), p_scenario, p_visible_layers);
 
-					RSG::mesh_storage->update_mesh_instances();
 					RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
-
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
 				}
 
 				//restore the regular DP matrix
@@ -2452,8 +2421,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 		} break;
 		case RS::LIGHT_SPOT: {
-			RENDER_TIMESTAMP("Cull SpotLight3D Shadow");
-
 			if (max_shadows_used + 1 > MAX_UPDATE_SHADOWS) {
 				return true;
 			}
@@ -2464,54 +2431,14 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 			Projection cm;
 			cm.set_perspective(angle * 2.0, 1.0, 0.005f * radius, radius);
 
-			Vector<Plane> planes = cm.get_projection_planes(light_transform);
-
-			instance_shadow_cull_result.clear();
-
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
-				}
-			};
-
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
-
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-			for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-					continue;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-
-					if (instance->mesh_instance.is_valid()) {
-						RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-					}
-				}
-				shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-			}
-
-			RSG::mesh_storage->update_mesh_instances();
+			_light_instance_add_shadow_cull(p_instance, 0, cm.get_projection_planes(light_transform), p_scenario, p_visible_layers);
 
 			RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
-			shadow_data.light = light->instance;
-			shadow_data.pass = 0;
 
 		} break;
 	}
 
-	return animated_material_found;
+	return false;
 }
 
 void RendererSceneCull::render_camera(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, uint32_t p_jitter_phase_count, float p_screen_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderInfo *r_render_info) {
@@ -2721,6 +2648,61 @@ void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_d
 	_scene_cull(*cull_data, scene_cull_result_threads[p_thread], cull_from, cull_to);
 }
 
+uint32_t RendererSceneCull::_scene_cull_block(const CullData &cull_data, uint64_t p_from, uint32_t p_count, uint64_t *r_frustum_masks, uint32_t *r_candidates) {
+	static_assert(1 + RendererSceneRender::MAX_DIRECTIONAL_LIGHTS * RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES <= 64, "Frustum masks can't fit all directional shadow cascades.");
+
+	// The caller makes sure the block doesn't cross a page, so bounds are contiguous.
+	const InstanceBounds *bounds = &cull_data.scenario->instance_aabbs[p_from];
+
+	bool reuse = cull_data.frustum_cache_valid;
+	for (uint32_t i = 0; reuse && i < p_count; i++) {
+		reuse = cull_data.scenario->instance_data[p_from + i].bounds_version <= cull_data.frustum_cache->bounds_version;
+	}
+
+	if (reuse) {
+		// Same frustums as last time and no bounds changed in this block, so masks are still valid.
+		memcpy(r_frustum_masks, &cull_data.frustum_cache->masks[p_from], sizeof(uint64_t) * p_count);
+		cull_reused_instance_count.add(p_count);
+	} else {
+		uint8_t inside[SCENE_CULL_BLOCK_SIZE];
+
+		// Bit 0 is the camera frustum, the following ones are directional shadow cascades.
+		InstanceBounds::in_frustum_block(bounds, p_count, cull_data.cull->frustum, inside);
+		for (uint32_t i = 0; i < p_count; i++) {
+			r_frustum_masks[i] = inside[i];
+		}
+
+		for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+			for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+				const uint32_t bit = 1 + j * RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES + k;
+				InstanceBounds::in_frustum_block(bounds, p_count, cull_data.cull->shadows[j].cascades[k].frustum, inside);
+				for (uint32_t i = 0; i < p_count; i++) {
+					r_frustum_masks[i] |= uint64_t(inside[i]) << bit;
+				}
+			}
+		}
+
+		if (cull_data.frustum_cache) {
+			memcpy(&cull_data.frustum_cache->masks[p_from], r_frustum_masks, sizeof(uint64_t) * p_count);
+		}
+	}
+	culled_instance_count.add(p_count);
+
+	// Compact the instances that need further processing. Outside of all frustums, only SDFGI
+	// regions and instances ignoring culling still need work.
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < p_count; i++) {
+		bool candidate = r_frustum_masks[i] != 0 || (cull_data.scenario->instance_data[p_from + i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING);
+		for (uint32_t j = 0; !candidate && j < cull_data.cull->sdfgi.region_count; j++) {
+			candidate = bounds[i].in_aabb(cull_data.cull->sdfgi.region_aabb[j]);
+		}
+		r_candidates[count] = i;
+		count += candidate;
+	}
+
+	return count;
+}
+
 void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to) {
 	uint64_t frame_number = RSG::rasterizer->get_frame_number();
 	float lightmap_probe_update_speed = RSG::light_storage->lightmap_get_probe_capture_update_speed() * RSG::rasterizer->get_frame_delta_time();
@@ -2733,225 +2715,238 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
-	for (uint64_t i = p_from; i < p_to; i++) {
-		bool mesh_visible = false;
+	uint64_t frustum_masks[SCENE_CULL_BLOCK_SIZE];
+	uint32_t candidates[SCENE_CULL_BLOCK_SIZE];
+	const uint64_t page_size = cull_data.scenario->instance_aabbs.get_page_size();
+
+	for (uint64_t block_from = p_from; block_from < p_to;) {
+		// Blocks must not cross pages, as bounds are only contiguous within a page.
+		uint64_t page_end = (block_from / page_size + 1) * page_size;
+		uint32_t block_count = MIN(MIN(p_to, page_end) - block_from, (uint64_t)SCENE_CULL_BLOCK_SIZE);
+		uint32_t candidate_count = _scene_cull_block(cull_data, block_from, block_count, frustum_masks, candidates);
+
+		for (uint32_t c = 0; c < candidate_count; c++) {
+			const uint64_t i = block_from + candidates[c];
+			const uint64_t frustum_mask = frustum_masks[candidates[c]];
+
+			bool mesh_visible = false;
 
-		InstanceData &idata = cull_data.scenario->instance_data[i];
-		uint32_t visibility_flags = idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN | InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
-		int32_t visibility_check = -1;
+			InstanceData &idata = cull_data.scenario->instance_data[i];
+			uint32_t visibility_flags = idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN | InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
+			int32_t visibility_check = -1;
 
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
-#define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define IN_FRUSTUM(m_bit) (frustum_mask & (uint64_t(1) << (m_bit)))
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near))
 
-		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
-				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
-				if (base_type == RS::INSTANCE_LIGHT) {
-					cull_result.lights.push_back(idata.instance);
-					cull_result.light_instances.push_back(RID::from_uint64(idata.instance_data_rid));
-					if (cull_data.shadow_atlas.is_valid() && RSG::light_storage->light_has_shadow(idata.base_rid)) {
-						RSG::light_storage->light_instance_mark_visible(RID::from_uint64(idata.instance_data_rid)); //mark it visible for shadow allocation later
-					}
+			if (!HIDDEN_BY_VISIBILITY_CHECKS) {
+				if ((LAYER_CHECK && IN_FRUSTUM(0) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+					uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
+					if (base_type == RS::INSTANCE_LIGHT) {
+						cull_result.lights.push_back(idata.instance);
+						cull_result.light_instances.push_back(RID::from_uint64(idata.instance_data_rid));
+						if (cull_data.shadow_atlas.is_valid() && RSG::light_storage->light_has_shadow(idata.base_rid)) {
+							RSG::light_storage->light_instance_mark_visible(RID::from_uint64(idata.instance_data_rid)); //mark it visible for shadow allocation later
+						}
 
-				} else if (base_type == RS::INSTANCE_REFLECTION_PROBE) {
-					if (cull_data.render_reflection_probe != idata.instance) {
-						//avoid entering The Matrix
+					} else if (base_type == RS::INSTANCE_REFLECTION_PROBE) {
+						if (cull_data.render_reflection_probe != idata.instance) {
+							//avoid entering The Matrix
 
-						if ((idata.flags & InstanceData::FLAG_REFLECTION_PROBE_DIRTY) || RSG::light_storage->reflection_probe_instance_needs_redraw(RID::from_uint64(idata.instance_data_rid))) {
-							InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(idata.instance->base_data);
-							cull_data.cull->lock.lock();
-							if (!reflection_probe->update_list.in_list()) {
-								reflection_probe->render_step = 0;
-								reflection_probe_render_list.add_last(&reflection_probe->update_list);
+							if ((idata.flags & InstanceData::FLAG_REFLECTION_PROBE_DIRTY) || RSG::light_storage->reflection_probe_instance_needs_redraw(RID::from_uint64(idata.instance_data_rid))) {
+								InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(idata.instance->base_data);
+								cull_data.cull->lock.lock();
+								if (!reflection_probe->update_list.in_list()) {
+									reflection_probe->render_step = 0;
+									reflection_probe_render_list.add_last(&reflection_probe->update_list);
+								}
+								cull_data.cull->lock.unlock();
+
+								idata.flags &= ~uint32_t(InstanceData::FLAG_REFLECTION_PROBE_DIRTY);
 							}
-							cull_data.cull->lock.unlock();
 
-							idata.flags &= ~uint32_t(InstanceData::FLAG_REFLECTION_PROBE_DIRTY);
+							if (RSG::light_storage->reflection_probe_instance_has_reflection(RID::from_uint64(idata.instance_data_rid))) {
+								cull_result.reflections.push_back(RID::from_uint64(idata.instance_data_rid));
+							}
 						}
+					} else if (base_type == RS::INSTANCE_DECAL) {
+						cull_result.decals.push_back(RID::from_uint64(idata.instance_data_rid));
 
-						if (RSG::light_storage->reflection_probe_instance_has_reflection(RID::from_uint64(idata.instance_data_rid))) {
-							cull_result.reflections.push_back(RID::from_uint64(idata.instance_data_rid));
+					} else if (base_type == RS::INSTANCE_VOXEL_GI) {
+						InstanceVoxelGIData *voxel_gi = static_cast<InstanceVoxelGIData *>(idata.instance->base_data);
+						cull_data.cull->lock.lock();
+						if (!voxel_gi->update_element.in_list()) {
+							voxel_gi_update_list.add(&voxel_gi->update_element);
 						}
-					}
-				} else if (base_type == RS::INSTANCE_DECAL) {
-					cull_result.decals.push_back(RID::from_uint64(idata.instance_data_rid));
-
-				} else if (base_type == RS::INSTANCE_VOXEL_GI) {
-					InstanceVoxelGIData *voxel_gi = static_cast<InstanceVoxelGIData *>(idata.instance->base_data);
-					cull_data.cull->lock.lock();
-					if (!voxel_gi->update_element.in_list()) {
-						voxel_gi_update_list.add(&voxel_gi->update_element);
-					}
-					cull_data.cull->lock.unlock();
-					cull_result.voxel_gi_instances.push_back(RID::from_uint64(idata.instance_data_rid));
-
-				} else if (base_type == RS::INSTANCE_LIGHTMAP) {
-					cull_result.lightmaps.push_back(RID::from_uint64(idata.instance_data_rid));
-				} else if (base_type == RS::INSTANCE_FOG_VOLUME) {
-					cull_result.fog_volumes.push_back(RID::from_uint64(idata.instance_data_rid));
-				} else if (base_type == RS::INSTANCE_VISIBLITY_NOTIFIER) {
-					InstanceVisibilityNotifierData *vnd = idata.visibility_notifier;
-					if (!vnd->list_element.in_list()) {
-						visible_notifier_list_lock.lock();
-						visible_notifier_list.add(&vnd->list_element);
-						visible_notifier_list_lock.unlock();
-						vnd->just_visible = true;
-					}
-					vnd->visible_in_frame = RSG::rasterizer->get_frame_number();
-				} else if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && !(idata.flags & InstanceData::FLAG_CAST_SHADOWS_ONLY)) {
-					bool keep = true;
-
-					if (idata.flags & InstanceData::FLAG_REDRAW_IF_VISIBLE) {
-						RenderingServerDefault::redraw_request();
-					}
+						cull_data.cull->lock.unlock();
+						cull_result.voxel_gi_instances.push_back(RID::from_uint64(idata.instance_data_rid));
+
+					} else if (base_type == RS::INSTANCE_LIGHTMAP) {
+						cull_result.lightmaps.push_back(RID::from_uint64(idata.instance_data_rid));
+					} else if (base_type == RS::INSTANCE_FOG_VOLUME) {
+						cull_result.fog_volumes.push_back(RID::from_uint64(idata.instance_data_rid));
+					} else if (base_type == RS::INSTANCE_VISIBLITY_NOTIFIER) {
+						InstanceVisibilityNotifierData *vnd = idata.visibility_notifier;
+						if (!vnd->list_element.in_list()) {
+							visible_notifier_list_lock.lock();
+							visible_notifier_list.add(&vnd->list_element);
+							visible_notifier_list_lock.unlock();
+							vnd->just_visible = true;
+						}
+						vnd->visible_in_frame = RSG::rasterizer->get_frame_number();
+					} else if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && !(idata.flags & InstanceData::FLAG_CAST_SHADOWS_ONLY)) {
+						bool keep = true;
 
-					if (base_type == RS::INSTANCE_MESH) {
-						mesh_visible = true;
-					} else if (base_type == RS::INSTANCE_PARTICLES) {
-						//particles visible? process them
-						if (RSG::particles_storage->particles_is_inactive(idata.base_rid)) {
-							//but if nothing is going on, don't do it.
-							keep = false;
-						} else {
-							cull_data.cull->lock.lock();
-							RSG::particles_storage->particles_request_process(idata.base_rid);
-							cull_data.cull->lock.unlock();
-							RSG::particles_storage->particles_set_view_axis(idata.base_rid, -cull_data.cam_transform.basis.get_column(2).normalized(), cull_data.cam_transform.basis.get_column(1).normalized());
-							//particles visible? request redraw
+						if (idata.flags & InstanceData::FLAG_REDRAW_IF_VISIBLE) {
 							RenderingServerDefault::redraw_request();
 						}
-					}
 
-					if (idata.parent_array_index != -1) {
-						float fade = 1.0f;
-						const uint32_t &parent_flags = cull_data.scenario->instance_data[idata.parent_array_index].flags;
-						if (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN) {
-							const int32_t &parent_idx = cull_data.scenario->instance_data[idata.parent_array_index].visibility_index;
-							fade = cull_data.scenario->instance_visibility[parent_idx].children_fade_alpha;
+						if (base_type == RS::INSTANCE_MESH) {
+							mesh_visible = true;
+						} else if (base_type == RS::INSTANCE_PARTICLES) {
+							//particles visible? process them
+							if (RSG::particles_storage->particles_is_inactive(idata.base_rid)) {
+								//but if nothing is going on, don't do it.
+								keep = false;
+							} else {
+								cull_data.cull->lock.lock();
+								RSG::particles_storage->particles_request_process(idata.base_rid);
+								cull_data.cull->lock.unlock();
+								RSG::particles_storage->particles_set_view_axis(idata.base_rid, -cull_data.cam_transform.basis.get_column(2).normalized(), cull_data.cam_transform.basis.get_column(1).normalized());
+								//particles visible? request redraw
+								RenderingServerDefault::redraw_request();
+							}
 						}
-						idata.instance_geometry->set_parent_fade_alpha(fade);
-					}
 
-					if (geometry_instance_pair_mask & (1 << RS::INSTANCE_LIGHT) && (idata.flags & InstanceData::FLAG_GEOM_LIGHTING_DIRTY)) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
-						uint32_t idx = 0;
-
-						for (const Instance *E : geom->lights) {
-							InstanceLightData *light = static_cast<InstanceLightData *>(E->base_data);
-							instance_pair_buffer[idx++] = light->instance;
-							if (idx == MAX_INSTANCE_PAIRS) {
-								break;
+						if (idata.parent_array_index != -1) {
+							float fade = 1.0f;
+							const uint32_t &parent_flags = cull_data.scenario->instance_data[idata.parent_array_index].flags;
+							if (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN) {
+								const int32_t &parent_idx = cull_data.scenario->instance_data[idata.parent_array_index].visibility_index;
+								fade = cull_data.scenario->instance_visibility[parent_idx].children_fade_alpha;
 							}
+							idata.instance_geometry->set_parent_fade_alpha(fade);
 						}
 
-						ERR_FAIL_NULL(geom->geometry_instance);
-						geom->geometry_instance->pair_light_instances(instance_pair_buffer, idx);
-						idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_LIGHTING_DIRTY);
-					}
+						if (geometry_instance_pair_mask & (1 << RS::INSTANCE_LIGHT) && (idata.flags & InstanceData::FLAG_GEOM_LIGHTING_DIRTY)) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							uint32_t idx = 0;
 
-					if (idata.flags & InstanceData::FLAG_GEOM_PROJECTOR_SOFTSHADOW_DIRTY) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							for (const Instance *E : geom->lights) {
+								InstanceLightData *light = static_cast<InstanceLightData *>(E->base_data);
+								instance_pair_buffer[idx++] = light->instance;
+								if (idx == MAX_INSTANCE_PAIRS) {
+									break;
+								}
+							}
 
-						ERR_FAIL_NULL(geom->geometry_instance);
-						cull_data.cull->lock.lock();
-						geom->geometry_instance->set_softshadow_projector_pairing(geom->softshadow_count > 0, geom->projector_count > 0);
-						cull_data.cull->lock.unlock();
-						idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_PROJECTOR_SOFTSHADOW_DIRTY);
-					}
+							ERR_FAIL_NULL(geom->geometry_instance);
+							geom->geometry_instance->pair_light_instances(instance_pair_buffer, idx);
+							idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_LIGHTING_DIRTY);
+						}
+
+						if (idata.flags & InstanceData::FLAG_GEOM_PROJECTOR_SOFTSHADOW_DIRTY) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
 
-					if (geometry_instance_pair_mask & (1 << RS::INSTANCE_REFLECTION_PROBE) && (idata.flags & InstanceData::FLAG_GEOM_REFLECTION_DIRTY)) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
-						uint32_t idx = 0;
+							ERR_FAIL_NULL(geom->geometry_instance);
+							cull_data.cull->lock.lock();
+							geom->geometry_instance->set_softshadow_projector_pairing(geom->softshadow_count > 0, geom->projector_count > 0);
+							cull_data.cull->lock.unlock();
+							idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_PROJECTOR_SOFTSHADOW_DIRTY);
+						}
 
-						for (const Instance *E : geom->reflection_probes) {
-							InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->base_data);
+						if (geometry_instance_pair_mask & (1 << RS::INSTANCE_REFLECTION_PROBE) && (idata.flags & InstanceData::FLAG_GEOM_REFLECTION_DIRTY)) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							uint32_t idx = 0;
 
-							instance_pair_buffer[idx++] = reflection_probe->instance;
-							if (idx == MAX_INSTANCE_PAIRS) {
-								break;
+							for (const Instance *E : geom->reflection_probes) {
+								InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->base_data);
+
+								instance_pair_buffer[idx++] = reflection_probe->instance;
+								if (idx == MAX_INSTANCE_PAIRS) {
+									break;
+								}
 							}
-						}
 
-						ERR_FAIL_NULL(geom->geometry_instance);
-						geom->geometry_instance->pair_reflection_probe_instances(instance_pair_buffer, idx);
-						idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_REFLECTION_DIRTY);
-					}
+							ERR_FAIL_NULL(geom->geometry_instance);
+							geom->geometry_instance->pair_reflection_probe_instances(instance_pair_buffer, idx);
+							idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_REFLECTION_DIRTY);
+						}
 
-					if (geometry_instance_pair_mask & (1 << RS::INSTANCE_DECAL) && (idata.flags & InstanceData::FLAG_GEOM_DECAL_DIRTY)) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
-						uint32_t idx = 0;
+						if (geometry_instance_pair_mask & (1 << RS::INSTANCE_DECAL) && (idata.flags & InstanceData::FLAG_GEOM_DECAL_DIRTY)) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							uint32_t idx = 0;
 
-						for (const Instance *E : geom->decals) {
-							InstanceDecalData *decal = static_cast<InstanceDecalData *>(E->base_data);
+							for (const Instance *E : geom->decals) {
+								InstanceDecalData *decal = static_cast<InstanceDecalData *>(E->base_data);
 
-							instance_pair_buffer[idx++] = decal->instance;
-							if (idx == MAX_INSTANCE_PAIRS) {
-								break;
+								instance_pair_buffer[idx++] = decal->instance;
+								if (idx == MAX_INSTANCE_PAIRS) {
+									break;
+								}
 							}
-						}
 
-						ERR_FAIL_NULL(geom->geometry_instance);
-						geom->geometry_instance->pair_decal_instances(instance_pair_buffer, idx);
+							ERR_FAIL_NULL(geom->geometry_instance);
+							geom->geometry_instance->pair_decal_instances(instance_pair_buffer, idx);
 
-						idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_DECAL_DIRTY);
-					}
+							idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_DECAL_DIRTY);
+						}
 
-					if (idata.flags & InstanceData::FLAG_GEOM_VOXEL_GI_DIRTY) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
-						uint32_t idx = 0;
-						for (const Instance *E : geom->voxel_gi_instances) {
-							InstanceVoxelGIData *voxel_gi = static_cast<InstanceVoxelGIData *>(E->base_data);
+						if (idata.flags & InstanceData::FLAG_GEOM_VOXEL_GI_DIRTY) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							uint32_t idx = 0;
+							for (const Instance *E : geom->voxel_gi_instances) {
+								InstanceVoxelGIData *voxel_gi = static_cast<InstanceVoxelGIData *>(E->base_data);
 
-							instance_pair_buffer[idx++] = voxel_gi->probe_instance;
-							if (idx == MAX_INSTANCE_PAIRS) {
-								break;
+								instance_pair_buffer[idx++] = voxel_gi->probe_instance;
+								if (idx == MAX_INSTANCE_PAIRS) {
+									break;
+								}
 							}
-						}
 
-						ERR_FAIL_NULL(geom->geometry_instance);
-						geom->geometry_instance->pair_voxel_gi_instances(instance_pair_buffer, idx);
+							ERR_FAIL_NULL(geom->geometry_instance);
+							geom->geometry_instance->pair_voxel_gi_instances(instance_pair_buffer, idx);
 
-						idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_VOXEL_GI_DIRTY);
-					}
+							idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_VOXEL_GI_DIRTY);
+						}
 
-					if ((idata.flags & InstanceData::FLAG_LIGHTMAP_CAPTURE) && idata.instance->last_frame_pass != frame_number && !idata.instance->lightmap_target_sh.is_empty() && !idata.instance->lightmap_sh.is_empty()) {
-						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
-						Color *sh = idata.instance->lightmap_sh.ptrw();
-						const Color *target_sh = idata.instance->lightmap_target_sh.ptr();
-						for (uint32_t j = 0; j < 9; j++) {
-							sh[j] = sh[j].lerp(target_sh[j], MIN(1.0, lightmap_probe_update_speed));
+						if ((idata.flags & InstanceData::FLAG_LIGHTMAP_CAPTURE) && idata.instance->last_frame_pass != frame_number && !idata.instance->lightmap_target_sh.is_empty() && !idata.instance->lightmap_sh.is_empty()) {
+							InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
+							Color *sh = idata.instance->lightmap_sh.ptrw();
+							const Color *target_sh = idata.instance->lightmap_target_sh.ptr();
+							for (uint32_t j = 0; j < 9; j++) {
+								sh[j] = sh[j].lerp(target_sh[j], MIN(1.0, lightmap_probe_update_speed));
+							}
+							ERR_FAIL_NULL(geom->geometry_instance);
+							cull_data.cull->lock.lock();
+							geom->geometry_instance->set_lightmap_capture(sh);
+							cull_data.cull->lock.unlock();
+							idata.instance->last_frame_pass = frame_number;
 						}
-						ERR_FAIL_NULL(geom->geometry_instance);
-						cull_data.cull->lock.lock();
-						geom->geometry_instance->set_lightmap_capture(sh);
-						cull_data.cull->lock.unlock();
-						idata.instance->last_frame_pass = frame_number;
-					}
 
-					if (keep) {
-						cull_result.geometry_instances.push_back(idata.instance_geometry);
+						if (keep) {
+							cull_result.geometry_instances.push_back(idata.instance_geometry);
+						}
 					}
 				}
-			}
 
-			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
-				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
-					if (IN_FRUSTUM(cull_data.cull->shadows[j].cascades[k].frustum) && VIS_CHECK) {
-						uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
+				for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+					for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+						if (IN_FRUSTUM(1 + j * RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES + k) && VIS_CHECK) {
+							uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 
-						if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && idata.flags & InstanceData::FLAG_CAST_SHADOWS && LAYER_CHECK) {
-							cull_result.directional_shadows[j].cascade_geometry_instances[k].push_back(idata.instance_geometry);
-							mesh_visible = true;
+							if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && idata.flags & InstanceData::FLAG_CAST_SHADOWS && LAYER_CHECK) {
+								cull_result.directional_shadows[j].cascade_geometry_instances[k].push_back(idata.instance_geometry);
+								mesh_visible = true;
+							}
 						}
 					}
 				}
 			}
-		}
 
 #undef HIDDEN_BY_VISIBILITY_CHECKS
 #undef LAYER_CHECK
@@ -2961,31 +2956,34 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #undef VIS_CHECK
 #undef OCCLUSION_CULLED
 
-		for (uint32_t j = 0; j < cull_data.cull->sdfgi.region_count; j++) {
-			if (cull_data.scenario->instance_aabbs[i].in_aabb(cull_data.cull->sdfgi.region_aabb[j])) {
-				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
-
-				if (base_type == RS::INSTANCE_LIGHT) {
-					InstanceLightData *instance_light = (InstanceLightData *)idata.instance->base_data;
-					if (instance_light->bake_mode == RS::LIGHT_BAKE_STATIC && cull_data.cull->sdfgi.region_cascade[j] <= instance_light->max_sdfgi_cascade) {
-						if (sdfgi_last_light_index != i || sdfgi_last_light_cascade != cull_data.cull->sdfgi.region_cascade[j]) {
-							sdfgi_last_light_index = i;
-							sdfgi_last_light_cascade = cull_data.cull->sdfgi.region_cascade[j];
-							cull_result.sdfgi_cascade_lights[sdfgi_last_light_cascade].push_back(instance_light->instance);
+			for (uint32_t j = 0; j < cull_data.cull->sdfgi.region_count; j++) {
+				if (cull_data.scenario->instance_aabbs[i].in_aabb(cull_data.cull->sdfgi.region_aabb[j])) {
+					uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
+
+					if (base_type == RS::INSTANCE_LIGHT) {
+						InstanceLightData *instance_light = (InstanceLightData *)idata.instance->base_data;
+						if (instance_light->bake_mode == RS::LIGHT_BAKE_STATIC && cull_data.cull->sdfgi.region_cascade[j] <= instance_light->max_sdfgi_cascade) {
+							if (sdfgi_last_light_index != i || sdfgi_last_light_cascade != cull_data.cull->sdfgi.region_cascade[j]) {
+								sdfgi_last_light_index = i;
+								sdfgi_last_light_cascade = cull_data.cull->sdfgi.region_cascade[j];
+								cull_result.sdfgi_cascade_lights[sdfgi_last_light_cascade].push_back(instance_light->instance);
+							}
+						}
+					} else if ((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) {
+						if (idata.flags & InstanceData::FLAG_USES_BAKED_LIGHT) {
+							cull_result.sdfgi_region_geometry_instances[j].push_back(idata.instance_geometry);
+							mesh_visible = true;
 						}
-					}
-				} else if ((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-					if (idata.flags & InstanceData::FLAG_USES_BAKED_LIGHT) {
-						cull_result.sdfgi_region_geometry_instances[j].push_back(idata.instance_geometry);
-						mesh_visible = true;
 					}
 				}
 			}
-		}
 
-		if (mesh_visible && cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_USES_MESH_INSTANCE) {
-			cull_result.mesh_instances.push_back(cull_data.scenario->instance_data[i].instance->mesh_instance);
+			if (mesh_visible && cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_USES_MESH_INSTANCE) {
+				cull_result.mesh_instances.push_back(cull_data.scenario->instance_data[i].instance->mesh_instance);
+			}
 		}
+
+		block_from += block_count;
 	}
 }
 
@@ -3122,6 +3120,36 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
+
+		if (reuse_static_culling && p_reflection_probe.is_null()) {
+			// Frustum masks of instances that didn't move can be reused if all frustums are exactly the same as in the previous cull.
+			frustum_cache_planes.clear();
+			frustum_cache_plane_counts.clear();
+			for (uint32_t i = 0; i < cull.frustum.plane_count; i++) {
+				frustum_cache_planes.push_back(cull.frustum.planes_ptr[i]);
+			}
+			frustum_cache_plane_counts.push_back(cull.frustum.plane_count);
+			for (uint32_t i = 0; i < cull.shadow_count; i++) {
+				frustum_cache_plane_counts.push_back(cull.shadows[i].cascade_count);
+				for (uint32_t j = 0; j < cull.shadows[i].cascade_count; j++) {
+					const Frustum &frustum = cull.shadows[i].cascades[j].frustum;
+					for (uint32_t k = 0; k < frustum.plane_count; k++) {
+						frustum_cache_planes.push_back(frustum.planes_ptr[k]);
+					}
+					frustum_cache_plane_counts.push_back(frustum.plane_count);
+				}
+			}
+
+			Scenario::FrustumCache &cache = scenario->frustum_caches[p_viewport];
+			const bool same_frustums = cache.update_frustums(frustum_cache_planes, frustum_cache_plane_counts);
+
+			cache.masks.resize(cull_to);
+			cache.last_frame = RSG::rasterizer->get_frame_number();
+
+			cull_data.frustum_cache = &cache;
+			cull_data.frustum_cache_valid = same_frustums;
+		}
+
 //#define DEBUG_CULL_TIME
 #ifdef DEBUG_CULL_TIME
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
@@ -3152,6 +3180,10 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		print_line("time taken: " + rtos(time_avg / time_count));
 #endif
 
+		if (cull_data.frustum_cache) {
+			cull_data.frustum_cache->bounds_version = scenario->instance_bounds_version;
+		}
+
 		if (scene_cull_result.mesh_instances.size()) {
 			for (uint64_t i = 0; i < scene_cull_result.mesh_instances.size(); i++) {
 				RSG::mesh_storage->mesh_instance_check_for_update(scene_cull_result.mesh_instances[i]);
@@ -3183,7 +3215,9 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 			}
 		}
 
-		// Positional Shadowss
+		// Positional Shadows
+		shadow_update_candidates.clear();
+
 		for (uint32_t i = 0; i < (uint32_t)scene_cull_result.lights.size(); i++) {
 			Instance *ins = scene_cull_result.lights[i];
 
@@ -3270,15 +3304,66 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 			bool redraw = RSG::light_storage->shadow_atlas_update_light(p_shadow_atlas, light->instance, coverage, light->last_version);
 
-			if (redraw && max_shadows_used < MAX_UPDATE_SHADOWS) {
+			if (redraw) {
+				ShadowUpdateCandidate candidate;
+				candidate.instance = ins;
+				// Lights that were skipped gain priority, so distant lights are refreshed round-robin.
+				candidate.priority = coverage * (1 + light->shadow_update_wait);
+				shadow_update_candidates.push_back(candidate);
+			} else {
+				light->shadow_dirty = false;
+			}
+		}
+
+		if (max_shadow_updates_per_frame > 0 && shadow_update_candidates.size() > max_shadow_updates_per_frame) {
+			shadow_update_candidates.sort();
+		}
+
+		shadow_cull_jobs_used = 0;
+
+		for (uint32_t i = 0; i < shadow_update_candidates.size(); i++) {
+			Instance *ins = shadow_update_candidates[i].instance;
+			InstanceLightData *light = static_cast<InstanceLightData *>(ins->base_data);
+
+			if (max_shadows_used < MAX_UPDATE_SHADOWS && (max_shadow_updates_per_frame == 0 || i < max_shadow_updates_per_frame)) {
 				//must redraw!
-				RENDER_TIMESTAMP("> Render Light3D " + itos(i));
 				light->shadow_dirty = _light_instance_update_shadow(ins, p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect, p_shadow_atlas, scenario, p_screen_mesh_lod_threshold, p_visible_layers);
-				RENDER_TIMESTAMP("< Render Light3D " + itos(i));
 			} else {
-				light->shadow_dirty = redraw;
+				light->shadow_dirty = true;
+			}
+
+			if (light->shadow_dirty) {
+				light->shadow_update_wait++;
+			} else {
+				light->shadow_update_wait = 0;
 			}
 		}
+
+		if (shadow_cull_jobs_used > 0) {
+			RENDER_TIMESTAMP("> Cull Light3D Shadows");
+
+			if (shadow_cull_jobs_used > 1 && scenario->instance_data.size() > thread_cull_threshold) {
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_light_instance_shadow_cull, shadow_cull_jobs.ptr(), shadow_cull_jobs_used, -1, true, SNAME("RenderCullShadows"));
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			} else {
+				for (uint32_t i = 0; i < shadow_cull_jobs_used; i++) {
+					_light_instance_shadow_cull(i, shadow_cull_jobs.ptr());
+				}
+			}
+
+			for (uint32_t i = 0; i < shadow_cull_jobs_used; i++) {
+				const ShadowCullJob &job = shadow_cull_jobs[i];
+				for (const RID &mesh_instance : job.mesh_instances) {
+					RSG::mesh_storage->mesh_instance_check_for_update(mesh_instance);
+				}
+				if (job.animated_material_found) {
+					static_cast<InstanceLightData *>(job.light->base_data)->shadow_dirty = true;
+				}
+			}
+			RSG::mesh_storage->update_mesh_instances();
+
+			RENDER_TIMESTAMP("< Cull Light3D Shadows");
+		}
 	}
 
 	//render SDFGI
@@ -4029,8 +4114,12 @@ void RendererSceneCull::update_dirty_instances() {
 }
 
 void RendererSceneCull::update() {
+	culled_instance_count.set(0);
+	cull_reused_instance_count.set(0);
+
 	//optimize bvhs
 
+	uint64_t frame_number = RSG::rasterizer->get_frame_number();
 	uint32_t rid_count = scenario_owner.get_rid_count();
 	RID *rids = (RID *)alloca(sizeof(RID) * rid_count);
 	scenario_owner.fill_owned_buffer(rids);
@@ -4038,12 +4127,30 @@ void RendererSceneCull::update() {
 		Scenario *s = scenario_owner.get_or_null(rids[i]);
 		s->indexers[Scenario::INDEXER_GEOMETRY].optimize_incremental(indexer_update_iterations);
 		s->indexers[Scenario::INDEXER_VOLUMES].optimize_incremental(indexer_update_iterations);
+
+		// Drop the culling caches of viewports that stopped rendering this scenario.
+		for (HashMap<RID, Scenario::FrustumCache>::Iterator E = s->frustum_caches.begin(); E;) {
+			HashMap<RID, Scenario::FrustumCache>::Iterator N = E;
+			++N;
+			if (frame_number - E->value.last_frame > FRUSTUM_CACHE_MAX_UNUSED_FRAMES) {
+				s->frustum_caches.remove(E);
+			}
+			E = N;
+		}
 	}
 	scene_render->update();
 	update_dirty_instances();
 	render_particle_colliders();
 }
 
+uint64_t RendererSceneCull::get_culled_instance_count() const {
+	return culled_instance_count.get();
+}
+
+uint64_t RendererSceneCull::get_cull_reused_instance_count() const {
+	return cull_reused_instance_count.get();
+}
+
 bool RendererSceneCull::free(RID p_rid) {
 	if (p_rid.is_null()) {
 		return true;
@@ -4145,7 +4252,6 @@ RendererSceneCull::RendererSceneCull() {
 	singleton = this;
 
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
-	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
@@ -4163,13 +4269,14 @@ RendererSceneCull::RendererSceneCull() {
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
+	reuse_static_culling = GLOBAL_GET("rendering/limits/spatial_indexer/reuse_static_culling");
+	max_shadow_updates_per_frame = GLOBAL_GET("rendering/lights_and_shadows/positional_shadow/max_updates_per_frame");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	fallback_occlusion_culling = memnew(RasterOcclusionCull);
 }
 
 RendererSceneCull::~RendererSceneCull() {
 	instance_cull_result.reset();
-	instance_shadow_cull_result.reset();
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.reset();
@@ -4184,7 +4291,7 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (fallback_occlusion_culling) {
+		memdelete(fallback_occlusion_culling);
 	}
 }
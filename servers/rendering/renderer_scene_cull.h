@@ -54,7 +54,9 @@ public:
 		SDFGI_MAX_CASCADES = 8,
 		SDFGI_MAX_REGIONS_PER_CASCADE = 3,
 		MAX_INSTANCE_PAIRS = 32,
-		MAX_UPDATE_SHADOWS = 512
+		MAX_UPDATE_SHADOWS = 512,
+		SCENE_CULL_BLOCK_SIZE = 128,
+		FRUSTUM_CACHE_MAX_UNUSED_FRAMES = 60
 	};
 
 	uint64_t render_pass;
@@ -116,7 +118,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *fallback_occlusion_culling = nullptr; // Used unless a module provides its own implementation.
 
 	/* SCENARIO API */
 
@@ -215,6 +217,26 @@ public:
 
 			return true;
 		}
+		// Same test as in_frustum(), for a contiguous run of bounds. Planes are tested in the
+		// outer loop so the inner loop is branchless and can be vectorized by the compiler.
+		static _ALWAYS_INLINE_ void in_frustum_block(const InstanceBounds *p_bounds, uint32_t p_count, const Frustum &p_frustum, uint8_t *r_inside) {
+			for (uint32_t j = 0; j < p_count; j++) {
+				r_inside[j] = 1;
+			}
+
+			for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+				const Plane &plane = p_frustum.planes_ptr[i];
+				const uint32_t sign_x = p_frustum.plane_signs_ptr[i].signs[0];
+				const uint32_t sign_y = p_frustum.plane_signs_ptr[i].signs[1];
+				const uint32_t sign_z = p_frustum.plane_signs_ptr[i].signs[2];
+
+				for (uint32_t j = 0; j < p_count; j++) {
+					const real_t *bounds = p_bounds[j].bounds;
+					real_t distance = plane.normal.x * bounds[sign_x] + plane.normal.y * bounds[sign_y] + plane.normal.z * bounds[sign_z] - plane.d;
+					r_inside[j] &= uint8_t(distance < 0.0);
+				}
+			}
+		}
 		_ALWAYS_INLINE_ bool in_aabb(const AABB &p_aabb) const {
 			Vector3 end = p_aabb.position + p_aabb.size;
 
@@ -279,6 +301,7 @@ public:
 		Instance *instance = nullptr;
 		int32_t parent_array_index = -1;
 		int32_t visibility_index = -1;
+		uint64_t bounds_version = 0; // Scenario::instance_bounds_version when the bounds last changed.
 	};
 
 	struct InstanceVisibilityData {
@@ -335,6 +358,35 @@ public:
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
+		// Frustum masks from the last cull of each viewport. As long as the camera and shadow
+		// frustums are identical, only instances whose bounds changed since need to be tested again.
+		struct FrustumCache {
+			LocalVector<Plane> planes;
+			LocalVector<uint32_t> plane_counts;
+			LocalVector<uint64_t> masks;
+			uint64_t bounds_version = 0;
+			uint64_t last_frame = 0;
+
+			// Stores the frustums of a new cull, returns whether they are exactly the ones of the previous cull.
+			bool update_frustums(const LocalVector<Plane> &p_planes, const LocalVector<uint32_t> &p_plane_counts) {
+				bool same_frustums = planes.size() == p_planes.size() && plane_counts.size() == p_plane_counts.size();
+				for (uint32_t i = 0; same_frustums && i < p_planes.size(); i++) {
+					same_frustums = planes[i] == p_planes[i];
+				}
+				for (uint32_t i = 0; same_frustums && i < p_plane_counts.size(); i++) {
+					same_frustums = plane_counts[i] == p_plane_counts[i];
+				}
+				if (!same_frustums) {
+					planes = p_planes;
+					plane_counts = p_plane_counts;
+				}
+				return same_frustums;
+			}
+		};
+
+		HashMap<RID, FrustumCache> frustum_caches;
+		uint64_t instance_bounds_version = 0;
+
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
 			indexers[INDEXER_VOLUMES].set_index(INDEXER_VOLUMES);
@@ -680,6 +732,7 @@ public:
 		List<Instance *>::Element *D; // directional light in scenario
 
 		bool shadow_dirty;
+		uint32_t shadow_update_wait = 0; // Shadow redraws skipped in a row because of the update budget.
 		bool uses_projector = false;
 		bool uses_softshadow = false;
 
@@ -817,7 +870,6 @@ public:
 	PagedArrayPool<RID> rid_cull_page_pool;
 
 	PagedArray<Instance *> instance_cull_result;
-	PagedArray<Instance *> instance_shadow_cull_result;
 
 	struct InstanceCullResult {
 		PagedArray<RenderGeometryInstance *> geometry_instances;
@@ -950,6 +1002,12 @@ public:
 
 	uint32_t thread_cull_threshold = 200;
 
+	bool reuse_static_culling = true;
+	LocalVector<Plane> frustum_cache_planes;
+	LocalVector<uint32_t> frustum_cache_plane_counts;
+	SafeNumeric<uint64_t> culled_instance_count;
+	SafeNumeric<uint64_t> cull_reused_instance_count;
+
 	RID_Owner<Instance, true> instance_owner;
 
 	uint32_t geometry_instance_pair_mask = 0; // used in traditional forward, unnecessary on clustered
@@ -1013,6 +1071,32 @@ public:
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
+	struct ShadowCullJob {
+		Instance *light = nullptr;
+		Scenario *scenario = nullptr;
+		Vector<Plane> planes;
+		uint32_t visible_layers = 0;
+		RendererSceneRender::RenderShadowData *shadow_data = nullptr;
+		bool animated_material_found = false;
+		LocalVector<RID> mesh_instances;
+	};
+
+	struct ShadowUpdateCandidate {
+		Instance *instance = nullptr;
+		float priority = 0.0;
+
+		bool operator<(const ShadowUpdateCandidate &p_candidate) const {
+			return priority > p_candidate.priority;
+		}
+	};
+
+	LocalVector<ShadowCullJob> shadow_cull_jobs;
+	uint32_t shadow_cull_jobs_used = 0;
+	LocalVector<ShadowUpdateCandidate> shadow_update_candidates;
+	uint32_t max_shadow_updates_per_frame = 0;
+
+	void _light_instance_add_shadow_cull(Instance *p_instance, uint32_t p_pass, const Vector<Plane> &p_planes, Scenario *p_scenario, uint32_t p_visible_layers);
+	void _light_instance_shadow_cull(uint32_t p_job, ShadowCullJob *p_jobs);
 	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_mesh_lod_threshold, uint32_t p_visible_layers = 0xFFFFFF);
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
@@ -1078,10 +1162,13 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		Scenario::FrustumCache *frustum_cache = nullptr;
+		bool frustum_cache_valid = false;
 	};
 
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
+	uint32_t _scene_cull_block(const CullData &cull_data, uint64_t p_from, uint32_t p_count, uint64_t *r_frustum_masks, uint32_t *r_candidates);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
 
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
@@ -1294,6 +1381,9 @@ public:
 
 	virtual void update();
 
+	virtual uint64_t get_culled_instance_count() const;
+	virtual uint64_t get_cull_reused_instance_count() const;
+
 	bool free(RID p_rid);
 
 	void set_scene_render(RendererSceneRender *p_scene_render);
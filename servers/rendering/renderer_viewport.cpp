@@ -280,6 +280,7 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 			p_viewport->render_info.info[i][j] = 0;
 		}
 	}
+	p_viewport->render_info.canvas_items_in_frame = 0;
 
 	if (RSG::scene->is_scenario(p_viewport->scenario)) {
 		RID environment = RSG::scene->scenario_get_environment(p_viewport->scenario);
@@ -719,6 +720,7 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 	int vertices_drawn = 0;
 	int objects_drawn = 0;
 	int draw_calls_used = 0;
+	int canvas_items_drawn = 0;
 
 	for (int i = 0; i < sorted_active_viewports.size(); i++) {
 		Viewport *vp = sorted_active_viewports[i];
@@ -814,12 +816,14 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 		objects_drawn += vp->render_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME];
 		vertices_drawn += vp->render_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME];
 		draw_calls_used += vp->render_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME];
+		canvas_items_drawn += vp->render_info.canvas_items_in_frame;
 	}
 	RSG::scene->set_debug_draw_mode(RS::VIEWPORT_DEBUG_DRAW_DISABLED);
 
 	total_objects_drawn = objects_drawn;
 	total_vertices_drawn = vertices_drawn;
 	total_draw_calls_used = draw_calls_used;
+	total_canvas_items_drawn = canvas_items_drawn;
 
 	RENDER_TIMESTAMP("< Render Viewports");
 
@@ -1498,6 +1502,9 @@ int RendererViewport::get_total_primitives_drawn() const {
 int RendererViewport::get_total_draw_calls_used() const {
 	return total_draw_calls_used;
 }
+int RendererViewport::get_total_canvas_items_drawn() const {
+	return total_canvas_items_drawn;
+}
 
 int RendererViewport::get_num_viewports_with_motion_vectors() const {
 	return num_viewports_with_motion_vectors;
@@ -198,6 +198,7 @@ public:
 	int total_objects_drawn = 0;
 	int total_vertices_drawn = 0;
 	int total_draw_calls_used = 0;
+	int total_canvas_items_drawn = 0;
 
 	int num_viewports_with_motion_vectors = 0;
 
@@ -306,6 +307,7 @@ public:
 	int get_total_objects_drawn() const;
 	int get_total_primitives_drawn() const;
 	int get_total_draw_calls_used() const;
+	int get_total_canvas_items_drawn() const;
 	int get_num_viewports_with_motion_vectors() const;
 
 	// Workaround for setting this on thread.
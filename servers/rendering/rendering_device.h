@@ -944,7 +944,7 @@ private:
 		uint32_t push_constant_size = 0;
 	};
 
-	RID_Owner<RenderPipeline> render_pipeline_owner;
+	RID_Owner<RenderPipeline, true> render_pipeline_owner; // Pipelines may be created by background compilation while lists are recorded.
 
 	bool pipelines_cache_enabled = false;
 	size_t pipelines_cache_size = 0;
@@ -299,12 +299,16 @@ public:
 
 	struct RenderInfo {
 		int info[RS::VIEWPORT_RENDER_INFO_TYPE_MAX][RS::VIEWPORT_RENDER_INFO_MAX] = {};
+		int canvas_items_in_frame = 0;
 	};
 
 	virtual void render_camera(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, uint32_t p_jitter_phase_count, float p_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderInfo *r_render_info = nullptr) = 0;
 
 	virtual void update() = 0;
 	virtual void render_probes() = 0;
+
+	virtual uint64_t get_culled_instance_count() const = 0;
+	virtual uint64_t get_cull_reused_instance_count() const = 0;
 	virtual void update_visibility_notifiers() = 0;
 
 	virtual void decals_set_filter(RS::DecalFilter p_filter) = 0;
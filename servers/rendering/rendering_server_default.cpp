@@ -254,6 +254,12 @@ uint64_t RenderingServerDefault::get_rendering_info(RenderingInfo p_info) {
 		return RSG::viewport->get_total_primitives_drawn();
 	} else if (p_info == RENDERING_INFO_TOTAL_DRAW_CALLS_IN_FRAME) {
 		return RSG::viewport->get_total_draw_calls_used();
+	} else if (p_info == RENDERING_INFO_TOTAL_INSTANCES_CULLED_IN_FRAME) {
+		return RSG::scene->get_culled_instance_count();
+	} else if (p_info == RENDERING_INFO_TOTAL_INSTANCES_CULL_REUSED_IN_FRAME) {
+		return RSG::scene->get_cull_reused_instance_count();
+	} else if (p_info == RENDERING_INFO_TOTAL_CANVAS_ITEMS_IN_FRAME) {
+		return RSG::viewport->get_total_canvas_items_drawn();
 	}
 	return RSG::utilities->get_rendering_info(p_info);
 }
@@ -1455,7 +1455,58 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
+bool ShaderCompiler::_compile_from_cache(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	HashMap<String, CompileCacheEntry>::Iterator E = compile_cache.find(p_code);
+	if (!E) {
+		return false;
+	}
+
+	const CompileCacheEntry &entry = E->value;
+	if (entry.mode != p_mode) {
+		return false;
+	}
+	for (const KeyValue<StringName, SL::DataType> &G : entry.global_uniform_types) {
+		if (_get_global_shader_uniform_type(G.key) != G.value) {
+			compile_cache.remove(E); // A global uniform changed type, compile again to report it.
+			return false;
+		}
+	}
+
+	// Replay the side effects the compilation had on the actions.
+	for (const StringName &mode : entry.render_modes) {
+		if (p_actions->render_mode_flags.has(mode)) {
+			*p_actions->render_mode_flags[mode] = true;
+		}
+		if (p_actions->render_mode_values.has(mode)) {
+			Pair<int *, int> &p = p_actions->render_mode_values[mode];
+			*p.first = p.second;
+		}
+	}
+	for (const StringName &name : entry.usage_flags) {
+		if (p_actions->usage_flag_pointers.has(name)) {
+			*p_actions->usage_flag_pointers[name] = true;
+		}
+	}
+	for (const StringName &name : entry.write_flags) {
+		if (p_actions->write_flag_pointers.has(name)) {
+			*p_actions->write_flag_pointers[name] = true;
+		}
+	}
+	if (p_actions->uniforms) {
+		for (const KeyValue<StringName, SL::ShaderNode::Uniform> &U : entry.uniforms) {
+			p_actions->uniforms->insert(U.key, U.value);
+		}
+	}
+
+	r_gen_code = entry.gen_code;
+	return true;
+}
+
 Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	if (_compile_from_cache(p_mode, p_code, p_actions, r_gen_code)) {
+		return OK;
+	}
+
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1558,13 +1609,53 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 
 	shader = parser.get_shader();
 	function = nullptr;
-	_dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+
+	// Write flags are set in many places, so record them through local flags instead of the caller's.
+	IdentifierActions recording_actions = *p_actions;
+	HashMap<StringName, bool> written;
+	for (KeyValue<StringName, bool *> &E : recording_actions.write_flag_pointers) {
+		written[E.key] = false;
+		E.value = &written[E.key];
+	}
+	HashMap<StringName, SL::ShaderNode::Uniform> uniforms;
+	recording_actions.uniforms = &uniforms;
+
+	_dump_node_code(shader, 1, r_gen_code, recording_actions, actions, false);
+
+	CompileCacheEntry entry;
+	entry.mode = p_mode;
+	entry.gen_code = r_gen_code;
+	entry.render_modes = shader->render_modes;
+	for (const StringName &E : used_flag_pointers) {
+		entry.usage_flags.push_back(E);
+	}
+	for (const KeyValue<StringName, bool> &E : written) {
+		if (E.value) {
+			entry.write_flags.push_back(E.key);
+			*p_actions->write_flag_pointers[E.key] = true;
+		}
+	}
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : uniforms) {
+		if (E.value.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL) {
+			entry.global_uniform_types[E.key] = _get_global_shader_uniform_type(E.key);
+		}
+		if (p_actions->uniforms) {
+			p_actions->uniforms->insert(E.key, E.value);
+		}
+	}
+	entry.uniforms = uniforms;
+
+	if (compile_cache.size() >= COMPILE_CACHE_MAX_ENTRIES) {
+		compile_cache.remove(compile_cache.begin()); // Oldest first, HashMap keeps the insertion order.
+	}
+	compile_cache.insert(p_code, entry);
 
 	return OK;
 }
 
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
+	compile_cache.clear();
 
 	time_name = "TIME";
 
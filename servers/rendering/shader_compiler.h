@@ -31,6 +31,7 @@
 #ifndef SHADER_COMPILER_H
 #define SHADER_COMPILER_H
 
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "servers/rendering/shader_language.h"
 #include "servers/rendering_server.h"
@@ -125,6 +126,26 @@ private:
 
 	DefaultIdentifierActions actions;
 
+	// Results of successful compilations, keyed by the shader code. Identical code is common
+	// (duplicated or embedded shaders, includes being re-saved), so parsing it again is avoided.
+	struct CompileCacheEntry {
+		RS::ShaderMode mode;
+		GeneratedCode gen_code;
+		Vector<StringName> render_modes;
+		LocalVector<StringName> usage_flags;
+		LocalVector<StringName> write_flags;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+		HashMap<StringName, ShaderLanguage::DataType> global_uniform_types; // The compilation is only valid while these don't change.
+	};
+
+	enum {
+		COMPILE_CACHE_MAX_ENTRIES = 256
+	};
+
+	HashMap<String, CompileCacheEntry> compile_cache;
+
+	bool _compile_from_cache(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
 public:
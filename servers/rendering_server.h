@@ -1421,6 +1421,8 @@ public:
 
 	virtual void canvas_item_set_canvas_group_mode(RID p_item, CanvasGroupMode p_mode, float p_clear_margin = 5.0, bool p_fit_empty = false, float p_fit_margin = 0.0, bool p_blur_mipmaps = false) = 0;
 
+	virtual void canvas_item_set_static_subtree(RID p_item, bool p_enabled) = 0;
+
 	virtual void canvas_item_set_debug_redraw(bool p_enabled) = 0;
 	virtual bool canvas_item_get_debug_redraw() const = 0;
 
@@ -1571,6 +1573,9 @@ public:
 		RENDERING_INFO_TEXTURE_MEM_USED,
 		RENDERING_INFO_BUFFER_MEM_USED,
 		RENDERING_INFO_VIDEO_MEM_USED,
+		RENDERING_INFO_TOTAL_INSTANCES_CULLED_IN_FRAME,
+		RENDERING_INFO_TOTAL_INSTANCES_CULL_REUSED_IN_FRAME,
+		RENDERING_INFO_TOTAL_CANVAS_ITEMS_IN_FRAME,
 		RENDERING_INFO_MAX
 	};
 
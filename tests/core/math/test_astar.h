@@ -32,6 +32,8 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -357,6 +359,164 @@ TEST_CASE("[Stress][AStar3D] Find paths") {
 		CHECK_MESSAGE(match, "Found all paths.");
 	}
 }
+
+static real_t get_path_length(const Vector<Vector2> &p_path) {
+	real_t length = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
+// Walls on every other column, open at the bottom and the top in turns, making a single winding corridor.
+static void fill_maze(AStarGrid2D &r_grid) {
+	const Size2i size = r_grid.get_region().size;
+	for (int x = 1; x < size.x; x += 2) {
+		const int gap_y = (x / 2) % 2 == 0 ? size.y - 1 : 0;
+		for (int y = 0; y < size.y; y++) {
+			if (y != gap_y) {
+				r_grid.set_point_solid(Vector2i(x, y));
+			}
+		}
+	}
+}
+
+// Scattered obstacles, some points may end up unreachable.
+static void fill_open(AStarGrid2D &r_grid, uint64_t p_seed) {
+	const Size2i size = r_grid.get_region().size;
+	Math::seed(p_seed);
+	for (int i = 0; i < size.x * size.y / 8; i++) {
+		r_grid.set_point_solid(Vector2i(Math::rand() % size.x, Math::rand() % size.y));
+	}
+}
+
+static void check_jumping_matches_plain_search(AStarGrid2D &r_plain_grid, AStarGrid2D &r_jumping_grid, const Vector2i &p_from, const Vector2i &p_to) {
+	const Vector<Vector2> plain_path = r_plain_grid.get_point_path(p_from, p_to);
+	const Vector<Vector2> jumping_path = r_jumping_grid.get_point_path(p_from, p_to);
+	CHECK_MESSAGE(plain_path.is_empty() == jumping_path.is_empty(), vformat("From %s to %s: only one search found a path.", p_from, p_to));
+	CHECK_MESSAGE(Math::is_equal_approx(get_path_length(plain_path), get_path_length(jumping_path), (real_t)0.01), vformat("From %s to %s: paths have different lengths.", p_from, p_to));
+}
+
+TEST_CASE("[AStarGrid2D] Jumping should find paths as short as plain search") {
+	const int size = 32;
+	const AStarGrid2D::DiagonalMode diagonal_modes[] = {
+		AStarGrid2D::DIAGONAL_MODE_ALWAYS,
+		AStarGrid2D::DIAGONAL_MODE_NEVER,
+		AStarGrid2D::DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE,
+		AStarGrid2D::DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES,
+	};
+
+	for (AStarGrid2D::DiagonalMode diagonal_mode : diagonal_modes) {
+		for (int map = 0; map < 2; map++) {
+			AStarGrid2D plain_grid;
+			AStarGrid2D jumping_grid;
+			for (AStarGrid2D *grid : { &plain_grid, &jumping_grid }) {
+				grid->set_region(Rect2i(-4, 3, size, size));
+				grid->set_diagonal_mode(diagonal_mode);
+				grid->update();
+				if (map == 0) {
+					fill_maze(*grid);
+				} else {
+					fill_open(*grid, diagonal_mode);
+				}
+			}
+			jumping_grid.set_jumping_enabled(true);
+
+			Math::seed(map);
+			for (int i = 0; i < 50; i++) {
+				const Vector2i from = Vector2i(-4 + Math::rand() % size, 3 + Math::rand() % size);
+				const Vector2i to = Vector2i(-4 + Math::rand() % size, 3 + Math::rand() % size);
+				if (!plain_grid.is_point_solid(from)) {
+					check_jumping_matches_plain_search(plain_grid, jumping_grid, from, to);
+				}
+			}
+
+			// Changing single points only updates the precomputed jumps around them.
+			for (int i = 0; i < 20; i++) {
+				const Vector2i id = Vector2i(-4 + Math::rand() % size, 3 + Math::rand() % size);
+				const bool solid = !plain_grid.is_point_solid(id);
+				plain_grid.set_point_solid(id, solid);
+				jumping_grid.set_point_solid(id, solid);
+			}
+			for (int i = 0; i < 50; i++) {
+				const Vector2i from = Vector2i(-4 + Math::rand() % size, 3 + Math::rand() % size);
+				const Vector2i to = Vector2i(-4 + Math::rand() % size, 3 + Math::rand() % size);
+				if (!plain_grid.is_point_solid(from)) {
+					check_jumping_matches_plain_search(plain_grid, jumping_grid, from, to);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("[AStarGrid2D] Jumping should cross runs longer than the longest precomputed jump") {
+	const int length = 70000;
+	AStarGrid2D plain_grid;
+	AStarGrid2D jumping_grid;
+	for (AStarGrid2D *grid : { &plain_grid, &jumping_grid }) {
+		grid->set_region(Rect2i(0, 0, length, 3));
+		grid->update();
+		// Far away jump points, past several runs of the longest precomputed jump.
+		grid->set_point_solid(Vector2i(length - 2000, 0));
+		grid->set_point_solid(Vector2i(length - 2000, 2));
+	}
+	jumping_grid.set_jumping_enabled(true);
+
+	check_jumping_matches_plain_search(plain_grid, jumping_grid, Vector2i(0, 1), Vector2i(length - 1, 1));
+	check_jumping_matches_plain_search(plain_grid, jumping_grid, Vector2i(0, 0), Vector2i(length - 1, 2));
+	check_jumping_matches_plain_search(plain_grid, jumping_grid, Vector2i(length - 1, 0), Vector2i(0, 2));
+	// No jump point lies before the end, so the search jumps straight to it.
+	CHECK_EQ(jumping_grid.get_id_path(Vector2i(0, 1), Vector2i(length - 3000, 1)).size(), 2);
+}
+
+TEST_CASE("[Stress][AStarGrid2D] Compare plain search and jumping on maze and open maps") {
+	const int size = 256;
+	const char *map_names[] = { "maze", "open" };
+
+	for (int map = 0; map < 2; map++) {
+		AStarGrid2D plain_grid;
+		AStarGrid2D jumping_grid;
+		for (AStarGrid2D *grid : { &plain_grid, &jumping_grid }) {
+			grid->set_region(Rect2i(0, 0, size, size));
+			grid->update();
+			if (map == 0) {
+				fill_maze(*grid);
+			} else {
+				fill_open(*grid, 0);
+			}
+		}
+		jumping_grid.set_jumping_enabled(true);
+
+		// The first search precomputes the jumps, time it apart from the others.
+		uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+		jumping_grid.get_point_path(Vector2i(0, 0), Vector2i(2, 0));
+		const uint64_t precompute_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+		uint64_t plain_usec = 0;
+		uint64_t jumping_usec = 0;
+		Math::seed(map);
+		for (int i = 0; i < 10; i++) {
+			const Vector2i from = Vector2i(Math::rand() % size, Math::rand() % size);
+			const Vector2i to = Vector2i(Math::rand() % size, Math::rand() % size);
+			if (plain_grid.is_point_solid(from)) {
+				continue;
+			}
+
+			begin_usec = OS::get_singleton()->get_ticks_usec();
+			const Vector<Vector2> plain_path = plain_grid.get_point_path(from, to);
+			plain_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+			begin_usec = OS::get_singleton()->get_ticks_usec();
+			const Vector<Vector2> jumping_path = jumping_grid.get_point_path(from, to);
+			jumping_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+			CHECK_EQ(plain_path.is_empty(), jumping_path.is_empty());
+			CHECK(Math::is_equal_approx(get_path_length(plain_path), get_path_length(jumping_path), (real_t)0.01));
+		}
+
+		print_verbose(vformat("%s %dx%d: plain search %d usec, jumping %d usec (+%d usec to precompute jumps).", map_names[map], size, size, plain_usec, jumping_usec, precompute_usec));
+	}
+}
 } // namespace TestAStar
 
 #endif // TEST_ASTAR_H
@@ -0,0 +1,169 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "core/os/os.h"
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+// A square in the XY plane, made of p_divisions * p_divisions quads.
+static void create_grid_occluder(RasterOcclusionCull *p_cull, RID p_occluder, real_t p_size, int p_divisions) {
+	PackedVector3Array vertices;
+	PackedInt32Array indices;
+	for (int y = 0; y <= p_divisions; y++) {
+		for (int x = 0; x <= p_divisions; x++) {
+			vertices.push_back(Vector3((real_t(x) / p_divisions - 0.5) * p_size, (real_t(y) / p_divisions - 0.5) * p_size, 0.0));
+		}
+	}
+	for (int y = 0; y < p_divisions; y++) {
+		for (int x = 0; x < p_divisions; x++) {
+			int i = y * (p_divisions + 1) + x;
+			indices.append_array({ i, i + 1, i + p_divisions + 2, i, i + p_divisions + 2, i + p_divisions + 1 });
+		}
+	}
+	p_cull->occluder_set_mesh(p_occluder, vertices, indices);
+}
+
+static bool is_box_occluded(const RasterOcclusionCull::HZBuffer *p_buffer, const AABB &p_box, const Transform3D &p_cam_transform, const Projection &p_cam_projection) {
+	real_t bounds[6] = { p_box.position.x, p_box.position.y, p_box.position.z, p_box.get_end().x, p_box.get_end().y, p_box.get_end().z };
+	return p_buffer->is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near());
+}
+
+TEST_CASE("[RasterOcclusionCull] Boxes behind an occluder should be culled") {
+	RasterOcclusionCull *cull = memnew(RasterOcclusionCull);
+	const RID scenario = RID::from_uint64(1);
+	const RID instance = RID::from_uint64(2);
+	const RID buffer = RID::from_uint64(3);
+
+	RID occluder = cull->occluder_allocate();
+	cull->occluder_initialize(occluder);
+	create_grid_occluder(cull, occluder, 8.0, 1);
+
+	cull->add_scenario(scenario);
+	cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -10)), true);
+	cull->add_buffer(buffer);
+	cull->buffer_set_scenario(buffer, scenario);
+	cull->buffer_set_size(buffer, Vector2i(160, 90));
+
+	// The camera looks down -Z, the occluder covers about 22 degrees around the view axis.
+	Transform3D cam_transform;
+	Projection cam_projection;
+	cam_projection.set_perspective(75.0, 16.0 / 9.0, 0.05, 100.0);
+	cull->buffer_update(buffer, cam_transform, cam_projection, false);
+	const RasterOcclusionCull::HZBuffer *hz_buffer = cull->buffer_get_ptr(buffer);
+	REQUIRE(hz_buffer);
+
+	CHECK_MESSAGE(is_box_occluded(hz_buffer, AABB(Vector3(-1, -1, -21), Vector3(2, 2, 2)), cam_transform, cam_projection), "A box behind the occluder should be culled.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(hz_buffer, AABB(Vector3(-1, -1, -6), Vector3(2, 2, 2)), cam_transform, cam_projection), "A box in front of the occluder should be visible.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(hz_buffer, AABB(Vector3(14, -1, -31), Vector3(2, 2, 2)), cam_transform, cam_projection), "A box beside the occluder should be visible.");
+
+	// Seen from behind, the occluder is double-sided and still hides the box on the other side.
+	Transform3D back_cam_transform = Transform3D(Basis(Vector3(0, 1, 0), Math_PI), Vector3(0, 0, -30));
+	cull->buffer_update(buffer, back_cam_transform, cam_projection, false);
+	CHECK_MESSAGE(is_box_occluded(hz_buffer, AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)), back_cam_transform, cam_projection), "Occluders should be double-sided.");
+
+	cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -10)), false);
+	cull->buffer_update(buffer, cam_transform, cam_projection, false);
+	CHECK_FALSE_MESSAGE(is_box_occluded(hz_buffer, AABB(Vector3(-1, -1, -21), Vector3(2, 2, 2)), cam_transform, cam_projection), "Disabled occluders should not cull anything.");
+
+	cull->remove_buffer(buffer);
+	cull->scenario_remove_instance(scenario, instance);
+	cull->remove_scenario(scenario);
+	cull->free_occluder(occluder);
+	memdelete(cull);
+}
+
+TEST_CASE("[Stress][RasterOcclusionCull] Rasterize occluders and cull boxes") {
+	RasterOcclusionCull *cull = memnew(RasterOcclusionCull);
+	const RID scenario = RID::from_uint64(1);
+	const RID buffer = RID::from_uint64(2);
+	const int instance_count = 256;
+	const int box_count = 100000;
+	const int iterations = 20;
+
+	RID occluder = cull->occluder_allocate();
+	cull->occluder_initialize(occluder);
+	create_grid_occluder(cull, occluder, 6.0, 8);
+
+	cull->add_scenario(scenario);
+	Math::seed(instance_count);
+	for (int i = 0; i < instance_count; i++) {
+		Transform3D xform = Transform3D(Basis(Vector3(0, 1, 0), Math::random(-Math_PI, Math_PI)), Vector3(Math::random(-100.0, 100.0), Math::random(-5.0, 5.0), Math::random(-100.0, 0.0)));
+		cull->scenario_set_instance(scenario, RID::from_uint64(100 + i), occluder, xform, true);
+	}
+	cull->add_buffer(buffer);
+	cull->buffer_set_scenario(buffer, scenario);
+	cull->buffer_set_size(buffer, Vector2i(512, 288));
+
+	LocalVector<AABB> boxes;
+	for (int i = 0; i < box_count; i++) {
+		boxes.push_back(AABB(Vector3(Math::random(-100.0, 100.0), Math::random(-5.0, 5.0), Math::random(-100.0, 0.0)), Vector3(1, 1, 1)));
+	}
+
+	Transform3D cam_transform = Transform3D(Basis(), Vector3(0, 0, 10));
+	Projection cam_projection;
+	cam_projection.set_perspective(75.0, 16.0 / 9.0, 0.05, 200.0);
+
+	uint64_t rasterize_usec = 0;
+	uint64_t cull_usec = 0;
+	int occluded_count = 0;
+	for (int iteration = 0; iteration < iterations; iteration++) {
+		uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+		cull->buffer_update(buffer, cam_transform, cam_projection, false);
+		rasterize_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+		const RasterOcclusionCull::HZBuffer *hz_buffer = cull->buffer_get_ptr(buffer);
+		begin_usec = OS::get_singleton()->get_ticks_usec();
+		occluded_count = 0;
+		for (const AABB &box : boxes) {
+			occluded_count += is_box_occluded(hz_buffer, box, cam_transform, cam_projection);
+		}
+		cull_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+	}
+
+	print_verbose(vformat("Rasterizing %d occluders: %d usec, culling %d boxes: %d usec, %d boxes occluded.", instance_count, rasterize_usec / iterations, box_count, cull_usec / iterations, occluded_count));
+	CHECK(occluded_count > 0);
+
+	cull->remove_buffer(buffer);
+	for (int i = 0; i < instance_count; i++) {
+		cull->scenario_remove_instance(scenario, RID::from_uint64(100 + i));
+	}
+	cull->remove_scenario(scenario);
+	cull->free_occluder(occluder);
+	memdelete(cull);
+}
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
@@ -0,0 +1,154 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+static void render_canvas(RID p_canvas, RenderingMethod::RenderInfo *r_render_info = nullptr) {
+	RendererCanvasCull::Canvas *canvas = RSG::canvas->canvas_owner.get_or_null(p_canvas);
+	RSG::canvas->render_canvas(RID(), canvas, Transform2D(), nullptr, nullptr, Rect2(0, 0, 1024, 768), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xffffffff, r_render_info);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Drawn canvas items should be counted in the render info") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	RID canvas = rs->canvas_create();
+	LocalVector<RID> items;
+	for (int i = 0; i < 4; i++) {
+		RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, canvas);
+		rs->canvas_item_set_transform(item, Transform2D(0, Vector2(100 * i, 100)));
+		rs->canvas_item_add_rect(item, Rect2(0, 0, 32, 32), Color(1, 1, 1));
+		items.push_back(item);
+	}
+
+	RenderingMethod::RenderInfo render_info;
+	render_canvas(canvas, &render_info);
+	CHECK_EQ(render_info.canvas_items_in_frame, 4);
+
+	// The count accumulates over the canvases of a frame, the viewport resets it for every frame.
+	render_canvas(canvas, &render_info);
+	CHECK_EQ(render_info.canvas_items_in_frame, 8);
+
+	SUBCASE("Hidden, empty and culled items should not be counted") {
+		rs->canvas_item_set_visible(items[0], false);
+		rs->canvas_item_clear(items[1]);
+		rs->canvas_item_set_transform(items[2], Transform2D(0, Vector2(-1000, -1000)));
+
+		render_info = RenderingMethod::RenderInfo();
+		render_canvas(canvas, &render_info);
+		CHECK_EQ(render_info.canvas_items_in_frame, 1);
+	}
+
+	SUBCASE("Items replayed from a static subtree should be counted") {
+		RID root = rs->canvas_item_create();
+		rs->canvas_item_set_parent(root, canvas);
+		rs->canvas_item_set_static_subtree(root, true);
+		for (int i = 0; i < 3; i++) {
+			RID child = rs->canvas_item_create();
+			rs->canvas_item_set_parent(child, root);
+			rs->canvas_item_add_rect(child, Rect2(0, 40 * i, 32, 32), Color(1, 1, 1));
+			items.push_back(child);
+		}
+		items.push_back(root);
+
+		// The first pass records the subtree, the second one replays it.
+		for (int pass = 0; pass < 2; pass++) {
+			render_info = RenderingMethod::RenderInfo();
+			render_canvas(canvas, &render_info);
+			CHECK_EQ(render_info.canvas_items_in_frame, 7);
+		}
+	}
+
+	for (const RID &item : items) {
+		rs->free(item);
+	}
+	rs->free(canvas);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Static subtrees with a skinned item should not be replayed from a recording") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	RID canvas = rs->canvas_create();
+	RID root = rs->canvas_item_create();
+	rs->canvas_item_set_parent(root, canvas);
+	rs->canvas_item_set_static_subtree(root, true);
+
+	RID child = rs->canvas_item_create();
+	rs->canvas_item_set_parent(child, root);
+	rs->canvas_item_set_transform(child, Transform2D(0, Vector2(100, 100)));
+	rs->canvas_item_add_rect(child, Rect2(0, 0, 32, 32), Color(1, 1, 1));
+
+	RendererCanvasCull::Item *root_item = RSG::canvas->canvas_item_owner.get_or_null(root);
+	RendererCanvasCull::Item *child_item = RSG::canvas->canvas_item_owner.get_or_null(child);
+	RendererCanvasCull::Item::StaticCache *cache = root_item->static_cache;
+	REQUIRE(cache != nullptr);
+
+	render_canvas(canvas);
+	CHECK_MESSAGE(cache->cacheable, "A subtree of plain items should be recorded.");
+	CHECK_FALSE(cache->dirty);
+	CHECK_EQ(cache->entries.size(), 1u);
+
+	// The dummy renderer doesn't allocate skeletons, the canvas only needs to know one is attached.
+	const RID skeleton = RID::from_uint64(1);
+	rs->canvas_item_attach_skeleton(child, skeleton);
+	CHECK_MESSAGE(cache->dirty, "Attaching a skeleton should invalidate the recording of the static subtree above it.");
+
+	render_canvas(canvas);
+	CHECK_MESSAGE(!cache->cacheable, "A subtree with a skinned item shouldn't be replayed from a recording.");
+	CHECK(cache->entries.is_empty());
+	CHECK(child_item->final_transform.is_equal_approx(Transform2D(0, Vector2(100, 100))));
+
+	// The skinned item is culled like any other item, so it follows its transform.
+	rs->canvas_item_set_transform(child, Transform2D(0, Vector2(200, 50)));
+	render_canvas(canvas);
+	CHECK_FALSE(cache->cacheable);
+	CHECK(child_item->final_transform.is_equal_approx(Transform2D(0, Vector2(200, 50))));
+
+	rs->canvas_item_attach_skeleton(child, RID());
+	CHECK_MESSAGE(cache->dirty, "Detaching the skeleton should invalidate the recording of the static subtree above it.");
+	render_canvas(canvas);
+	CHECK_MESSAGE(cache->cacheable, "The subtree should be recorded again once the skeleton is detached.");
+	CHECK_EQ(cache->entries.size(), 1u);
+
+	rs->free(child);
+	rs->free(root);
+	rs->free(canvas);
+}
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
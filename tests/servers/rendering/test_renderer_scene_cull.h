@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "core/os/os.h"
+#include "servers/rendering/renderer_scene_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+static RendererSceneCull::Frustum create_camera_frustum(const Vector3 &p_origin = Vector3(0, 10, 0), real_t p_fov = 75.0) {
+	Projection projection;
+	projection.set_perspective(p_fov, 16.0 / 9.0, 0.05, 200.0);
+	Transform3D camera_transform;
+	camera_transform.origin = p_origin;
+	camera_transform.basis = Basis(Vector3(0, 1, 0), Math::deg_to_rad(30.0));
+	return RendererSceneCull::Frustum(projection.get_projection_planes(camera_transform));
+}
+
+static void create_random_bounds(LocalVector<RendererSceneCull::InstanceBounds> &r_bounds, uint32_t p_count) {
+	Math::seed(p_count);
+	r_bounds.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		Vector3 position = Vector3(Math::random(-300.0, 300.0), Math::random(-20.0, 40.0), Math::random(-300.0, 300.0));
+		Vector3 size = Vector3(Math::random(0.1, 8.0), Math::random(0.1, 8.0), Math::random(0.1, 8.0));
+		r_bounds[i] = RendererSceneCull::InstanceBounds(AABB(position, size));
+	}
+}
+
+TEST_CASE("[RendererSceneCull] Block frustum test should match the per-instance test") {
+	const RendererSceneCull::Frustum frustum = create_camera_frustum();
+	LocalVector<RendererSceneCull::InstanceBounds> bounds;
+	create_random_bounds(bounds, 1000);
+
+	uint8_t inside[RendererSceneCull::SCENE_CULL_BLOCK_SIZE];
+	uint32_t inside_count = 0;
+	for (uint32_t from = 0; from < bounds.size(); from += RendererSceneCull::SCENE_CULL_BLOCK_SIZE) {
+		const uint32_t count = MIN(bounds.size() - from, (uint32_t)RendererSceneCull::SCENE_CULL_BLOCK_SIZE);
+		RendererSceneCull::InstanceBounds::in_frustum_block(&bounds[from], count, frustum, inside);
+		for (uint32_t i = 0; i < count; i++) {
+			CHECK_MESSAGE(bool(inside[i]) == bounds[from + i].in_frustum(frustum), vformat("Bounds %d should have the same result in both tests.", from + i));
+			inside_count += inside[i];
+		}
+	}
+
+	// Make sure the camera sees some of the bounds, but not all of them.
+	CHECK(inside_count > 0);
+	CHECK(inside_count < bounds.size());
+}
+
+TEST_CASE("[RendererSceneCull] Frustum cache should only stay valid while the frustums are unchanged") {
+	// Collects the planes like the scene cull does, camera first, then the shadow frustums.
+	const auto update_cache = [](RendererSceneCull::Scenario::FrustumCache &r_cache, const RendererSceneCull::Frustum &p_camera_frustum, const RendererSceneCull::Frustum *p_shadow_frustum = nullptr) {
+		LocalVector<Plane> planes;
+		LocalVector<uint32_t> plane_counts;
+		for (uint32_t i = 0; i < p_camera_frustum.plane_count; i++) {
+			planes.push_back(p_camera_frustum.planes_ptr[i]);
+		}
+		plane_counts.push_back(p_camera_frustum.plane_count);
+		if (p_shadow_frustum) {
+			plane_counts.push_back(1);
+			for (uint32_t i = 0; i < p_shadow_frustum->plane_count; i++) {
+				planes.push_back(p_shadow_frustum->planes_ptr[i]);
+			}
+			plane_counts.push_back(p_shadow_frustum->plane_count);
+		}
+		return r_cache.update_frustums(planes, plane_counts);
+	};
+
+	RendererSceneCull::Scenario::FrustumCache cache;
+	const RendererSceneCull::Frustum frustum = create_camera_frustum();
+	CHECK_FALSE_MESSAGE(update_cache(cache, frustum), "The first cull has nothing to reuse.");
+	CHECK_MESSAGE(update_cache(cache, create_camera_frustum()), "An unchanged camera should reuse the cached frustum masks.");
+
+	CHECK_FALSE_MESSAGE(update_cache(cache, create_camera_frustum(Vector3(0, 10, 0.001))), "A moved camera should invalidate the cache.");
+	CHECK_MESSAGE(update_cache(cache, create_camera_frustum(Vector3(0, 10, 0.001))), "The moved camera should be cached for the next cull.");
+
+	CHECK_FALSE_MESSAGE(update_cache(cache, create_camera_frustum(Vector3(0, 10, 0.001), 60.0)), "A changed projection should invalidate the cache.");
+	CHECK_MESSAGE(update_cache(cache, create_camera_frustum(Vector3(0, 10, 0.001), 60.0)), "The changed projection should be cached for the next cull.");
+
+	const RendererSceneCull::Frustum shadow_frustum = create_camera_frustum(Vector3(0, 50, 0), 90.0);
+	CHECK_FALSE_MESSAGE(update_cache(cache, create_camera_frustum(Vector3(0, 10, 0.001), 60.0), &shadow_frustum), "A new shadow frustum should invalidate the cache.");
+	CHECK_MESSAGE(update_cache(cache, create_camera_frustum(Vector3(0, 10, 0.001), 60.0), &shadow_frustum), "An unchanged shadow frustum should reuse the cached frustum masks.");
+}
+
+TEST_CASE("[Stress][RendererSceneCull] Compare per-instance and block frustum culling") {
+	const RendererSceneCull::Frustum frustum = create_camera_frustum();
+	const int iterations = 100;
+
+	for (uint32_t bounds_count : { 1000, 10000, 100000 }) {
+		LocalVector<RendererSceneCull::InstanceBounds> bounds;
+		create_random_bounds(bounds, bounds_count);
+
+		uint32_t per_instance_count = 0;
+		uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			for (uint32_t i = 0; i < bounds.size(); i++) {
+				per_instance_count += bounds[i].in_frustum(frustum);
+			}
+		}
+		const uint64_t per_instance_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+		uint32_t block_count = 0;
+		uint8_t inside[RendererSceneCull::SCENE_CULL_BLOCK_SIZE];
+		begin_usec = OS::get_singleton()->get_ticks_usec();
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			for (uint32_t from = 0; from < bounds.size(); from += RendererSceneCull::SCENE_CULL_BLOCK_SIZE) {
+				const uint32_t count = MIN(bounds.size() - from, (uint32_t)RendererSceneCull::SCENE_CULL_BLOCK_SIZE);
+				RendererSceneCull::InstanceBounds::in_frustum_block(&bounds[from], count, frustum, inside);
+				for (uint32_t i = 0; i < count; i++) {
+					block_count += inside[i];
+				}
+			}
+		}
+		const uint64_t block_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+		print_verbose(vformat("Frustum culling %d bounds: %d usec per cull pass testing each instance, %d usec per cull pass testing blocks of %d.", bounds_count, per_instance_usec / iterations, block_usec / iterations, RendererSceneCull::SCENE_CULL_BLOCK_SIZE));
+		CHECK_EQ(per_instance_count, block_count);
+	}
+}
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
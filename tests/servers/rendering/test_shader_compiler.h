@@ -0,0 +1,176 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_H
+#define TEST_SHADER_COMPILER_H
+
+#include "core/os/os.h"
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderCompiler {
+
+struct CompileResult {
+	Error error = FAILED;
+	ShaderCompiler::GeneratedCode gen_code;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	bool unshaded = false;
+	bool uses_alpha = false;
+	bool writes_albedo = false;
+};
+
+void initialize_compiler(ShaderCompiler &p_compiler) {
+	ShaderCompiler::DefaultIdentifierActions actions;
+	actions.renames["ALBEDO"] = "albedo";
+	actions.renames["ALPHA"] = "alpha";
+	actions.default_filter = ShaderLanguage::FILTER_LINEAR_MIPMAP;
+	actions.default_repeat = ShaderLanguage::REPEAT_ENABLE;
+	actions.base_uniform_string = "material.";
+	p_compiler.initialize(actions);
+}
+
+void compile_shader(ShaderCompiler &p_compiler, const String &p_code, CompileResult &r_result) {
+	ShaderCompiler::IdentifierActions actions;
+	actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
+	actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+	actions.render_mode_flags["unshaded"] = &r_result.unshaded;
+	actions.usage_flag_pointers["ALPHA"] = &r_result.uses_alpha;
+	actions.write_flag_pointers["ALBEDO"] = &r_result.writes_albedo;
+	actions.uniforms = &r_result.uniforms;
+
+	r_result.error = p_compiler.compile(RS::SHADER_SPATIAL, p_code, &actions, "", r_result.gen_code);
+}
+
+String create_shader_code(const String &p_uniform, const String &p_scale) {
+	String code = "shader_type spatial;\n";
+	code += "render_mode unshaded;\n";
+	code += "uniform vec4 " + p_uniform + " : source_color;\n";
+	code += "void fragment() {\n";
+	code += "\tALBEDO = " + p_uniform + ".rgb * " + p_scale + ";\n";
+	code += "\tALPHA = 0.5;\n";
+	code += "}\n";
+	return code;
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Compiling the same code again gives the same result") {
+	ShaderCompiler compiler;
+	initialize_compiler(compiler);
+	const String code = create_shader_code("tint", "0.25");
+
+	CompileResult first;
+	compile_shader(compiler, code, first);
+	REQUIRE(first.error == OK);
+	CHECK(first.unshaded);
+	CHECK(first.uses_alpha);
+	CHECK(first.writes_albedo);
+	CHECK(first.uniforms.has("tint"));
+	REQUIRE(first.gen_code.code.has("fragment"));
+	CHECK(first.gen_code.code["fragment"].contains("0.25"));
+
+	// The second compilation is served by the cache, its side effects on the caller must be the same.
+	CompileResult second;
+	compile_shader(compiler, code, second);
+	REQUIRE(second.error == OK);
+	CHECK(second.unshaded);
+	CHECK(second.uses_alpha);
+	CHECK(second.writes_albedo);
+	CHECK(second.uniforms.has("tint"));
+	CHECK_EQ(second.gen_code.uniforms, first.gen_code.uniforms);
+	REQUIRE(second.gen_code.code.has("fragment"));
+	CHECK_EQ(second.gen_code.code["fragment"], first.gen_code.code["fragment"]);
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Changed code is compiled again") {
+	ShaderCompiler compiler;
+	initialize_compiler(compiler);
+
+	CompileResult original;
+	compile_shader(compiler, create_shader_code("tint", "0.25"), original);
+	REQUIRE(original.error == OK);
+
+	CompileResult changed_constant;
+	compile_shader(compiler, create_shader_code("tint", "0.75"), changed_constant);
+	REQUIRE(changed_constant.error == OK);
+	REQUIRE(changed_constant.gen_code.code.has("fragment"));
+	CHECK(changed_constant.gen_code.code["fragment"].contains("0.75"));
+	CHECK_FALSE(changed_constant.gen_code.code["fragment"].contains("0.25"));
+
+	CompileResult changed_uniform;
+	compile_shader(compiler, create_shader_code("color", "0.25"), changed_uniform);
+	REQUIRE(changed_uniform.error == OK);
+	CHECK(changed_uniform.uniforms.has("color"));
+	CHECK_FALSE(changed_uniform.uniforms.has("tint"));
+	CHECK_NE(changed_uniform.gen_code.uniforms, original.gen_code.uniforms);
+
+	// A shader that no longer compiles must report its error instead of reusing an older result.
+	CompileResult broken;
+	ERR_PRINT_OFF;
+	compile_shader(compiler, create_shader_code("tint", "undefined_value"), broken);
+	ERR_PRINT_ON;
+	CHECK(broken.error != OK);
+}
+
+TEST_CASE("[Stress][SceneTree][ShaderCompiler] Compare compiling with a cold and a warm cache") {
+	const int shader_count = 200;
+	Vector<String> codes;
+	for (int i = 0; i < shader_count; i++) {
+		codes.push_back(create_shader_code("tint", itos(i) + ".5"));
+	}
+
+	ShaderCompiler compiler;
+	initialize_compiler(compiler);
+
+	Vector<String> cold_code;
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < shader_count; i++) {
+		CompileResult result;
+		compile_shader(compiler, codes[i], result);
+		REQUIRE(result.error == OK);
+		cold_code.push_back(result.gen_code.code["fragment"]);
+	}
+	const uint64_t cold_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+	Vector<String> warm_code;
+	begin_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < shader_count; i++) {
+		CompileResult result;
+		compile_shader(compiler, codes[i], result);
+		REQUIRE(result.error == OK);
+		warm_code.push_back(result.gen_code.code["fragment"]);
+	}
+	const uint64_t warm_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+	print_verbose(vformat("Compiling %d shaders: %d usec with a cold cache, %d usec with a warm cache.", shader_count, cold_usec, warm_usec));
+	CHECK_EQ(cold_code, warm_code);
+}
+} // namespace TestShaderCompiler
+
+#endif // TEST_SHADER_COMPILER_H
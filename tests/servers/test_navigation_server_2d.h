@@ -32,6 +32,7 @@
 #define TEST_NAVIGATION_SERVER_2D_H
 
 #include "servers/navigation_server_2d.h"
+#include "servers/navigation_server_3d.h"
 
 #include "tests/test_macros.h"
 
@@ -41,6 +42,44 @@ TEST_SUITE("[Navigation]") {
 		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
 		CHECK_EQ(navigation_server->get_maps().size(), 0);
 	}
+
+	TEST_CASE("[NavigationServer2D] Server should report safe velocities of agents in one batch") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		RID agent_1 = navigation_server->agent_create();
+		navigation_server->agent_set_map(agent_1, map);
+		navigation_server->agent_set_avoidance_enabled(agent_1, true);
+		navigation_server->agent_set_position(agent_1, Vector2(0, 0));
+		navigation_server->agent_set_radius(agent_1, 1);
+		navigation_server->agent_set_velocity(agent_1, Vector2(1, 0));
+		RID agent_2 = navigation_server->agent_create();
+		navigation_server->agent_set_map(agent_2, map);
+		navigation_server->agent_set_avoidance_enabled(agent_2, true);
+		navigation_server->agent_set_position(agent_2, Vector2(2.5, 0.5));
+		navigation_server->agent_set_radius(agent_2, 1);
+		navigation_server->agent_set_velocity(agent_2, Vector2(-1, 0));
+
+		// The 2D server forwards to the 3D server, which runs the avoidance.
+		NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+
+		const TypedArray<RID> map_agents = navigation_server->map_get_agents(map);
+		const PackedVector2Array safe_velocities = navigation_server->map_get_agents_safe_velocities(map);
+		REQUIRE_EQ(map_agents.size(), 2);
+		REQUIRE_EQ(safe_velocities.size(), 2);
+		const int agent_1_index = RID(map_agents[0]) == agent_1 ? 0 : 1;
+		CHECK_MESSAGE(safe_velocities[agent_1_index].x > 0, "agent 1 should move a bit along desired velocity (+X)");
+		CHECK_MESSAGE(safe_velocities[agent_1_index].y < 0, "agent 1 should move a bit to the side so that it avoids agent 2");
+		CHECK_MESSAGE(safe_velocities[1 - agent_1_index].x < 0, "agent 2 should move a bit along desired velocity (-X)");
+		CHECK_MESSAGE(safe_velocities[1 - agent_1_index].y > 0, "agent 2 should move a bit to the side so that it avoids agent 1");
+
+		CHECK(navigation_server->map_get_agents_safe_velocities(RID()).is_empty());
+
+		navigation_server->free(agent_2);
+		navigation_server->free(agent_1);
+		navigation_server->free(map);
+	}
 }
 } //namespace TestNavigationServer2D
 
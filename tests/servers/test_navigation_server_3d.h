@@ -31,6 +31,8 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
+#include "core/os/os.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -53,6 +55,19 @@ public:
 	Variant function1_latest_arg0{};
 };
 
+class CrowdVelocitiesMock : public Object {
+	GDCLASS(CrowdVelocitiesMock, Object);
+
+public:
+	void on_safe_velocity(Vector3 p_safe_velocity, uint32_t p_agent_index) {
+		safe_velocities[p_agent_index] = p_safe_velocity;
+		calls++;
+	}
+
+	LocalVector<Vector3> safe_velocities;
+	uint32_t calls = 0;
+};
+
 static inline Array build_array() {
 	return Array();
 }
@@ -63,6 +78,30 @@ static inline Array build_array(Variant item, Targs... Fargs) {
 	return a;
 }
 
+// A flat grid of 1x1 quads, so both the polygon count and the open set of path searches grow quadratically.
+static Ref<NavigationMesh> create_grid_navigation_mesh(int p_grid_size) {
+	Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_grid_size; z++) {
+		for (int x = 0; x <= p_grid_size; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+	for (int z = 0; z < p_grid_size; z++) {
+		for (int x = 0; x < p_grid_size; x++) {
+			int i = z * (p_grid_size + 1) + x;
+			Vector<int> polygon;
+			polygon.push_back(i);
+			polygon.push_back(i + 1);
+			polygon.push_back(i + p_grid_size + 2);
+			polygon.push_back(i + p_grid_size + 1);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -429,6 +468,155 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->free(map);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should report safe velocities of large crowds in one batch") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		// Enough agents to have the agent tree built in parallel subtrees.
+		const int crowd_side = 32;
+		LocalVector<RID> agents;
+		for (int x = 0; x < crowd_side; x++) {
+			for (int z = 0; z < crowd_side; z++) {
+				RID agent = navigation_server->agent_create();
+				navigation_server->agent_set_map(agent, map);
+				navigation_server->agent_set_avoidance_enabled(agent, true);
+				navigation_server->agent_set_position(agent, Vector3(x * 2.0, 0, z * 2.0));
+				navigation_server->agent_set_radius(agent, 0.5);
+				navigation_server->agent_set_max_speed(agent, 2.0);
+				navigation_server->agent_set_velocity(agent, Vector3(1, 0, 0));
+				agents.push_back(agent);
+			}
+		}
+		CallableMock agent_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agents[0], callable_mp(&agent_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(agent_avoidance_callback_mock.function1_calls, 1);
+
+		const TypedArray<RID> map_agents = navigation_server->map_get_agents(map);
+		const PackedVector3Array safe_velocities = navigation_server->map_get_agents_safe_velocities(map);
+		REQUIRE_EQ(safe_velocities.size(), crowd_side * crowd_side);
+		REQUIRE_EQ(map_agents.size(), safe_velocities.size());
+		for (int i = 0; i < safe_velocities.size(); i++) {
+			CHECK_MESSAGE(safe_velocities[i].x > 0, "agents should keep moving along desired velocity (+X)");
+			CHECK_LE(safe_velocities[i].length(), 2.0 + CMP_EPSILON);
+			if (RID(map_agents[i]) == agents[0]) {
+				CHECK_EQ(safe_velocities[i], agent_avoidance_callback_mock.function1_latest_arg0);
+			}
+		}
+
+		for (const RID &agent : agents) {
+			navigation_server->free(agent);
+		}
+		navigation_server->free(map);
+	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Compare reading crowd safe velocities per agent and in one batch") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		const int crowd_side = 100;
+		const int steps = 20;
+		const real_t delta = 0.1;
+
+		// Rows of agents walking against each other, so that their safe velocities change while they move.
+		const auto create_crowd = [&](LocalVector<RID> &r_agents, LocalVector<Vector3> &r_positions) {
+			for (int x = 0; x < crowd_side; x++) {
+				for (int z = 0; z < crowd_side; z++) {
+					RID agent = navigation_server->agent_create();
+					navigation_server->agent_set_map(agent, map);
+					navigation_server->agent_set_avoidance_enabled(agent, true);
+					navigation_server->agent_set_position(agent, Vector3(x * 1.5, 0, z * 1.5));
+					navigation_server->agent_set_radius(agent, 0.5);
+					navigation_server->agent_set_max_speed(agent, 2.0);
+					navigation_server->agent_set_velocity(agent, Vector3((z % 2) ? 1 : -1, 0, 0));
+					r_agents.push_back(agent);
+					r_positions.push_back(Vector3(x * 1.5, 0, z * 1.5));
+				}
+			}
+		};
+
+		// Per agent, every agent dispatches its own avoidance callback.
+		LocalVector<RID> callback_agents;
+		LocalVector<Vector3> callback_positions;
+		create_crowd(callback_agents, callback_positions);
+		CrowdVelocitiesMock crowd_velocities_mock;
+		crowd_velocities_mock.safe_velocities.resize(callback_agents.size());
+		for (uint32_t i = 0; i < callback_agents.size(); i++) {
+			navigation_server->agent_set_avoidance_callback(callback_agents[i], callable_mp(&crowd_velocities_mock, &CrowdVelocitiesMock::on_safe_velocity).bind(i));
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		crowd_velocities_mock.calls = 0;
+
+		uint64_t per_agent_usec = 0;
+		for (int step = 0; step < steps; step++) {
+			const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			navigation_server->process(delta);
+			per_agent_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+			for (uint32_t i = 0; i < callback_agents.size(); i++) {
+				callback_positions[i] += crowd_velocities_mock.safe_velocities[i] * delta;
+				navigation_server->agent_set_position(callback_agents[i], callback_positions[i]);
+			}
+		}
+		CHECK_EQ(crowd_velocities_mock.calls, callback_agents.size() * steps);
+
+		for (const RID &agent : callback_agents) {
+			navigation_server->free(agent);
+		}
+
+		// In one batch, a crowd that never had callbacks reads the velocities of all agents after each step.
+		LocalVector<RID> batch_agents;
+		LocalVector<Vector3> batch_positions;
+		create_crowd(batch_agents, batch_positions);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const TypedArray<RID> map_agents = navigation_server->map_get_agents(map);
+		REQUIRE_EQ(map_agents.size(), (int)batch_agents.size());
+		HashMap<RID, uint32_t> agent_indices;
+		for (uint32_t i = 0; i < batch_agents.size(); i++) {
+			agent_indices[batch_agents[i]] = i;
+		}
+		LocalVector<uint32_t> map_order;
+		for (int i = 0; i < map_agents.size(); i++) {
+			map_order.push_back(agent_indices[map_agents[i]]);
+		}
+
+		PackedVector3Array previous_velocities = navigation_server->map_get_agents_safe_velocities(map);
+		uint64_t batch_usec = 0;
+		int changed_steps = 0;
+		for (int step = 0; step < steps; step++) {
+			const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			navigation_server->process(delta);
+			const PackedVector3Array safe_velocities = navigation_server->map_get_agents_safe_velocities(map);
+			batch_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+			REQUIRE_EQ(safe_velocities.size(), map_agents.size());
+			if (safe_velocities != previous_velocities) {
+				changed_steps++;
+			}
+			previous_velocities = safe_velocities;
+
+			for (int i = 0; i < safe_velocities.size(); i++) {
+				const uint32_t index = map_order[i];
+				batch_positions[index] += safe_velocities[i] * delta;
+				navigation_server->agent_set_position(batch_agents[index], batch_positions[index]);
+			}
+		}
+		CHECK_MESSAGE(changed_steps == steps, "safe velocities should be computed again by every step");
+
+		print_verbose(vformat("Stepping a crowd of %d agents: %d usec per step with per agent callbacks, %d usec per step with batch reads.", batch_agents.size(), per_agent_usec / steps, batch_usec / steps));
+
+		for (const RID &agent : batch_agents) {
+			navigation_server->free(agent);
+		}
+		navigation_server->free(map);
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should make agents avoid dynamic obstacles when avoidance enabled") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 
@@ -622,6 +810,17 @@ TEST_SUITE("[Navigation]") {
 			CHECK_NE(navigation_server->map_get_closest_point(map, Vector3(0, 0, 0)), Vector3(0, 0, 0));
 		}
 
+		SUBCASE("Parsing again should pick up changed meshes") {
+			const Vector<float> vertices = source_geometry->get_vertices();
+			navigation_server->parse_source_geometry_data(navigation_mesh, source_geometry, node_3d);
+			CHECK_EQ(source_geometry->get_vertices(), vertices);
+
+			plane_mesh->set_size(Size2(20.0, 20.0));
+			navigation_server->parse_source_geometry_data(navigation_mesh, source_geometry, node_3d);
+			REQUIRE_EQ(source_geometry->get_vertices().size(), vertices.size());
+			CHECK_NE(source_geometry->get_vertices(), vertices);
+		}
+
 		navigation_server->free(region);
 		navigation_server->free(map);
 		navigation_server->process(0.0); // Give server some cycles to commit.
@@ -716,10 +915,611 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Async query should complete after server processing and call the callback") {
+			CallableMock mock;
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(10, 0, 10));
+			query_parameters->set_target_position(Vector3(0, 0, 0));
+			Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+			int64_t ticket = navigation_server->query_path_async(query_parameters, query_result, callable_mp(&mock, &CallableMock::function1));
+			CHECK_GT(ticket, 0);
+			CHECK_FALSE(navigation_server->query_path_async_is_completed(ticket));
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_QUEUE_COUNT), 0);
+
+			navigation_server->process(0.0); // Starts the query.
+			navigation_server->process(0.0); // Delivers the result.
+			CHECK(navigation_server->query_path_async_is_completed(ticket));
+			CHECK_EQ(mock.function1_calls, 1);
+			CHECK_EQ(mock.function1_latest_arg0, Variant(query_result));
+			CHECK_NE(query_result->get_path().size(), 0);
+			CHECK_NE(query_result->get_path_rids().size(), 0);
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should find paths on generated navigation meshes of growing size") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		for (int grid_size : { 4, 32, 128 }) {
+			// A flat grid of 1x1 quads, so both the polygon count and the open set grow quadratically.
+			Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+			Vector<Vector3> vertices;
+			for (int z = 0; z <= grid_size; z++) {
+				for (int x = 0; x <= grid_size; x++) {
+					vertices.push_back(Vector3(x, 0, z));
+				}
+			}
+			navigation_mesh->set_vertices(vertices);
+			for (int z = 0; z < grid_size; z++) {
+				for (int x = 0; x < grid_size; x++) {
+					int i = z * (grid_size + 1) + x;
+					Vector<int> polygon;
+					polygon.push_back(i);
+					polygon.push_back(i + 1);
+					polygon.push_back(i + grid_size + 2);
+					polygon.push_back(i + grid_size + 1);
+					navigation_mesh->add_polygon(polygon);
+				}
+			}
+
+			RID map = navigation_server->map_create();
+			RID region = navigation_server->region_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->map_get_regions(map).size(), 1);
+
+			const Vector3 start = Vector3(0.5, 0, 0.5);
+			const Vector3 end = Vector3(grid_size - 0.5, 0, grid_size - 0.5);
+
+			// Repeated queries reuse the search state of the previous ones.
+			for (int i = 0; i < 3; i++) {
+				Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+				REQUIRE(path.size() == 2); // The grid is convex as a whole, the funnel yields a straight line.
+				CHECK(path[0].is_equal_approx(start));
+				CHECK(path[1].is_equal_approx(end));
+
+				path = navigation_server->map_get_path(map, end, start, false);
+				REQUIRE(path.size() >= grid_size);
+				CHECK(path[0].is_equal_approx(end));
+				CHECK(path[path.size() - 1].is_equal_approx(start));
+			}
+
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Time paths on generated navigation meshes of growing size") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		const int repeat_count = 20;
+
+		for (int grid_size : { 64, 128, 256, 512 }) {
+			Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(grid_size);
+
+			RID map = navigation_server->map_create();
+			RID region = navigation_server->region_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			// Corner to corner without the funnel, so the search reaches most of the grid and the path follows it.
+			const Vector3 start = Vector3(0.5, 0, 0.5);
+			const Vector3 end = Vector3(grid_size - 0.5, 0, grid_size - 0.5);
+
+			// The first query of a map grows the search state, the following ones reuse it.
+			uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			Vector<Vector3> path = navigation_server->map_get_path(map, start, end, false);
+			const uint64_t first_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+			REQUIRE(path.size() >= grid_size);
+
+			begin_usec = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < repeat_count; i++) {
+				path = navigation_server->map_get_path(map, (i % 2) ? end : start, (i % 2) ? start : end, false);
+				CHECK(path.size() >= grid_size);
+			}
+			const uint64_t repeated_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+			print_verbose(vformat("Corner to corner path on %d polygons: %d usec for the first query, %d usec per repeated query.", grid_size * grid_size, first_usec, repeated_usec / repeat_count));
+
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should answer closest point queries on large maps") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A flat grid of 1x1 quads, large enough for the spatial index to have many levels.
+		const int grid_size = 64;
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= grid_size; z++) {
+			for (int x = 0; x <= grid_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < grid_size; z++) {
+			for (int x = 0; x < grid_size; x++) {
+				int i = z * (grid_size + 1) + x;
+				Vector<int> polygon;
+				polygon.push_back(i);
+				polygon.push_back(i + 1);
+				polygon.push_back(i + grid_size + 2);
+				polygon.push_back(i + grid_size + 1);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Closest points should be found on and next to the grid") {
+			for (int z = 0; z < grid_size; z += 3) {
+				for (int x = 0; x < grid_size; x += 5) {
+					const Vector3 point = Vector3(x + 0.3, 2.0, z + 0.7);
+					CHECK(navigation_server->map_get_closest_point(map, point).is_equal_approx(Vector3(x + 0.3, 0.0, z + 0.7)));
+					CHECK_EQ(navigation_server->map_get_closest_point_owner(map, point), region);
+				}
+			}
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(-5.0, 0.0, 10.5)).is_equal_approx(Vector3(0.0, 0.0, 10.5)));
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(grid_size + 3.0, -1.0, grid_size + 3.0)).is_equal_approx(Vector3(grid_size, 0.0, grid_size)));
+			CHECK(navigation_server->map_get_closest_point_normal(map, Vector3(10.5, 1.0, 10.5)).abs().is_equal_approx(Vector3(0.0, 1.0, 0.0)));
+		}
+
+		SUBCASE("Closest points to segments should prefer intersections") {
+			CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(10.5, 5.0, 20.5), Vector3(10.5, -5.0, 20.5), false).is_equal_approx(Vector3(10.5, 0.0, 20.5)));
+			CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(10.5, 5.0, 20.5), Vector3(10.5, -5.0, 20.5), true).is_equal_approx(Vector3(10.5, 0.0, 20.5)));
+			CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(-5.0, 1.0, 10.5), Vector3(-1.0, 1.0, 10.5), false).is_equal_approx(Vector3(0.0, 0.0, 10.5)));
+		}
+
+		SUBCASE("Random points should lie on the grid") {
+			for (int i = 0; i < 100; i++) {
+				const Vector3 point = navigation_server->map_get_random_point(map, 1, true);
+				CHECK(point.x >= 0.0);
+				CHECK(point.x <= grid_size);
+				CHECK(point.z >= 0.0);
+				CHECK(point.z <= grid_size);
+				CHECK(Math::is_zero_approx(point.y));
+			}
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Compare closest point and path queries on a large map against a linear scan") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// 448 * 448 = 200704 polygons.
+		const int grid_size = 448;
+		const int query_count = 10000;
+		const int linear_query_count = 100;
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(grid_size);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// One query per agent, spread over the whole map.
+		Math::seed(grid_size);
+		LocalVector<Vector3> query_points;
+		for (int i = 0; i < query_count; i++) {
+			query_points.push_back(Vector3(Math::random(0.0, (double)grid_size), Math::random(-2.0, 2.0), Math::random(0.0, (double)grid_size)));
+		}
+
+		uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+		LocalVector<Vector3> closest_points;
+		for (const Vector3 &point : query_points) {
+			closest_points.push_back(navigation_server->map_get_closest_point(map, point));
+		}
+		const uint64_t closest_point_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+		// The scan over every polygon the map used before it had a spatial index, only run on a few queries
+		// because it would take minutes on all of them.
+		const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+		begin_usec = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < linear_query_count; i++) {
+			const Vector3 &point = query_points[i];
+			real_t closest_distance_squared = FLT_MAX;
+			Vector3 linear_closest_point;
+			for (int polygon_index = 0; polygon_index < navigation_mesh->get_polygon_count(); polygon_index++) {
+				const Vector<int> polygon = navigation_mesh->get_polygon(polygon_index);
+				for (int point_id = 2; point_id < polygon.size(); point_id++) {
+					const Face3 face(vertices[polygon[0]], vertices[polygon[point_id - 1]], vertices[polygon[point_id]]);
+					const Vector3 face_point = face.get_closest_point_to(point);
+					const real_t distance_squared = face_point.distance_squared_to(point);
+					if (distance_squared < closest_distance_squared) {
+						closest_distance_squared = distance_squared;
+						linear_closest_point = face_point;
+					}
+				}
+			}
+			CHECK(Math::is_equal_approx(closest_points[i].distance_to(point), linear_closest_point.distance_to(point)));
+		}
+		const uint64_t linear_closest_point_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+		// Agents path toward a target near them, so the search for the begin and end polygons is a large part of the query.
+		begin_usec = OS::get_singleton()->get_ticks_usec();
+		int path_count = 0;
+		for (const Vector3 &point : query_points) {
+			const Vector3 target = Vector3(CLAMP(point.x + Math::random(-8.0, 8.0), 0.0, (real_t)grid_size), 0.0, CLAMP(point.z + Math::random(-8.0, 8.0), 0.0, (real_t)grid_size));
+			if (!navigation_server->map_get_path(map, point, target, true).is_empty()) {
+				path_count++;
+			}
+		}
+		const uint64_t path_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+		CHECK_EQ(path_count, query_count);
+
+		print_verbose(vformat("Closest point on %d polygons: %.2f usec per query with the spatial index, %.2f usec per query with a linear scan.", navigation_mesh->get_polygon_count(), double(closest_point_usec) / query_count, double(linear_closest_point_usec) / linear_query_count));
+		print_verbose(vformat("Short paths on %d polygons: %.2f usec per query, the linear scan tested every polygon for both ends of a path.", navigation_mesh->get_polygon_count(), double(path_usec) / query_count));
+
 		navigation_server->free(region);
 		navigation_server->free(map);
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
+
+	TEST_CASE("[NavigationServer3D] Server should compute flow fields toward shared targets") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A flat grid of 1x1 quads.
+		const int grid_size = 8;
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= grid_size; z++) {
+			for (int x = 0; x <= grid_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < grid_size; z++) {
+			for (int x = 0; x < grid_size; x++) {
+				int i = z * (grid_size + 1) + x;
+				Vector<int> polygon;
+				polygon.push_back(i);
+				polygon.push_back(i + 1);
+				polygon.push_back(i + grid_size + 2);
+				polygon.push_back(i + grid_size + 1);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		RID flow_field = navigation_server->flow_field_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+
+		const Vector3 start = Vector3(0.5, 0.0, 0.5);
+		const Vector3 target = Vector3(grid_size - 0.5, 0.0, grid_size - 0.5);
+		navigation_server->flow_field_set_map(flow_field, map);
+		navigation_server->flow_field_set_targets(flow_field, { target });
+		CHECK_EQ(navigation_server->flow_field_get_distance(flow_field, start), INFINITY);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(navigation_server->flow_field_get_map(flow_field), map);
+
+		SUBCASE("Field should lead from every polygon to the target") {
+			CHECK(Math::is_zero_approx(navigation_server->flow_field_get_distance(flow_field, target)));
+			CHECK(navigation_server->flow_field_get_next_position(flow_field, target + Vector3(-0.3, 0.0, -0.2)).is_equal_approx(target));
+
+			const real_t start_distance = navigation_server->flow_field_get_distance(flow_field, start);
+			CHECK_GE(start_distance, start.distance_to(target) - CMP_EPSILON);
+			CHECK_LT(start_distance, 2.0 * (grid_size - 1));
+
+			// The next position is on the far side of the start polygon and brings the agent closer.
+			const Vector3 next_position = navigation_server->flow_field_get_next_position(flow_field, start);
+			CHECK((Math::is_equal_approx(next_position.x, (real_t)1.0) || Math::is_equal_approx(next_position.z, (real_t)1.0)));
+			const Vector3 past_next_position = next_position + (next_position - start).normalized() * 0.01;
+			CHECK_LT(navigation_server->flow_field_get_distance(flow_field, past_next_position), start_distance);
+		}
+
+		SUBCASE("Field should follow changed targets") {
+			navigation_server->flow_field_set_targets(flow_field, { start, target });
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK(Math::is_zero_approx(navigation_server->flow_field_get_distance(flow_field, start)));
+			CHECK(Math::is_zero_approx(navigation_server->flow_field_get_distance(flow_field, target)));
+			CHECK_LT(navigation_server->flow_field_get_distance(flow_field, Vector3(1.5, 0.0, 0.5)), 2.0);
+		}
+
+		SUBCASE("Field should not lead through regions on other navigation layers") {
+			navigation_server->flow_field_set_navigation_layers(flow_field, 2);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->flow_field_get_distance(flow_field, start), INFINITY);
+			CHECK_EQ(navigation_server->flow_field_get_next_position(flow_field, start), start);
+		}
+
+		navigation_server->free(flow_field);
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should update region connections when regions change") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A square of 1x1 quads, copies of it are placed with gaps small enough to be bridged by edge connections.
+		const int region_size = 4;
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= region_size; z++) {
+			for (int x = 0; x <= region_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < region_size; z++) {
+			for (int x = 0; x < region_size; x++) {
+				int i = z * (region_size + 1) + x;
+				Vector<int> polygon;
+				polygon.push_back(i);
+				polygon.push_back(i + 1);
+				polygon.push_back(i + region_size + 2);
+				polygon.push_back(i + region_size + 1);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		RID region_a = navigation_server->region_create();
+		RID region_b = navigation_server->region_create();
+		RID region_c = navigation_server->region_create();
+		for (const RID &region : { region_a, region_b, region_c }) {
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		}
+		navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(region_size + 0.1, 0, 0)));
+		navigation_server->region_set_transform(region_c, Transform3D(Basis(), Vector3(0, 0, region_size * 4)));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start = Vector3(0.5, 0, 0.5);
+		const Vector3 end = Vector3(region_size * 2 + 0.1 - 0.5, 0, 0.5);
+		const int connections_count = navigation_server->region_get_connections_count(region_a);
+		CHECK_GT(connections_count, 0);
+		CHECK_EQ(navigation_server->region_get_connections_count(region_b), connections_count);
+		CHECK_EQ(navigation_server->region_get_connections_count(region_c), 0);
+		Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+		REQUIRE(path.size() >= 2);
+		CHECK(path[path.size() - 1].is_equal_approx(end));
+
+		// Changing a region far away keeps the connections of the others.
+		navigation_server->region_set_transform(region_c, Transform3D(Basis(), Vector3(region_size, 0, region_size * 4)));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(navigation_server->region_get_connections_count(region_a), connections_count);
+		CHECK_EQ(navigation_server->region_get_connections_count(region_b), connections_count);
+		path = navigation_server->map_get_path(map, start, end, true);
+		REQUIRE(path.size() >= 2);
+		CHECK(path[path.size() - 1].is_equal_approx(end));
+
+		// Removing a region drops its connections, adding it back restores them.
+		navigation_server->region_set_map(region_b, RID());
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(navigation_server->region_get_connections_count(region_a), 0);
+		path = navigation_server->map_get_path(map, start, end, true);
+		REQUIRE(path.size() >= 2);
+		CHECK(path[path.size() - 1].x <= region_size);
+
+		navigation_server->region_set_map(region_b, map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(navigation_server->region_get_connections_count(region_a), connections_count);
+		path = navigation_server->map_get_path(map, start, end, true);
+		REQUIRE(path.size() >= 2);
+		CHECK(path[path.size() - 1].is_equal_approx(end));
+
+		navigation_server->free(region_c);
+		navigation_server->free(region_b);
+		navigation_server->free(region_a);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should find paths across regions with hierarchical pathfinding") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", true);
+
+		// A row of regions made of 1x1 quads, each region sharing its border edges with the next one.
+		const int region_size = 8;
+		const int region_count = 4;
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= region_size; z++) {
+			for (int x = 0; x <= region_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < region_size; z++) {
+			for (int x = 0; x < region_size; x++) {
+				int i = z * (region_size + 1) + x;
+				Vector<int> polygon;
+				polygon.push_back(i);
+				polygon.push_back(i + 1);
+				polygon.push_back(i + region_size + 2);
+				polygon.push_back(i + region_size + 1);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		LocalVector<RID> regions;
+		for (int i = 0; i < region_count; i++) {
+			RID region = navigation_server->region_create();
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(i * region_size, 0, 0)));
+			regions.push_back(region);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start = Vector3(0.5, 0, 0.5);
+		const Vector3 end = Vector3(region_count * region_size - 0.5, 0, region_size - 0.5);
+
+		SUBCASE("Path should cross all regions") {
+			Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE(path.size() == 2); // The row is convex as a whole, the funnel yields a straight line.
+			CHECK(path[0].is_equal_approx(start));
+			CHECK(path[1].is_equal_approx(end));
+
+			path = navigation_server->map_get_path(map, end, start, false);
+			REQUIRE(path.size() >= region_count * region_size);
+			CHECK(path[0].is_equal_approx(end));
+			CHECK(path[path.size() - 1].is_equal_approx(start));
+		}
+
+		SUBCASE("Path should follow regions that are moved") {
+			// Detach the last region, the end is no longer reachable.
+			navigation_server->region_set_transform(regions[region_count - 1], Transform3D(Basis(), Vector3(region_count * region_size * 2, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			const Vector3 moved_end = Vector3(region_count * region_size * 2 + region_size - 0.5, 0, region_size - 0.5);
+			Vector<Vector3> path = navigation_server->map_get_path(map, start, moved_end, true);
+			REQUIRE(path.size() >= 2);
+			CHECK(path[0].is_equal_approx(start));
+			CHECK(path[path.size() - 1].x <= (region_count - 1) * region_size);
+
+			// Move it back in place.
+			navigation_server->region_set_transform(regions[region_count - 1], Transform3D(Basis(), Vector3((region_count - 1) * region_size, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE(path.size() == 2);
+			CHECK(path[1].is_equal_approx(end));
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", false);
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should bake navigation meshes in tiles") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(5.0);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(20.0, 0.001, 20.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+		CHECK_NE(navigation_mesh->get_vertices().size(), 0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Paths should cross the tiles") {
+			const Vector3 start = Vector3(-8.0, 0.0, -8.0);
+			const Vector3 end = Vector3(8.0, 0.0, 8.0);
+			Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE(path.size() >= 2);
+			CHECK(path[0].is_equal_approx(navigation_server->map_get_closest_point(map, start)));
+			CHECK(path[path.size() - 1].is_equal_approx(navigation_server->map_get_closest_point(map, end)));
+		}
+
+		SUBCASE("Rebaking a tile should only replace that tile") {
+			const int polygon_count = navigation_mesh->get_polygon_count();
+			Ref<NavigationMeshSourceGeometryData3D> empty_source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+			navigation_server->bake_tile_from_source_geometry_data(navigation_mesh, empty_source_geometry, Vector2i(0, 0), Callable());
+			CHECK_LT(navigation_mesh->get_polygon_count(), polygon_count);
+			CHECK_GT(navigation_mesh->get_polygon_count(), 0);
+
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh); // Force update.
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			const Vector3 tile_center = Vector3(2.5, 0.0, 2.5);
+			CHECK_GT(navigation_server->map_get_closest_point(map, tile_center).distance_to(tile_center), 2.0);
+
+			navigation_server->bake_tile_from_source_geometry_data(navigation_mesh, source_geometry, Vector2i(0, 0), Callable());
+			CHECK_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should stitch tiles around obstacles on tile edges") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(5.0);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array floor;
+		floor.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(floor, Vector3(20.0, 0.001, 20.0));
+		source_geometry->add_mesh_array(floor, Transform3D());
+
+		// A wall across the tile edges at x = -5, 0, 5 and z = 0, so the tiles get cut at different places along their edges.
+		Array wall;
+		wall.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(wall, Vector3(12.0, 2.0, 2.0));
+		source_geometry->add_mesh_array(wall, Transform3D(Basis(), Vector3(0.0, 1.0, 0.0)));
+
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		REQUIRE_NE(navigation_mesh->get_polygon_count(), 0);
+
+		SUBCASE("Vertices on the tile edges should be welded") {
+			const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+			HashSet<Vector3> unique_vertices;
+			for (const Vector3 &vertex : vertices) {
+				unique_vertices.insert(vertex);
+			}
+			CHECK_EQ(unique_vertices.size(), (uint32_t)vertices.size());
+		}
+
+		SUBCASE("Paths should go around the obstacle across the tile edges") {
+			RID map = navigation_server->map_create();
+			RID region = navigation_server->region_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			const Vector3 start = Vector3(0.0, 0.0, -8.0);
+			const Vector3 end = Vector3(0.0, 0.0, 8.0);
+			Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+			REQUIRE(path.size() >= 2);
+			CHECK(path[0].is_equal_approx(navigation_server->map_get_closest_point(map, start)));
+			CHECK(path[path.size() - 1].is_equal_approx(navigation_server->map_get_closest_point(map, end)));
+			CHECK_LT(path[path.size() - 1].distance_to(end), 0.5);
+
+			bool goes_around = false;
+			for (const Vector3 &point : path) {
+				goes_around = goes_around || Math::abs(point.x) >= 6.0;
+			}
+			CHECK(goes_around);
+
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+	}
 }
 } //namespace TestNavigationServer3D
 
@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "servers/physics_2d/godot_physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+struct BodySnapshot2D {
+	Transform2D transform;
+	Vector2 linear_velocity;
+	real_t angular_velocity = 0.0;
+};
+
+static void get_body_snapshots(PhysicsServer2D *p_server, const LocalVector<RID> &p_bodies, LocalVector<BodySnapshot2D> &r_snapshots) {
+	r_snapshots.resize(p_bodies.size());
+	for (uint32_t i = 0; i < p_bodies.size(); i++) {
+		r_snapshots[i].transform = p_server->body_get_state(p_bodies[i], PhysicsServer2D::BODY_STATE_TRANSFORM);
+		r_snapshots[i].linear_velocity = p_server->body_get_state(p_bodies[i], PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+		r_snapshots[i].angular_velocity = p_server->body_get_state(p_bodies[i], PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY);
+	}
+}
+
+TEST_CASE("[PhysicsServer2D] Restoring a saved space state should rewind bodies and contacts") {
+	GodotPhysicsServer2D *physics_server = memnew(GodotPhysicsServer2D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980.0);
+	physics_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+	RID floor_shape = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector2(5000, 100));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 100)));
+	physics_server->body_set_space(floor, space);
+
+	// Boxes sliding on the floor at different speeds, so they keep their contacts with it while friction slows them
+	// down, and a circle falling freely next to them.
+	RID box_shape = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(box_shape, Vector2(16, 16));
+	RID circle_shape = physics_server->circle_shape_create();
+	physics_server->shape_set_data(circle_shape, 16.0);
+
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 4; i++) {
+		RID body = physics_server->body_create();
+		physics_server->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(body, i < 3 ? box_shape : circle_shape);
+		physics_server->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, 0.1);
+		physics_server->body_set_state(body, PhysicsServer2D::BODY_STATE_CAN_SLEEP, false);
+		if (i < 3) {
+			physics_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(i * 100.0, -16.0)));
+			physics_server->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, Vector2(100.0 * (i + 1), 0));
+		} else {
+			physics_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(-200.0, -1000.0)));
+		}
+		physics_server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	const real_t step = 1.0 / 60.0;
+	const int steps = 10;
+
+	// Settle the contacts, so the saved state includes cached contacts.
+	for (int i = 0; i < steps; i++) {
+		physics_server->step(step);
+	}
+
+	LocalVector<BodySnapshot2D> saved;
+	get_body_snapshots(physics_server, bodies, saved);
+	const PackedByteArray state = physics_server->space_save_state(space);
+	CHECK_FALSE(state.is_empty());
+
+	for (int i = 0; i < steps; i++) {
+		physics_server->step(step);
+	}
+	LocalVector<BodySnapshot2D> stepped;
+	get_body_snapshots(physics_server, bodies, stepped);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		CHECK_MESSAGE(!stepped[i].transform.is_equal_approx(saved[i].transform), vformat("Body %d should still be moving.", i));
+	}
+
+	physics_server->space_restore_state(space, state);
+	LocalVector<BodySnapshot2D> restored;
+	get_body_snapshots(physics_server, bodies, restored);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		CHECK_MESSAGE(restored[i].transform == saved[i].transform, vformat("Body %d should be back at its saved transform.", i));
+		CHECK_MESSAGE(restored[i].linear_velocity == saved[i].linear_velocity, vformat("Body %d should be back at its saved linear velocity.", i));
+		CHECK_MESSAGE(restored[i].angular_velocity == saved[i].angular_velocity, vformat("Body %d should be back at its saved angular velocity.", i));
+	}
+
+	// Stepping from the restored state should replay the same steps.
+	for (int i = 0; i < steps; i++) {
+		physics_server->step(step);
+	}
+	LocalVector<BodySnapshot2D> replayed;
+	get_body_snapshots(physics_server, bodies, replayed);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		CHECK_MESSAGE(replayed[i].transform.is_equal_approx(stepped[i].transform), vformat("Body %d should reach the same transform again.", i));
+		CHECK_MESSAGE(replayed[i].linear_velocity.is_equal_approx(stepped[i].linear_velocity), vformat("Body %d should reach the same linear velocity again.", i));
+		CHECK_MESSAGE(Math::is_equal_approx(replayed[i].angular_velocity, stepped[i].angular_velocity), vformat("Body %d should reach the same angular velocity again.", i));
+	}
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(floor);
+	physics_server->free(circle_shape);
+	physics_server->free(box_shape);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
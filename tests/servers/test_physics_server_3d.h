@@ -0,0 +1,670 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "servers/physics_3d/godot_body_3d.h"
+#include "servers/physics_3d/godot_broad_phase_3d_bvh.h"
+#include "servers/physics_3d/godot_broad_phase_3d_hash_grid.h"
+#include "servers/physics_3d/godot_physics_server_3d.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+class CallableMock : public Object {
+	GDCLASS(CallableMock, Object);
+
+public:
+	void function1(Variant arg0) {
+		function1_calls++;
+	}
+
+	unsigned function1_calls{ 0 };
+};
+
+static RID create_free_body(PhysicsServer3D *p_server, RID p_space, RID p_shape, real_t p_mass) {
+	RID body = p_server->body_create();
+	p_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+	p_server->body_add_shape(body, p_shape);
+	p_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_MASS, p_mass);
+	p_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_LINEAR_DAMP_MODE, PhysicsServer3D::BODY_DAMP_MODE_REPLACE);
+	p_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_LINEAR_DAMP, 0.0);
+	p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+	p_server->body_set_space(body, p_space);
+	return body;
+}
+
+// Setting the tick divisor also restarts the tick count, so the next tick steps the space.
+static void set_step_settings(PhysicsServer3D *p_server, RID p_space, int p_substeps, int p_tick_divisor) {
+	p_server->space_set_param(p_space, PhysicsServer3D::SPACE_PARAM_SUBSTEPS, p_substeps);
+	p_server->space_set_param(p_space, PhysicsServer3D::SPACE_PARAM_TICK_DIVISOR, p_tick_divisor);
+}
+
+TEST_CASE("[PhysicsServer3D] Substeps and tick divisor should conserve applied momentum") {
+	GodotPhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 0.0);
+
+	RID shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(shape, 0.5);
+
+	const real_t step = 1.0 / 60.0;
+	const real_t mass = 2.0;
+	const Vector3 force = Vector3(3.0, 0.0, -1.0);
+
+	struct StepSettings {
+		int substeps;
+		int tick_divisor;
+	};
+	const StepSettings settings[] = { { 1, 1 }, { 4, 1 }, { 1, 3 }, { 4, 3 } };
+
+	for (const StepSettings &setting : settings) {
+		const String context = vformat("%d substeps, tick divisor %d.", setting.substeps, setting.tick_divisor);
+
+		{
+			// Constant forces act over the whole step.
+			set_step_settings(physics_server, space, setting.substeps, setting.tick_divisor);
+			RID body = create_free_body(physics_server, space, shape, mass);
+			physics_server->body_set_constant_force(body, force);
+
+			// Run whole steps, so the space has covered exactly the elapsed ticks.
+			const int ticks = 4 * setting.tick_divisor;
+			for (int i = 0; i < ticks; i++) {
+				physics_server->step(step);
+			}
+
+			const Vector3 momentum = Vector3(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) * mass;
+			CHECK_MESSAGE(momentum.is_equal_approx(force * step * ticks), context);
+			physics_server->free(body);
+		}
+
+		{
+			// Forces applied on every tick act for one tick each.
+			set_step_settings(physics_server, space, setting.substeps, setting.tick_divisor);
+			RID body = create_free_body(physics_server, space, shape, mass);
+
+			// Stop on a tick where the space is stepped, forces applied on skipped ticks are pending until then.
+			const int ticks = 3 * setting.tick_divisor + 1;
+			for (int i = 0; i < ticks; i++) {
+				physics_server->body_apply_central_force(body, force);
+				physics_server->step(step);
+			}
+
+			const Vector3 momentum = Vector3(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) * mass;
+			CHECK_MESSAGE(momentum.is_equal_approx(force * step * ticks), context);
+			physics_server->free(body);
+		}
+
+		{
+			// One-shot forces act for a single tick.
+			set_step_settings(physics_server, space, setting.substeps, setting.tick_divisor);
+			RID body = create_free_body(physics_server, space, shape, mass);
+			physics_server->body_apply_central_force(body, force);
+			for (int i = 0; i < 2 * setting.tick_divisor; i++) {
+				physics_server->step(step);
+			}
+
+			const Vector3 momentum = Vector3(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) * mass;
+			CHECK_MESSAGE(momentum.is_equal_approx(force * step), context);
+			physics_server->free(body);
+		}
+
+		{
+			// Impulses are applied once.
+			set_step_settings(physics_server, space, setting.substeps, setting.tick_divisor);
+			RID body = create_free_body(physics_server, space, shape, mass);
+			physics_server->step(step);
+			physics_server->body_apply_central_impulse(body, force);
+			for (int i = 0; i < 2 * setting.tick_divisor; i++) {
+				physics_server->step(step);
+			}
+
+			const Vector3 momentum = Vector3(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) * mass;
+			CHECK_MESSAGE(momentum.is_equal_approx(force), context);
+			physics_server->free(body);
+		}
+
+		{
+			// The force integration callback runs once per integration step.
+			set_step_settings(physics_server, space, setting.substeps, setting.tick_divisor);
+			RID body = create_free_body(physics_server, space, shape, mass);
+			CallableMock mock;
+			physics_server->body_set_force_integration_callback(body, callable_mp(&mock, &CallableMock::function1));
+
+			for (int i = 0; i < setting.tick_divisor; i++) {
+				physics_server->step(step);
+				physics_server->flush_queries();
+			}
+			CHECK_MESSAGE(mock.function1_calls == (unsigned)setting.substeps, context);
+			physics_server->free(body);
+		}
+	}
+
+	physics_server->free(shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+struct BodySnapshot3D {
+	Transform3D transform;
+	Vector3 linear_velocity;
+	Vector3 angular_velocity;
+};
+
+static void get_body_snapshots(PhysicsServer3D *p_server, const LocalVector<RID> &p_bodies, LocalVector<BodySnapshot3D> &r_snapshots) {
+	r_snapshots.resize(p_bodies.size());
+	for (uint32_t i = 0; i < p_bodies.size(); i++) {
+		r_snapshots[i].transform = p_server->body_get_state(p_bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		r_snapshots[i].linear_velocity = p_server->body_get_state(p_bodies[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		r_snapshots[i].angular_velocity = p_server->body_get_state(p_bodies[i], PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+	}
+}
+
+TEST_CASE("[PhysicsServer3D] Restoring a saved space state should rewind bodies and contacts") {
+	GodotPhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+
+	RID floor_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector3(50, 1, 50));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+	physics_server->body_set_space(floor, space);
+
+	// Boxes sliding on the floor at different speeds, so they keep their contacts with it while friction slows them
+	// down, and a sphere falling freely next to them.
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID sphere_shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere_shape, 0.5);
+
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 3; i++) {
+		RID box = create_free_body(physics_server, space, box_shape, 1.0);
+		physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(i * 4.0, 0.5, 0)));
+		physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(0, 0, 1.0 + i));
+		physics_server->body_set_param(box, PhysicsServer3D::BODY_PARAM_FRICTION, 0.1);
+		bodies.push_back(box);
+	}
+	RID sphere = create_free_body(physics_server, space, sphere_shape, 1.0);
+	physics_server->body_set_state(sphere, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(-4, 20, 0)));
+	bodies.push_back(sphere);
+
+	const real_t step = 1.0 / 60.0;
+	const int steps = 10;
+
+	// Settle the contacts, so the saved state includes cached contacts.
+	for (int i = 0; i < steps; i++) {
+		physics_server->step(step);
+	}
+
+	LocalVector<BodySnapshot3D> saved;
+	get_body_snapshots(physics_server, bodies, saved);
+	const PackedByteArray state = physics_server->space_save_state(space);
+	CHECK_FALSE(state.is_empty());
+
+	for (int i = 0; i < steps; i++) {
+		physics_server->step(step);
+	}
+	LocalVector<BodySnapshot3D> stepped;
+	get_body_snapshots(physics_server, bodies, stepped);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		CHECK_MESSAGE(!stepped[i].transform.is_equal_approx(saved[i].transform), vformat("Body %d should still be moving.", i));
+	}
+
+	physics_server->space_restore_state(space, state);
+	LocalVector<BodySnapshot3D> restored;
+	get_body_snapshots(physics_server, bodies, restored);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		CHECK_MESSAGE(restored[i].transform == saved[i].transform, vformat("Body %d should be back at its saved transform.", i));
+		CHECK_MESSAGE(restored[i].linear_velocity == saved[i].linear_velocity, vformat("Body %d should be back at its saved linear velocity.", i));
+		CHECK_MESSAGE(restored[i].angular_velocity == saved[i].angular_velocity, vformat("Body %d should be back at its saved angular velocity.", i));
+	}
+
+	// Stepping from the restored state should replay the same steps.
+	for (int i = 0; i < steps; i++) {
+		physics_server->step(step);
+	}
+	LocalVector<BodySnapshot3D> replayed;
+	get_body_snapshots(physics_server, bodies, replayed);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		CHECK_MESSAGE(replayed[i].transform.is_equal_approx(stepped[i].transform), vformat("Body %d should reach the same transform again.", i));
+		CHECK_MESSAGE(replayed[i].linear_velocity.is_equal_approx(stepped[i].linear_velocity), vformat("Body %d should reach the same linear velocity again.", i));
+		CHECK_MESSAGE(replayed[i].angular_velocity.is_equal_approx(stepped[i].angular_velocity), vformat("Body %d should reach the same angular velocity again.", i));
+	}
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(floor);
+	physics_server->free(sphere_shape);
+	physics_server->free(box_shape);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+TEST_CASE("[PhysicsServer3D] Continuous collision detection should stop fast bodies at thin walls") {
+	GodotPhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 0.0);
+
+	// A wall much thinner than the distance the sphere travels in one step.
+	RID wall_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(wall_shape, Vector3(0.05, 5, 5));
+	RID wall = physics_server->body_create();
+	physics_server->body_set_mode(wall, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(wall, wall_shape);
+	physics_server->body_set_state(wall, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(5, 0, 0)));
+	physics_server->body_set_space(wall, space);
+
+	RID sphere_shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere_shape, 0.25);
+
+	const real_t step = 1.0 / 60.0;
+	const real_t speed = 600.0; // 10 units per step.
+
+	for (bool ccd : { true, false }) {
+		RID sphere = create_free_body(physics_server, space, sphere_shape, 1.0);
+		physics_server->body_set_enable_continuous_collision_detection(sphere, ccd);
+		physics_server->body_set_state(sphere, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 0, 0)));
+		physics_server->body_set_state(sphere, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(speed, 0, 0));
+
+		for (int i = 0; i < 5; i++) {
+			physics_server->step(step);
+		}
+
+		const Vector3 position = Transform3D(physics_server->body_get_state(sphere, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+		if (ccd) {
+			CHECK_MESSAGE(position.x < 5.0 - 0.05, "With continuous collision detection, the sphere should stay in front of the wall.");
+			CHECK_MESSAGE(Vector3(physics_server->body_get_state(sphere, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)).x < speed, "The wall should have stopped the sphere.");
+		} else {
+			CHECK_MESSAGE(position.x > 5.0 + 0.05, "Without continuous collision detection, the sphere should tunnel through the wall.");
+		}
+
+		physics_server->free(sphere);
+	}
+
+	physics_server->free(sphere_shape);
+	physics_server->free(wall);
+	physics_server->free(wall_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+static void check_heightmaps_match(const GodotHeightMapShape3D &p_shape, const GodotHeightMapShape3D &p_compressed_shape, real_t p_tolerance) {
+	const Dictionary data = p_shape.get_data();
+	const Dictionary compressed_data = p_compressed_shape.get_data();
+	CHECK_FALSE(bool(data["compressed"]));
+	CHECK(bool(compressed_data["compressed"]));
+	CHECK_EQ(int(compressed_data["width"]), int(data["width"]));
+	CHECK_EQ(int(compressed_data["depth"]), int(data["depth"]));
+
+	const Vector<real_t> heights = data["heights"];
+	const Vector<real_t> compressed_heights = compressed_data["heights"];
+	REQUIRE_EQ(compressed_heights.size(), heights.size());
+	int mismatches = 0;
+	for (int i = 0; i < heights.size(); i++) {
+		if (Math::abs(compressed_heights[i] - heights[i]) > p_tolerance) {
+			mismatches++;
+		}
+	}
+	CHECK_MESSAGE(mismatches == 0, "Compressed heights should match the original heights within the quantization step.");
+
+	CHECK(p_compressed_shape.get_aabb().is_equal_approx(p_shape.get_aabb()));
+
+	// Vertical rays over the whole map, including across chunk borders.
+	const AABB aabb = p_shape.get_aabb();
+	for (real_t x = aabb.position.x + 0.3; x < aabb.position.x + aabb.size.x; x += 7.0) {
+		for (real_t z = aabb.position.z + 0.6; z < aabb.position.z + aabb.size.z; z += 5.0) {
+			const Vector3 begin = Vector3(x, aabb.position.y + aabb.size.y + 1.0, z);
+			const Vector3 end = Vector3(x, aabb.position.y - 1.0, z);
+			Vector3 point, normal, compressed_point, compressed_normal;
+			int face_index = -1;
+			REQUIRE(p_shape.intersect_segment(begin, end, point, normal, face_index, false));
+			REQUIRE(p_compressed_shape.intersect_segment(begin, end, compressed_point, compressed_normal, face_index, false));
+			CHECK_MESSAGE(Math::abs(compressed_point.y - point.y) <= p_tolerance, vformat("Ray at (%f, %f) should hit the same height.", x, z));
+		}
+	}
+}
+
+TEST_CASE("[PhysicsServer3D] Compressed heightmaps should match uncompressed ones") {
+	const int size = 100;
+	const real_t min_height = -5.0;
+	const real_t max_height = 5.0;
+
+	Vector<real_t> heights;
+	heights.resize(size * size);
+	for (int z = 0; z < size; z++) {
+		for (int x = 0; x < size; x++) {
+			heights.write[z * size + x] = Math::sin(x * 0.21) * Math::cos(z * 0.13) * max_height;
+		}
+	}
+
+	Dictionary data;
+	data["width"] = size;
+	data["depth"] = size;
+	data["heights"] = heights;
+	data["min_height"] = min_height;
+	data["max_height"] = max_height;
+
+	GodotHeightMapShape3D shape;
+	shape.set_data(data);
+	data["compressed"] = true;
+	GodotHeightMapShape3D compressed_shape;
+	compressed_shape.set_data(data);
+
+	// Quantized heights are rounded to the closest 16 bit step, ray hits interpolate between them.
+	const real_t tolerance = (max_height - min_height) / UINT16_MAX;
+	check_heightmaps_match(shape, compressed_shape, tolerance);
+
+	SUBCASE("Updating a region within the height range should update both maps") {
+		const Rect2i region = Rect2i(30, 30, 20, 20);
+		Vector<real_t> region_heights;
+		region_heights.resize(region.size.x * region.size.y);
+		region_heights.fill(2.0);
+
+		Dictionary region_data;
+		region_data["region"] = region;
+		region_data["heights"] = region_heights;
+		shape.set_data(region_data);
+		compressed_shape.set_data(region_data);
+
+		check_heightmaps_match(shape, compressed_shape, tolerance);
+
+		// The center of the region, in the local space of the shape.
+		const Vector3 center = Vector3(40 - 0.5 * (size - 1), 0, 40 - 0.5 * (size - 1));
+		Vector3 point, normal;
+		int face_index = -1;
+		REQUIRE(compressed_shape.intersect_segment(center + Vector3(0, 10, 0), center - Vector3(0, 10, 0), point, normal, face_index, false));
+		CHECK(Math::abs(point.y - 2.0) <= tolerance);
+	}
+
+	SUBCASE("Updating a region beyond the height range should grow the bounds of both maps") {
+		const Rect2i region = Rect2i(60, 10, 8, 8);
+		Vector<real_t> region_heights;
+		region_heights.resize(region.size.x * region.size.y);
+		region_heights.fill(8.0);
+
+		Dictionary region_data;
+		region_data["region"] = region;
+		region_data["heights"] = region_heights;
+		shape.set_data(region_data);
+		compressed_shape.set_data(region_data);
+
+		CHECK(Math::is_equal_approx(shape.get_aabb().position.y + shape.get_aabb().size.y, (real_t)8.0));
+		// The compressed heights were quantized again over the larger range.
+		check_heightmaps_match(shape, compressed_shape, ((real_t)8.0 - min_height) / UINT16_MAX);
+
+		const Vector3 center = Vector3(64 - 0.5 * (size - 1), 0, 14 - 0.5 * (size - 1));
+		Vector3 point, normal;
+		int face_index = -1;
+		REQUIRE(compressed_shape.intersect_segment(center + Vector3(0, 10, 0), center - Vector3(0, 10, 0), point, normal, face_index, false));
+		CHECK(Math::abs(point.y - 8.0) <= tolerance * 2.0);
+	}
+}
+
+struct BroadPhasePairs {
+	int pair_count = 0;
+	int unpair_count = 0;
+	HashSet<Pair<GodotCollisionObject3D *, GodotCollisionObject3D *>, PairHash<GodotCollisionObject3D *, GodotCollisionObject3D *>> pairs;
+
+	static void *pair_callback(GodotCollisionObject3D *p_object_A, int p_subindex_A, GodotCollisionObject3D *p_object_B, int p_subindex_B, void *p_self) {
+		BroadPhasePairs *self = static_cast<BroadPhasePairs *>(p_self);
+		self->pair_count++;
+		self->pairs.insert(Pair<GodotCollisionObject3D *, GodotCollisionObject3D *>(p_object_A, p_object_B));
+		return p_self;
+	}
+
+	static void unpair_callback(GodotCollisionObject3D *p_object_A, int p_subindex_A, GodotCollisionObject3D *p_object_B, int p_subindex_B, void *p_data, void *p_self) {
+		BroadPhasePairs *self = static_cast<BroadPhasePairs *>(p_self);
+		CHECK_MESSAGE(p_data == p_self, "Unpairing should get the data returned when pairing.");
+		self->unpair_count++;
+		self->pairs.erase(Pair<GodotCollisionObject3D *, GodotCollisionObject3D *>(p_object_A, p_object_B));
+	}
+
+	void connect(GodotBroadPhase3D *p_broadphase) {
+		p_broadphase->set_pair_callback(pair_callback, this);
+		p_broadphase->set_unpair_callback(unpair_callback, this);
+	}
+};
+
+TEST_CASE("[PhysicsServer3D] Hash grid broadphase should create and remove pairs") {
+	// Registers the broadphase settings.
+	GodotPhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+
+	GodotBroadPhase3DHashGrid *broadphase = memnew(GodotBroadPhase3DHashGrid);
+	BroadPhasePairs pairs;
+	pairs.connect(broadphase);
+
+	GodotBody3D body_a;
+	GodotBody3D body_b;
+	GodotBody3D body_c;
+
+	// The default cell size is 4, B spans several cells.
+	GodotBroadPhase3D::ID id_a = broadphase->create(&body_a, 0, AABB(Vector3(0, 0, 0), Vector3(1, 1, 1)));
+	GodotBroadPhase3D::ID id_b = broadphase->create(&body_b, 0, AABB(Vector3(-6, -6, -6), Vector3(7, 7, 7)));
+	GodotBroadPhase3D::ID id_c = broadphase->create(&body_c, 0, AABB(Vector3(20, 0, 0), Vector3(1, 1, 1)));
+	broadphase->update();
+
+	CHECK_EQ(pairs.pair_count, 1);
+	CHECK(pairs.pairs.has(Pair<GodotCollisionObject3D *, GodotCollisionObject3D *>(&body_a, &body_b)));
+
+	SUBCASE("Moving apart should remove the pair") {
+		broadphase->move(id_b, AABB(Vector3(-16, -16, -16), Vector3(7, 7, 7)));
+		broadphase->update();
+		CHECK_EQ(pairs.unpair_count, 1);
+		CHECK(pairs.pairs.is_empty());
+	}
+
+	SUBCASE("Moving within the cells of a pair should keep it") {
+		broadphase->move(id_b, AABB(Vector3(-5, -5, -5), Vector3(6, 6, 6)));
+		broadphase->update();
+		CHECK_EQ(pairs.pair_count, 1);
+		CHECK_EQ(pairs.unpair_count, 0);
+	}
+
+	SUBCASE("Moving into several elements should pair with each of them once") {
+		broadphase->move(id_c, AABB(Vector3(-8, 0, 0), Vector3(30, 1, 1)));
+		broadphase->update();
+		CHECK_EQ(pairs.pair_count, 3);
+		CHECK(pairs.pairs.has(Pair<GodotCollisionObject3D *, GodotCollisionObject3D *>(&body_a, &body_c)));
+		CHECK(pairs.pairs.has(Pair<GodotCollisionObject3D *, GodotCollisionObject3D *>(&body_b, &body_c)));
+	}
+
+	SUBCASE("Removing an element should remove its pairs") {
+		broadphase->remove(id_a);
+		CHECK_EQ(pairs.unpair_count, 1);
+		CHECK(pairs.pairs.is_empty());
+		id_a = 0;
+	}
+
+	SUBCASE("Static elements should not pair with each other") {
+		broadphase->set_static(id_a, true);
+		broadphase->set_static(id_b, true);
+		broadphase->update();
+		CHECK(pairs.pairs.is_empty());
+	}
+
+	SUBCASE("Culling should report elements spanning several cells once") {
+		GodotCollisionObject3D *results[8];
+		CHECK_EQ(broadphase->cull_aabb(AABB(Vector3(-8, -8, -8), Vector3(16, 16, 16)), results, 8), 2);
+		CHECK_EQ(broadphase->cull_point(Vector3(0.5, 0.5, 0.5), results, 8), 2);
+		CHECK_EQ(broadphase->cull_segment(Vector3(-5, 0.5, 0.5), Vector3(30, 0.5, 0.5), results, 8), 3);
+	}
+
+	for (GodotBroadPhase3D::ID id : { id_a, id_b, id_c }) {
+		if (id) {
+			broadphase->remove(id);
+		}
+	}
+	memdelete(broadphase);
+	memdelete(physics_server);
+}
+
+struct ConcurrentCullData {
+	const GodotBroadPhase3D *broadphase = nullptr;
+	LocalVector<AABB> queries;
+	LocalVector<int> results;
+
+	void cull(uint32_t p_index, void *p_userdata) {
+		GodotCollisionObject3D *objects[256];
+		results[p_index] = const_cast<GodotBroadPhase3D *>(broadphase)->cull_aabb(queries[p_index], objects, 256);
+	}
+};
+
+TEST_CASE("[PhysicsServer3D] Hash grid broadphase should support concurrent queries") {
+	GodotPhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	GodotBroadPhase3DHashGrid *broadphase = memnew(GodotBroadPhase3DHashGrid);
+
+	const int body_count = 1000;
+	LocalVector<GodotBody3D *> bodies;
+	LocalVector<GodotBroadPhase3D::ID> ids;
+	Math::seed(30);
+	for (int i = 0; i < body_count; i++) {
+		bodies.push_back(memnew(GodotBody3D));
+		Vector3 position = Vector3(Math::random(0.0, 100.0), Math::random(0.0, 100.0), Math::random(0.0, 100.0));
+		ids.push_back(broadphase->create(bodies[i], 0, AABB(position, Vector3(1, 1, 1) * Math::random(0.5, 10.0))));
+	}
+	broadphase->update();
+
+	ConcurrentCullData data;
+	data.broadphase = broadphase;
+	for (int i = 0; i < 1024; i++) {
+		Vector3 position = Vector3(Math::random(0.0, 100.0), Math::random(0.0, 100.0), Math::random(0.0, 100.0));
+		data.queries.push_back(AABB(position, Vector3(12, 12, 12)));
+	}
+	data.results.resize(data.queries.size());
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&data, &ConcurrentCullData::cull, nullptr, data.queries.size(), -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	for (uint32_t i = 0; i < data.queries.size(); i++) {
+		GodotCollisionObject3D *objects[256];
+		CHECK_EQ(data.results[i], broadphase->cull_aabb(data.queries[i], objects, 256));
+	}
+
+	for (uint32_t i = 0; i < ids.size(); i++) {
+		broadphase->remove(ids[i]);
+		memdelete(bodies[i]);
+	}
+	memdelete(broadphase);
+	memdelete(physics_server);
+}
+
+TEST_CASE("[Stress][PhysicsServer3D] Compare BVH and hash grid pair updates for 50000 moving AABBs") {
+	GodotPhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+
+	const int body_count = 50000;
+	const int frame_count = 10;
+	const double world_size = 400.0;
+
+	LocalVector<GodotBody3D *> bodies;
+	LocalVector<AABB> aabbs;
+	Math::seed(50000);
+	for (int i = 0; i < body_count; i++) {
+		bodies.push_back(memnew(GodotBody3D));
+		Vector3 position = Vector3(Math::random(0.0, world_size), Math::random(0.0, world_size), Math::random(0.0, world_size));
+		aabbs.push_back(AABB(position, Vector3(1, 1, 1)));
+	}
+
+	GodotBroadPhase3D *broadphases[2] = { GodotBroadPhase3DBVH::_create(), GodotBroadPhase3DHashGrid::_create() };
+	const char *names[2] = { "BVH", "Hash grid" };
+
+	for (int b = 0; b < 2; b++) {
+		GodotBroadPhase3D *broadphase = broadphases[b];
+		BroadPhasePairs pairs;
+		pairs.connect(broadphase);
+
+		LocalVector<GodotBroadPhase3D::ID> ids;
+		for (int i = 0; i < body_count; i++) {
+			ids.push_back(broadphase->create(bodies[i], 0, aabbs[i]));
+		}
+		broadphase->update();
+
+		// Every body moves on every frame, the same way for both broadphases.
+		Math::seed(frame_count);
+		uint64_t update_usec = 0;
+		for (int frame = 0; frame < frame_count; frame++) {
+			uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < body_count; i++) {
+				aabbs[i].position += Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0));
+				broadphase->move(ids[i], aabbs[i]);
+			}
+			broadphase->update();
+			update_usec += OS::get_singleton()->get_ticks_usec() - begin_usec;
+		}
+
+		print_verbose(vformat("%s: %d usec per frame for %d moving AABBs, %d pairs created, %d pairs removed.", names[b], update_usec / frame_count, body_count, pairs.pair_count, pairs.unpair_count));
+		CHECK(pairs.pair_count > 0);
+
+		for (int i = 0; i < body_count; i++) {
+			broadphase->remove(ids[i]);
+		}
+		CHECK_EQ(pairs.pair_count, pairs.unpair_count);
+		memdelete(broadphase);
+
+		// Restore the starting positions for the next broadphase.
+		Math::seed(frame_count);
+		for (int frame = 0; frame < frame_count; frame++) {
+			for (int i = 0; i < body_count; i++) {
+				aabbs[i].position -= Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0));
+			}
+		}
+	}
+
+	for (GodotBody3D *body : bodies) {
+		memdelete(body);
+	}
+	memdelete(physics_server);
+}
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H
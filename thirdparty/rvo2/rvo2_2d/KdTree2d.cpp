@@ -44,18 +44,24 @@ namespace RVO2D {
 		deleteObstacleTree(obstacleTree_);
 	}
 
-	void KdTree2D::buildAgentTree(std::vector<Agent2D *> agents)
+	void KdTree2D::buildAgentTree(std::vector<Agent2D *> agents, std::vector<AgentSubtree2D> *subtrees, size_t maxSubtreeSize)
 	{
 		agents_.swap(agents);
 
 		if (!agents_.empty()) {
 			agentTree_.resize(2 * agents_.size() - 1);
-			buildAgentTreeRecursive(0, agents_.size(), 0);
+			buildAgentTreeRecursive(0, agents_.size(), 0, subtrees, maxSubtreeSize);
 		}
 	}
 
-	void KdTree2D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node)
+	void KdTree2D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node, std::vector<AgentSubtree2D> *subtrees, size_t maxSubtreeSize)
 	{
+		if (subtrees != NULL && end - begin <= maxSubtreeSize) {
+			const AgentSubtree2D subtree = { begin, end, node };
+			subtrees->push_back(subtree);
+			return;
+		}
+
 		agentTree_[node].begin = begin;
 		agentTree_[node].end = end;
 		agentTree_[node].minX = agentTree_[node].maxX = agents_[begin]->position_.x();
@@ -100,8 +106,8 @@ namespace RVO2D {
 			agentTree_[node].left = node + 1;
 			agentTree_[node].right = node + 2 * (left - begin);
 
-			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
-			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+			buildAgentTreeRecursive(begin, left, agentTree_[node].left, subtrees, maxSubtreeSize);
+			buildAgentTreeRecursive(left, end, agentTree_[node].right, subtrees, maxSubtreeSize);
 		}
 	}
 
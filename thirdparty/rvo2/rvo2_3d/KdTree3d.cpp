@@ -43,18 +43,24 @@ namespace RVO3D {
 
 	KdTree3D::KdTree3D(RVOSimulator3D *sim) : sim_(sim) { }
 
-	void KdTree3D::buildAgentTree(std::vector<Agent3D *> agents)
+	void KdTree3D::buildAgentTree(std::vector<Agent3D *> agents, std::vector<AgentSubtree3D> *subtrees, size_t maxSubtreeSize)
 	{
 		agents_.swap(agents);
 
 		if (!agents_.empty()) {
 			agentTree_.resize(2 * agents_.size() - 1);
-			buildAgentTreeRecursive(0, agents_.size(), 0);
+			buildAgentTreeRecursive(0, agents_.size(), 0, subtrees, maxSubtreeSize);
 		}
 	}
 
-	void KdTree3D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node)
+	void KdTree3D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node, std::vector<AgentSubtree3D> *subtrees, size_t maxSubtreeSize)
 	{
+		if (subtrees != NULL && end - begin <= maxSubtreeSize) {
+			const AgentSubtree3D subtree = { begin, end, node };
+			subtrees->push_back(subtree);
+			return;
+		}
+
 		agentTree_[node].begin = begin;
 		agentTree_[node].end = end;
 		agentTree_[node].minCoord = agents_[begin]->position_;
@@ -116,8 +122,8 @@ namespace RVO3D {
 			agentTree_[node].left = node + 1;
 			agentTree_[node].right = node + 2 * leftSize;
 
-			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
-			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+			buildAgentTreeRecursive(begin, left, agentTree_[node].left, subtrees, maxSubtreeSize);
+			buildAgentTreeRecursive(left, end, agentTree_[node].right, subtrees, maxSubtreeSize);
 		}
 	}
 
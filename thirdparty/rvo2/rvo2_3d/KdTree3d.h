@@ -92,12 +92,25 @@ namespace RVO3D {
 		 */
 		explicit KdTree3D(RVOSimulator3D *sim);
 
+		/**
+		 * \brief   An agent <i>k</i>d-tree subtree left to be built.
+		 */
+		class AgentSubtree3D {
+		public:
+			size_t begin;
+			size_t end;
+			size_t node;
+		};
+
 		/**
 		 * \brief   Builds an agent <i>k</i>d-tree.
+		 * \param   subtrees        If not null, the subtrees with at most maxSubtreeSize agents are
+		 *                           not built but appended here. They cover disjoint agents and nodes
+		 *                           and can be built concurrently with buildAgentTreeRecursive.
 		 */
-		void buildAgentTree(std::vector<Agent3D *> agents);
+		void buildAgentTree(std::vector<Agent3D *> agents, std::vector<AgentSubtree3D> *subtrees = NULL, size_t maxSubtreeSize = 0);
 
-		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node);
+		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node, std::vector<AgentSubtree3D> *subtrees = NULL, size_t maxSubtreeSize = 0);
 
 		/**
 		 * \brief   Computes the agent neighbors of the specified agent.